@@ -216,10 +216,9 @@ namespace MOTION::new_fixed_point
   template <typename I, typename F>
   void encode(I *dst, const F *src, std::size_t fractional_bits, std::size_t n)
   {
-    std ::cout << "\n Inside encode 2 \n";
     std::transform(src, src + n, dst,
                    [fractional_bits](auto x)
-                   { return encode(x, fractional_bits); });
+                   { return encode<I, F>(x, fractional_bits); });
   }
 
   // Decode a range of floating point numbers using above decoding algorithm.
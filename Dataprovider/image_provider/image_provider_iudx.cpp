@@ -4,6 +4,7 @@
 #include <boost/program_options.hpp>
 #include <boost/serialization/string.hpp>
 #include <boost/thread.hpp>
+#include <array>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -12,7 +13,9 @@
 #include <random>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 #include "./fixed-point.h"
+#include "crypto/random/aes128_ctr_rng.h"
 
 #define MAX_CONNECT_RETRIES 50
 using namespace boost::asio;
@@ -26,8 +29,10 @@ struct Options {
   int cs1_port;
   std::size_t fractional_bits;
   int index;
-  std::string NameofImageFile;
-  std::string fullfilepath;
+  std::size_t batch_size;
+  // X<index>.csv, ..., X<index + batch_size - 1>.csv, one column of the shared matrix each
+  std::vector<std::string> image_paths;
+  bool seed_compressed;
 };
 
 struct Shares {
@@ -71,8 +76,10 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("compute-server1-ip", po::value<std::string>()->default_value("127.0.0.1"), "IP address of compute server 1")
     ("compute-server1-port", po::value<int>()->required(), "Port number of compute server 1")
     ("index", po::value<int>()->required(), "Index of image file")
+    ("batch-size", po::value<std::size_t>()->default_value(1), "Number of images (index, index + 1, ...) shared as the columns of one input matrix")
     ("fractional-bits", po::value<size_t>()->required(), "Number of fractional bits")
     ("filepath", po::value<std::string>()->required(), "Name of the image file for which shares should be created")
+    ("seed-compressed", po::bool_switch()->default_value(false), "send a PRG seed for delta and the Delta values instead of (Delta, delta) pairs")
     ;
   // clang-format on
 
@@ -94,18 +101,25 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.cs1_ip = vm["compute-server1-ip"].as<std::string>();
   options.cs1_port = vm["compute-server1-port"].as<int>();
   options.index = vm["index"].as<int>();
-  options.NameofImageFile = "X" + std::to_string(options.index);
-  options.fullfilepath = vm["filepath"].as<std::string>();
+  options.batch_size = vm["batch-size"].as<std::size_t>();
   options.fractional_bits = vm["fractional-bits"].as<size_t>();
-  options.fullfilepath += "/images/" + options.NameofImageFile + ".csv";
-  std::cout << "Image Path: " << options.fullfilepath << "\n";
+  options.seed_compressed = vm["seed-compressed"].as<bool>();
   // --------------------------------- Input Validation ---------------------------------------//
-  if (std::ifstream(options.fullfilepath)) {
-    std::cout << "Image file found.";
-  } else {
-    std::cout << "No image file found at " << options.fullfilepath << std::endl;
+  if (options.batch_size == 0) {
+    std::cerr << "The batch size must be at least 1." << std::endl;
     return std::nullopt;
   }
+  for (std::size_t i = 0; i < options.batch_size; ++i) {
+    options.image_paths.push_back(vm["filepath"].as<std::string>() + "/images/X" +
+                                  std::to_string(options.index + i) + ".csv");
+    std::cout << "Image Path: " << options.image_paths.back() << "\n";
+    if (std::ifstream(options.image_paths.back())) {
+      std::cout << "Image file found.\n";
+    } else {
+      std::cout << "No image file found at " << options.image_paths.back() << std::endl;
+      return std::nullopt;
+    }
+  }
   // Check whether IP addresses are valid
   if ((!is_valid_IP(options.cs0_ip)) || (!is_valid_IP(options.cs1_ip))) {
     std::cerr << "Invalid IP address." << std::endl;
@@ -129,10 +143,21 @@ std::uint64_t RandomNumDistribution(E& engine) {
   return distribution(engine);
 }
 
-int share_generation(std::ifstream& image_data, int num_elements, Shares* cs0_data,
-                     Shares* cs1_data, size_t fractional_bits) {
-  // get input data
-  std::vector<float> data;
+using Seed = std::array<std::byte, AES128_CTR_RNG::block_size>;
+
+// expands seed to num_elements delta values in the same way as the image share receivers do
+std::vector<std::uint64_t> expand_seed(const Seed& seed, int num_elements) {
+  std::vector<std::uint64_t> deltas(num_elements);
+  AES128_CTR_RNG rng;
+  rng.set_key(seed.data());
+  rng.random_bytes(reinterpret_cast<std::byte*>(deltas.data()),
+                   num_elements * sizeof(std::uint64_t));
+  return deltas;
+}
+
+// reads the values of an image file, one per line
+int read_image(std::ifstream& image_data, int num_elements, std::vector<float>& data) {
+  data.clear();
   std::string line;
   while (std::getline(image_data, line)) {
     float temp;
@@ -147,10 +172,29 @@ int share_generation(std::ifstream& image_data, int num_elements, Shares* cs0_da
               << " values." << std::endl;
     return EXIT_FAILURE;
   }
+  return EXIT_SUCCESS;
+}
+
+// with seeds, delta of server i is expanded from seeds[i] instead of sampled with std::mt19937
+int share_generation(const std::vector<float>& data, Shares* cs0_data, Shares* cs1_data,
+                     size_t fractional_bits, const std::array<Seed, 2>* seeds = nullptr) {
+  const int num_elements = data.size();
+  auto data_size = data.size();
 
   std::cout << "Generating image shares. \n";
   // Now that we have the data, need to generate the shares
   try {
+    if (seeds != nullptr) {
+      auto del0 = expand_seed((*seeds)[0], num_elements);
+      auto del1 = expand_seed((*seeds)[1], num_elements);
+      for (int i = 0; i < data_size; i++) {
+        std::uint64_t Del = del0[i] + del1[i] +
+                            MOTION::new_fixed_point::encode<uint64_t, float>(data[i], fractional_bits);
+        cs0_data[i] = {Del, del0[i]};
+        cs1_data[i] = {Del, del1[i]};
+      }
+      return EXIT_SUCCESS;
+    }
     for (int i = 0; i < data_size; i++) {
       std::random_device rd;
       std::mt19937 gen(rd());
@@ -180,6 +224,22 @@ int share_generation(std::ifstream& image_data, int num_elements, Shares* cs0_da
   return EXIT_SUCCESS;
 }
 
+// sends the seed from which the server expands its delta values, followed by the Delta values
+void write_seed_compressed(tcp::socket& socket, const Seed& seed, Shares* data, int num_elements) {
+  std::vector<uint64_t> Deltas(num_elements);
+  for (int i = 0; i < num_elements; i++) {
+    Deltas[i] = data[i].Delta;
+  }
+  std::array<boost::asio::const_buffer, 2> buffers = {boost::asio::buffer(seed),
+                                                     boost::asio::buffer(Deltas)};
+  boost::system::error_code error;
+  boost::asio::write(socket, buffers, error);
+  if (error) {
+    throw std::runtime_error("Unable to send the seed and the Delta values.\nError: " +
+                             error.message() + "\n");
+  }
+}
+
 void write_struct(tcp::socket& socket, Shares* data, int num_elements) {
   boost::system::error_code error;
   for (int i = 0; i < num_elements; i++) {
@@ -189,7 +249,8 @@ void write_struct(tcp::socket& socket, Shares* data, int num_elements) {
     // std::cout << arr[0] << " " << arr[1] << "\n";
     boost::asio::write(socket, boost::asio::buffer(&arr, sizeof(arr)), error);
     if (error) {
-      std::cerr << "Unable to send share " << i + 1 << ".\nError: " << error.message() << std::endl;
+      throw std::runtime_error("Unable to send share " + std::to_string(i + 1) +
+                               ".\nError: " + error.message() + "\n");
     }
   }
 }
@@ -201,29 +262,45 @@ int main(int argc, char* argv[]) {
     std::cerr << "Error while parsing the given input options.\n";
     return EXIT_FAILURE;
   }
-  int rows = 784, columns = 1;  // hardcoded
+  // every image is one column, i.e., value r of image b is element r * columns + b
+  int rows = 784, columns = options->batch_size;  // hardcoded image size
   int num_elements = rows * columns;
-  Shares cs0_data[num_elements];
-  Shares cs1_data[num_elements];
-  // Reading contents from image file
-  std::ifstream image_file;
-  try {
-    image_file.open(options->fullfilepath);
-    if (!image_file) {
-      std::cerr << "Unable to open the image file.\n";
-      throw std::ifstream::failure("Error opening the image file.");
-    }
-    std::cout << "Image: " << options->NameofImageFile << "\n";
-    int is_error =
-        share_generation(image_file, num_elements, cs0_data, cs1_data, options->fractional_bits);
-    if (is_error) {
+  std::vector<Shares> cs0_data(num_elements);
+  std::vector<Shares> cs1_data(num_elements);
+  std::array<Seed, 2> seeds;
+  // Reading contents from image files
+  std::vector<float> batch_data(num_elements);
+  for (int b = 0; b < columns; ++b) {
+    std::ifstream image_file;
+    try {
+      image_file.open(options->image_paths[b]);
+      if (!image_file) {
+        std::cerr << "Unable to open the image file.\n";
+        throw std::ifstream::failure("Error opening the image file.");
+      }
+      std::cout << "Image: X" << options->index + b << "\n";
+      std::vector<float> image_data;
+      if (read_image(image_file, rows, image_data)) {
+        image_file.close();
+        return EXIT_FAILURE;
+      }
+      for (int r = 0; r < rows; ++r) {
+        batch_data[r * columns + b] = image_data[r];
+      }
+      image_file.close();
+    } catch (const std::ifstream::failure& e) {
+      std::cerr << "Error in image share generation: " << e.what() << std::endl;
       image_file.close();
       return EXIT_FAILURE;
     }
-    image_file.close();
-  } catch (const std::ifstream::failure& e) {
-    std::cerr << "Error in image share generation: " << e.what() << std::endl;
-    image_file.close();
+  }
+  if (options->seed_compressed) {
+    for (auto& seed : seeds) {
+      AES128_CTR_RNG::get_thread_instance().random_blocks(seed.data(), 1);
+    }
+  }
+  if (share_generation(batch_data, cs0_data.data(), cs1_data.data(), options->fractional_bits,
+                       options->seed_compressed ? &seeds : nullptr)) {
     return EXIT_FAILURE;
   }
   for (int id = 0; id < 2; id++) {
@@ -308,11 +385,15 @@ int main(int argc, char* argv[]) {
     // --------------------------------- Sending shares to
     // compute_server----------------------------------------------------
     try {
-      auto data1 = cs0_data;
+      auto data1 = cs0_data.data();
       if (id == 1) {
-        data1 = cs1_data;
+        data1 = cs1_data.data();
+      }
+      if (options->seed_compressed) {
+        write_seed_compressed(socket, seeds[id], data1, num_elements);
+      } else {
+        write_struct(socket, data1, num_elements);
       }
-      write_struct(socket, data1, num_elements);
       socket.close();
       std::cout << "Finished sending the shares to server " << id << "\n";
 
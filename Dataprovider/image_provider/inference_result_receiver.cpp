@@ -0,0 +1,212 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+Receives the final output shares that inference_engine streams with --output-receiver-port and
+reconstructs the result as soon as the shares of both servers have arrived. Each server connects
+once and then sends one message per request in the layout of a binary share file (header, Delta
+values, delta values), i.e., this replaces final_output_provider, output_shares_receiver and
+Reconstruct. For a batch of images, the message is a classes x images matrix and one result is
+printed per image.
+
+The dimensions of a message are bounded by --max-classes and --max-batch-size before anything is
+allocated for it.
+
+./bin/inference_result_receiver --listening-port0 4007 --listening-port1 4008
+*/
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/program_options.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "utility/share_file.h"
+
+using boost::asio::ip::tcp;
+namespace po = boost::program_options;
+
+struct Options {
+  int listening_port[2];
+  std::size_t num_requests;
+  std::size_t max_classes;
+  std::size_t max_batch_size;
+};
+
+struct FinalShares {
+  std::vector<std::uint64_t> Delta;
+  std::vector<std::uint64_t> delta;
+  std::size_t num_images;
+};
+
+std::optional<Options> parse_program_options(int argc, char* argv[]) {
+  Options options;
+  boost::program_options::options_description desc("Allowed options");
+  // clang-format off
+  desc.add_options()
+    ("help,h", po::bool_switch()->default_value(false),"produce help message")
+    ("listening-port0", po::value<int>()->required(), "port on which server 0 connects")
+    ("listening-port1", po::value<int>()->required(), "port on which server 1 connects")
+    ("num-requests", po::value<std::size_t>()->default_value(1),
+     "number of results to receive before exiting (0 = receive until the servers disconnect)")
+    ("max-classes", po::value<std::size_t>()->default_value(1000),
+     "largest number of classes (rows) accepted in a result")
+    ("max-batch-size", po::value<std::size_t>()->default_value(1024),
+     "largest number of images (columns) accepted in a result")
+    ;
+  // clang-format on
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  bool help = vm["help"].as<bool>();
+  if (help) {
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+  try {
+    po::notify(vm);
+  } catch (std::exception& e) {
+    std::cerr << "error:" << e.what() << "\n\n";
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+
+  options.listening_port[0] = vm["listening-port0"].as<int>();
+  options.listening_port[1] = vm["listening-port1"].as<int>();
+  options.num_requests = vm["num-requests"].as<std::size_t>();
+  options.max_classes = vm["max-classes"].as<std::size_t>();
+  options.max_batch_size = vm["max-batch-size"].as<std::size_t>();
+  for (auto port : options.listening_port) {
+    if (port < 1 || port > std::numeric_limits<std::uint16_t>::max()) {
+      std::cerr << "invalid port " << port << "\n";
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+// reads the next message of a server, std::nullopt if the server closed the connection
+std::optional<FinalShares> receive_final_shares(tcp::socket& socket, const Options& options) {
+  MOTION::ShareFileHeader header;
+  boost::system::error_code ec;
+  boost::asio::read(socket, boost::asio::buffer(&header, sizeof(header)), ec);
+  if (ec == boost::asio::error::eof) {
+    return std::nullopt;
+  } else if (ec) {
+    throw boost::system::system_error(ec);
+  }
+  if (!MOTION::is_valid_share_file_header(header)) {
+    throw std::runtime_error("received a message that is not a share file");
+  }
+  if (header.cols_ == 0) {
+    throw std::runtime_error("received a result without images");
+  }
+  // the dimensions come from the network, so bound them before allocating
+  if (header.rows_ == 0 || header.rows_ > options.max_classes ||
+      header.cols_ > options.max_batch_size) {
+    throw std::runtime_error("received a result of " + std::to_string(header.rows_) + " x " +
+                             std::to_string(header.cols_) + " values, at most " +
+                             std::to_string(options.max_classes) + " x " +
+                             std::to_string(options.max_batch_size) + " are accepted");
+  }
+  const auto num_elements = header.rows_ * header.cols_;
+  FinalShares shares{std::vector<std::uint64_t>(num_elements),
+                     std::vector<std::uint64_t>(num_elements), header.cols_};
+  const std::array<boost::asio::mutable_buffer, 2> buffers = {boost::asio::buffer(shares.Delta),
+                                                              boost::asio::buffer(shares.delta)};
+  boost::asio::read(socket, buffers);
+  return shares;
+}
+
+// index of the predicted class of every image, whose reconstructed bit is 0
+std::vector<std::size_t> reconstruct(const FinalShares& shares_0, const FinalShares& shares_1) {
+  if (shares_0.Delta != shares_1.Delta || shares_0.num_images != shares_1.num_images) {
+    throw std::runtime_error("the servers sent different public shares");
+  }
+  const auto num_images = shares_0.num_images;
+  const auto num_classes = shares_0.Delta.size() / num_images;
+  const auto bit = [&](std::size_t i) {
+    return (shares_0.Delta[i] ^ shares_0.delta[i] ^ shares_1.delta[i]) & 1;
+  };
+  std::vector<std::size_t> classes;
+  for (std::size_t image = 0; image < num_images; ++image) {
+    std::size_t c = 0;
+    while (c < num_classes && bit(c * num_images + image) != 0) {
+      ++c;
+    }
+    if (c == num_classes) {
+      throw std::runtime_error("the result does not contain a predicted class for image " +
+                               std::to_string(image));
+    }
+    classes.push_back(c);
+  }
+  return classes;
+}
+
+int main(int argc, char* argv[]) {
+  auto options = parse_program_options(argc, argv);
+  if (!options.has_value()) {
+    return EXIT_FAILURE;
+  }
+
+  try {
+    boost::asio::io_context io_context;
+    tcp::acceptor acceptor_0(io_context, tcp::endpoint(tcp::v4(), options->listening_port[0]));
+    tcp::acceptor acceptor_1(io_context, tcp::endpoint(tcp::v4(), options->listening_port[1]));
+    tcp::socket socket_0(io_context);
+    tcp::socket socket_1(io_context);
+    std::cout << "Waiting for the servers on ports " << options->listening_port[0] << " and "
+              << options->listening_port[1] << "\n";
+    acceptor_0.accept(socket_0);
+    acceptor_1.accept(socket_1);
+
+    for (std::size_t request = 0; options->num_requests == 0 || request < options->num_requests;
+         ++request) {
+      const auto shares_0 = receive_final_shares(socket_0, *options);
+      const auto shares_1 = receive_final_shares(socket_1, *options);
+      if (!shares_0.has_value() || !shares_1.has_value()) {
+        if (options->num_requests == 0 && !shares_0.has_value() && !shares_1.has_value()) {
+          break;
+        }
+        throw std::runtime_error("a server disconnected before sending all results");
+      }
+      for (auto c : reconstruct(*shares_0, *shares_1)) {
+        std::cout << "The image shared is detected as:" << c << "\n";
+      }
+    }
+  } catch (std::exception& e) {
+    std::cerr << "ERROR OCCURRED: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
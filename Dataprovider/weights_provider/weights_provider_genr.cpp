@@ -1,13 +1,19 @@
 //  ./bin/weights_provider_genr --compute-server0-ip 127.0.0.1 --compute-server0-port 1234
 //  --compute-server1-ip 127.0.0.1 --compute-server1-port 1235 --fractional-bits 13
 //  --filepath ${BASE_DIR}/data/ModelProvider --config-file-path ${BASE_DIR}/config_files/model_config.json
+//
+//  With --seed-compressed, each server receives a PRG seed for its delta and the public Delta values
+//  per matrix instead of (Delta, delta) pairs; the weight share receivers must use --seed-compressed too.
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <optional>
-#include <random>
 #include <stdexcept>
 #include <type_traits>
 #include <boost/chrono.hpp>
@@ -18,9 +24,12 @@
 #include <boost/serialization/string.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <omp.h>
 #include "./fixed-point.h"
+#include "crypto/random/aes128_ctr_rng.h"
 
 #define MAX_CONNECT_RETRIES 50
+#define SHARES_PER_CHUNK (1 << 14)
 using namespace std::chrono;
 namespace pt = boost::property_tree;
 using namespace boost::asio;
@@ -36,6 +45,7 @@ struct Options {
   std::string model_directory;
   std::filesystem::path config_file;
   int numberOfLayers;
+  bool seed_compressed;
 };
 bool is_valid_IP(const std::string& ip) {
   ip::address ipAddress;
@@ -82,6 +92,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("fractional-bits", po::value<size_t>()->required(), "Number of fractional bits")
     ("filepath", po::value<std::string>()->required(), "Directory where the weights and biases are stored")
     ("config-file-path", po::value<std::string>()->required(), "File path which has the name of all the weights and bias csv files")
+    ("seed-compressed", po::bool_switch()->default_value(false), "send a PRG seed for delta and the Delta values instead of (Delta, delta) pairs")
     ;
   // clang-format on
 
@@ -108,6 +119,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.fractional_bits = vm["fractional-bits"].as<size_t>();
   options.model_directory = vm["filepath"].as<std::string>();
   options.config_file = vm["config-file-path"].as<std::string>();
+  options.seed_compressed = vm["seed-compressed"].as<bool>();
   // --------------------------------- Input Validation ---------------------------------------//
 
   // Check whether IP addresses are valid
@@ -137,38 +149,52 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   return options;
 }
 
-template <typename E>
-std::uint64_t RandomNumDistribution(E& engine) {
-  std::uniform_int_distribution<unsigned long long> distribution(std::numeric_limits<std::uint64_t>::min(),
-                                                        std::numeric_limits<std::uint64_t>::max());
-  return distribution(engine);
-}
-
 struct Shares {
   uint64_t Delta, delta;
 };
 
 //----------------------------------Sending shares------------------------------------------//
+// Shares already have the (Delta, delta) layout of the wire format, so they are sent straight
+// from the share array in chunks of at most SHARES_PER_CHUNK shares, without a staging copy.
 void write_struct_vector(tcp::socket& socket, Shares* data, int num_elements) {
-  uint64_t arr[2 * num_elements];
-  int j = 0;
-  for (int i = 0; i < num_elements; i++) {
-    // uint64_t arr[2];
-    arr[j] = data[i].Delta;
-    j++;
-    arr[j] = data[i].delta;
-    j++;
-  }
+  static_assert(sizeof(Shares) == 2 * sizeof(uint64_t));
   boost::system::error_code error;
   std::cout << "Started sending the weight shares." <<std::endl;
-  boost::asio::write(socket, boost::asio::buffer(&arr, sizeof(arr)), error);
-  if (error) 
-      {
-      throw std::runtime_error("Unable to send shares.\nError:"+ error.message() + "\n");
-      }
+  for (int offset = 0; offset < num_elements; offset += SHARES_PER_CHUNK) {
+    int chunk_size = std::min(SHARES_PER_CHUNK, num_elements - offset);
+    boost::asio::write(socket, boost::asio::buffer(data + offset, chunk_size * sizeof(Shares)),
+                       error);
+    if (error) {
+      throw std::runtime_error("Unable to send shares.\nError:" + error.message() + "\n");
+    }
+  }
   std::cout<<"Sent successfully\n";
 }
 
+using Seed = std::array<std::byte, AES128_CTR_RNG::block_size>;
+
+// sends the seed from which the server expands its delta values, followed by the Delta values
+// (the seed is gathered into the write of the first chunk of Delta values)
+void write_seed_compressed(tcp::socket& socket, const Seed& seed, Shares* data, int num_elements) {
+  std::vector<uint64_t> Deltas(std::min(SHARES_PER_CHUNK, num_elements));
+  boost::system::error_code error;
+  std::cout << "Started sending the seed and the Delta values." << std::endl;
+  for (int offset = 0; offset == 0 || offset < num_elements; offset += SHARES_PER_CHUNK) {
+    int chunk_size = std::min(SHARES_PER_CHUNK, num_elements - offset);
+    for (int i = 0; i < chunk_size; i++) {
+      Deltas[i] = data[offset + i].Delta;
+    }
+    std::array<boost::asio::const_buffer, 2> buffers = {
+        boost::asio::buffer(seed, offset == 0 ? seed.size() : 0),
+        boost::asio::buffer(Deltas.data(), chunk_size * sizeof(uint64_t))};
+    boost::asio::write(socket, buffers, error);
+    if (error) {
+      throw std::runtime_error("Unable to send shares.\nError:" + error.message() + "\n");
+    }
+  }
+  std::cout << "Sent successfully\n";
+}
+
 void write_struct(tcp::socket& socket, Shares* data, int num_elements) {
   for (int i = 0; i < num_elements; i++) {
     uint64_t arr[2];
@@ -189,9 +215,11 @@ void write_struct(tcp::socket& socket, Shares* data, int num_elements) {
 class Matrix {
  private:
   uint64_t rows, columns, num_elements, fractional_bits;
+  bool seed_compressed;
   std::string fullFileName;
   std::vector<float> data;
   struct Shares *cs0_data, *cs1_data;
+  std::array<Seed, 2> seeds;
 
  public:
   Matrix(int row, int col, std::string fileName, std::size_t fraction_bits,
@@ -200,6 +228,7 @@ class Matrix {
     columns = col;
     num_elements = row * col;
     fractional_bits = fraction_bits;
+    seed_compressed = options.seed_compressed;
 
     fullFileName = fileName;
     std::cout << fullFileName << std::endl;
@@ -215,6 +244,7 @@ class Matrix {
   }
 
   int getNumberofElements() { return num_elements; }
+  const Seed& getSeed(int a) { return seeds[a]; }
   std::string getFileName() { return fullFileName; }
   //------------ Function to aceess data from the Matrix, Ramya May 3,2023 -------------
   Shares* getData(int a) {
@@ -257,37 +287,52 @@ class Matrix {
     std::cout << "\n";
   }
 
+  // Shares are generated in bulk: delta0 and delta1 are drawn from AES128_CTR_RNG and the values
+  // are encoded with the batch fixed point encoding, both split across the threads.
   void generateShares() {
     // Now that we have data, need to generate the shares
-    try{
-        for (int i = 0; i < data.size(); i++) {
-          std::random_device rd;
-          std::mt19937 gen(rd());
-          std::uint64_t del0 = RandomNumDistribution(gen), del1 = RandomNumDistribution(gen);
-          std::uint64_t Del =
-              del0 + del1 +
-              MOTION::new_fixed_point::encode<uint64_t, long double>(data[i], fractional_bits);
-          // For each data, creating 2 shares variables - 1 for CS0 and another for CS1
-          Shares cs0, cs1;
-
-          cs0.Delta = Del;
-          cs0.delta = del0;
-
-          cs1.Delta = Del;
-          cs1.delta = del1;
-
-          cs0_data[i] = cs0;
-          cs1_data[i] = cs1;
-
-          // std::cout << "Data = " << data[i] << " Delta = " << cs0.Delta << " delta0 = " << cs0.delta
-          // << " delta1 = " << cs1.delta << "\n";
+    const std::size_t n = data.size();
+    std::vector<uint64_t> del0(n), del1(n);
+    try {
+      if (seed_compressed) {
+        // delta of each server is expanded from a fresh seed, so that only the seed has to be
+        // sent. The server expands it as a single stream, hence this is not split across threads.
+        std::array<std::vector<uint64_t>*, 2> deltas = {&del0, &del1};
+        for (int id = 0; id < 2; id++) {
+          AES128_CTR_RNG::get_thread_instance().random_blocks(seeds[id].data(), 1);
+          AES128_CTR_RNG rng;
+          rng.set_key(seeds[id].data());
+          rng.random_bytes(reinterpret_cast<std::byte*>(deltas[id]->data()), n * sizeof(uint64_t));
         }
       }
-    catch(std::exception& e){
+    } catch (std::exception& e) {
       std::string err = e.what();
       throw std::runtime_error("Error during share generation: " + err + "\n");
     }
-    // return EXIT_SUCCESS;
+
+#pragma omp parallel
+    {
+      const std::size_t num_threads = omp_get_num_threads();
+      const std::size_t thread_id = omp_get_thread_num();
+      const std::size_t begin = n * thread_id / num_threads;
+      const std::size_t end = n * (thread_id + 1) / num_threads;
+      if (!seed_compressed) {
+        auto& rng = AES128_CTR_RNG::get_thread_instance();
+        rng.random_bytes(reinterpret_cast<std::byte*>(del0.data() + begin),
+                         (end - begin) * sizeof(uint64_t));
+        rng.random_bytes(reinterpret_cast<std::byte*>(del1.data() + begin),
+                         (end - begin) * sizeof(uint64_t));
+      }
+      std::vector<uint64_t> encoded(end - begin);
+      MOTION::new_fixed_point::encode<uint64_t, float>(encoded.data(), data.data() + begin,
+                                                       fractional_bits, end - begin);
+      // For each data, creating 2 shares variables - 1 for CS0 and another for CS1
+      for (std::size_t i = begin; i < end; i++) {
+        std::uint64_t Del = del0[i] + del1[i] + encoded[i - begin];
+        cs0_data[i] = {Del, del0[i]};
+        cs1_data[i] = {Del, del1[i]};
+      }
+    }
   }
 };
 
@@ -378,151 +423,163 @@ std::vector<Matrix> read_Data(Options& options) {
   return allData;
 }
 
-void send_shares_to_servers(std::vector<Matrix> data_shares, const Options& options) {
-  std::cout << "Sending shares to the compute servers." << std::endl;
+// sends all the shares of compute server i
+void send_shares_to_server(int i, std::vector<Matrix>& data_shares, const Options& options) {
+  boost::asio::io_service io_service;
 
-  for(int i = 1; i >= 0; --i) {
-    boost::asio::io_service io_service;
+  // socket creation
+  tcp::socket socket(io_service);
 
-    // socket creation
-    tcp::socket socket(io_service);
+  uint64_t frac_bits = options.fractional_bits;
+  std::cout << "Fractional bits:" << options.fractional_bits << "\n";
+  auto port = options.cs0_port;
+  auto ip = options.cs0_ip;
+  if (i) {
+    port = options.cs1_port;
+    ip = options.cs1_ip;
+  }
 
-    uint64_t frac_bits = options.fractional_bits;
-    std::cout << "Fractional bits:" << options.fractional_bits << "\n";
-    auto port = options.cs0_port;
-    auto ip = options.cs0_ip;
-    if (i) {
-      port = options.cs1_port;
-      ip = options.cs1_ip;
-    }
+  // -------------------- Establishing socket connection with the servers -----------------------------
+  if(establishConnection(socket,ip,port)){
+      std::cout<<"Connection established successfully\n";
+  }
+  else{
+      socket.close();
+      throw std::runtime_error("Connection could not established with the weights share receiver in server "+ std::to_string(i) +"\n");
+  }
+  boost::system::error_code send_error, read_error;
+  //------------------------ Sending number of layers to be expected -----------------------------------
+  boost::asio::write(socket, boost::asio::buffer(&options.numberOfLayers, sizeof(options.numberOfLayers)),send_error);
+  if (send_error) {
+      socket.close();
+      throw std::runtime_error("Could not send the number of layers. Error: " + send_error.message()+"\n");
+  }
+  std::cout<<"Sent the number of layers to weight share receivers.\n";
 
-    // -------------------- Establishing socket connection with the servers -----------------------------
-    if(establishConnection(socket,ip,port)){
-        std::cout<<"Connection established successfully\n";
-    }
-    else{
+  // getting a response from the server
+  boost::asio::streambuf receive_buffer_layer;
+  boost::asio::read_until(socket, receive_buffer_layer, "\n",read_error);
+  if (read_error) {
+      if(read_error == boost::asio::error::eof) {
         socket.close();
-        throw std::runtime_error("Connection could not established with the weights share receiver in server "+ std::to_string(i) +"\n");
-    }
-    boost::system::error_code send_error, read_error;
-    //------------------------ Sending number of layers to be expected -----------------------------------
-    boost::asio::write(socket, boost::asio::buffer(&options.numberOfLayers, sizeof(options.numberOfLayers)),send_error);
-    if (send_error) {
+        throw std::runtime_error("Connection closed by weight share receivers. Read error: "+ read_error.message()+"\n");
+      } 
+      else{
         socket.close();
-        throw std::runtime_error("Could not send the number of layers. Error: " + send_error.message()+"\n");
-    }
-    std::cout<<"Sent the number of layers to weight share receivers.\n";
+        throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for number of layers message. Read error: "+ read_error.message()+"\n");
+      }
+  }
+  const char* data = boost::asio::buffer_cast<const char*>(receive_buffer_layer.data());
+  std::cout << "Received response: "<< data << std::endl;
 
-    // getting a response from the server
-    boost::asio::streambuf receive_buffer_layer;
-    boost::asio::read_until(socket, receive_buffer_layer, "\n",read_error);
-    if (read_error) {
-        if(read_error == boost::asio::error::eof) {
-          socket.close();
-          throw std::runtime_error("Connection closed by weight share receivers. Read error: "+ read_error.message()+"\n");
-        } 
-        else{
-          socket.close();
-          throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for number of layers message. Read error: "+ read_error.message()+"\n");
-        }
-    }
-    const char* data = boost::asio::buffer_cast<const char*>(receive_buffer_layer.data());
-    std::cout << "Received response: "<< data << std::endl;
+  // -------------------- Sending the number of fractional bits to the server --------------------------
+  boost::asio::write(socket, boost::asio::buffer(&frac_bits, sizeof(frac_bits)), send_error);
+  if (send_error) {
+    socket.close();
+    throw std::runtime_error("Could not send the number of fractional bits: "+send_error.message() + "\n");
+  }
 
-    // -------------------- Sending the number of fractional bits to the server --------------------------
-    boost::asio::write(socket, boost::asio::buffer(&frac_bits, sizeof(frac_bits)), send_error);
-    if (send_error) {
+  // getting a response from the server
+  boost::asio::streambuf receive_buffer_init;
+  boost::asio::read_until(socket, receive_buffer_init, "\n", read_error);
+  if (read_error) {
       socket.close();
-      throw std::runtime_error("Could not send the number of fractional bits: "+send_error.message() + "\n");
+      if(read_error == boost::asio::error::eof) {  
+        throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
+      } 
+      else{
+        throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for fractional bits message. Read error: " + read_error.message() + "\n");
+      }   
+  }
+  data = boost::asio::buffer_cast<const char*>(receive_buffer_init.data());
+  std::cout << "Received response: "<< data << std::endl;
+  // ------------------------------------ Sending shares ------------------------------------------------
+  std::cout<<"Start sending all the weight and bias shares\n";
+  for (auto& data_array : data_shares) {
+    std::cout << "File name:" << data_array.getFileName() << "\n";
+    // ----Send rows and columns to compute server----
+    int rows, columns;
+    auto vector_dimensions = data_array.getShareDimensions();
+    std::cout << "Rows, columns: " << vector_dimensions.first << " " << vector_dimensions.second << std::endl;
+    boost::asio::write(socket, boost::asio::buffer(&vector_dimensions, sizeof(vector_dimensions)), send_error);
+    if (send_error) {
+    socket.close();
+    throw std::runtime_error("Unable to send data size (rows,columns). Error: " + send_error.message() + "\n");
     }
 
     // getting a response from the server
-    boost::asio::streambuf receive_buffer_init;
-    boost::asio::read_until(socket, receive_buffer_init, "\n", read_error);
+    boost::asio::streambuf receive_buffer;
+    boost::asio::read_until(socket, receive_buffer, "\n", read_error);
     if (read_error) {
-        socket.close();
-        if(read_error == boost::asio::error::eof) {  
-          throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
-        } 
-        else{
-          throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for fractional bits message. Read error: " + read_error.message() + "\n");
-        }   
-    }
-    data = boost::asio::buffer_cast<const char*>(receive_buffer_init.data());
-    std::cout << "Received response: "<< data << std::endl;
-    // ------------------------------------ Sending shares ------------------------------------------------
-    std::cout<<"Start sending all the weight and bias shares\n";
-    for (auto data_array : data_shares) {
-      std::cout << "File name:" << data_array.getFileName() << "\n";
-      // ----Send rows and columns to compute server----
-      int rows, columns;
-      auto vector_dimensions = data_array.getShareDimensions();
-      std::cout << "Rows, columns: " << vector_dimensions.first << " " << vector_dimensions.second << std::endl;
-      boost::asio::write(socket, boost::asio::buffer(&vector_dimensions, sizeof(vector_dimensions)), send_error);
-      if (send_error) {
       socket.close();
-      throw std::runtime_error("Unable to send data size (rows,columns). Error: " + send_error.message() + "\n");
-      }
-
-      // getting a response from the server
-      boost::asio::streambuf receive_buffer;
-      boost::asio::read_until(socket, receive_buffer, "\n", read_error);
-      if (read_error) {
-        socket.close();
-        if(read_error == boost::asio::error::eof) {
-          throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
-        } 
-        else{
-          throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for the data size message. Read error: " + read_error.message() + "\n");
-        }
-      }
-      data = boost::asio::buffer_cast<const char*>(receive_buffer.data());
-      std::cout <<"Received Response: " << data << std::endl;
-      
-      // -----Sending share data to compute_server------
-      auto share_data = data_array.getData(0);
-      if (i) {
-        share_data = data_array.getData(1);
+      if(read_error == boost::asio::error::eof) {
+        throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
+      } 
+      else{
+        throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for the data size message. Read error: " + read_error.message() + "\n");
       }
-      // std::cout << "inside main size of cs 0 data:" << sizeof(cs0_data)<< "\n";
-      // std::cout << "inside main size of data:" << sizeof(share_data)<< "\n";
-      //  Use auto keyword to avoid typing long
-      //  type definitions to get the timepoint
-      //  at this instant use function now()
-      auto start = high_resolution_clock::now();
-      int num_of_elements = data_array.getNumberofElements();
-      std::cout << "Number of elements:" << num_of_elements << std::endl;
-      std::cout << "....Sending data...." << "\n";
-      try{
+    }
+    data = boost::asio::buffer_cast<const char*>(receive_buffer.data());
+    std::cout <<"Received Response: " << data << std::endl;
+    
+    // -----Sending share data to compute_server------
+    auto share_data = data_array.getData(0);
+    if (i) {
+      share_data = data_array.getData(1);
+    }
+    // std::cout << "inside main size of cs 0 data:" << sizeof(cs0_data)<< "\n";
+    // std::cout << "inside main size of data:" << sizeof(share_data)<< "\n";
+    //  Use auto keyword to avoid typing long
+    //  type definitions to get the timepoint
+    //  at this instant use function now()
+    auto start = high_resolution_clock::now();
+    int num_of_elements = data_array.getNumberofElements();
+    std::cout << "Number of elements:" << num_of_elements << std::endl;
+    std::cout << "....Sending data...." << "\n";
+    try{
+      if (options.seed_compressed) {
+        write_seed_compressed(socket, data_array.getSeed(i), share_data, num_of_elements);
+      } else {
         write_struct_vector(socket, share_data, num_of_elements);
       }
-      catch(std::runtime_error& e){
-          socket.close();
-          throw std::runtime_error(e.what());  
-      }
-      std::cout << "Data sent.\n";
-
-      // getting a response from the server
-      boost::asio::streambuf receive_buff;
-      boost::asio::read_until(socket, receive_buff, "\n",read_error);
-      if (read_error) {
+    }
+    catch(std::runtime_error& e){
         socket.close();
-        if(read_error == boost::asio::error::eof) {
-          throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
-        } 
-        else{
-          throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for the weight shares. Read error: " + read_error.message() + "\n");
-        }
+        throw std::runtime_error(e.what());  
+    }
+    std::cout << "Data sent.\n";
+
+    // getting a response from the server
+    boost::asio::streambuf receive_buff;
+    boost::asio::read_until(socket, receive_buff, "\n",read_error);
+    if (read_error) {
+      socket.close();
+      if(read_error == boost::asio::error::eof) {
+        throw std::runtime_error("Connection closed by weight share receivers. Read error: " + read_error.message() + "\n");
+      } 
+      else{
+        throw std::runtime_error("Error while receiving acknowledgment from weight share receivers for the weight shares. Read error: " + read_error.message() + "\n");
       }
-      data = boost::asio::buffer_cast<const char*>(receive_buff.data());
-      std::cout << "Received response: " << data << std::endl;
-      auto stop = high_resolution_clock::now();
-      auto duration = duration_cast<milliseconds>(stop - start);
-      std::cout << "Time taken to send the shares:" << duration.count() << "msec" << std::endl;
     }
-    std::cout << "Data sent to server " << i << std::endl;
-    socket.close();
+    data = boost::asio::buffer_cast<const char*>(receive_buff.data());
+    std::cout << "Received response: " << data << std::endl;
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<milliseconds>(stop - start);
+    std::cout << "Time taken to send the shares:" << duration.count() << "msec" << std::endl;
   }
+  std::cout << "Data sent to server " << i << std::endl;
+  socket.close();
+}
+
+// uploads to both compute servers concurrently
+void send_shares_to_servers(std::vector<Matrix>& data_shares, const Options& options) {
+  std::cout << "Sending shares to the compute servers." << std::endl;
+  auto upload_1 = std::async(std::launch::async, send_shares_to_server, 1, std::ref(data_shares),
+                             std::cref(options));
+  auto upload_0 = std::async(std::launch::async, send_shares_to_server, 0, std::ref(data_shares),
+                             std::cref(options));
+  upload_1.get();
+  upload_0.get();
 }
 
 void send_confirmation(const Options& options) {
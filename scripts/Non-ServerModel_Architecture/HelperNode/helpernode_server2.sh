@@ -62,16 +62,12 @@ echo "Helper node starts"
 
 ############################ Inputs for inferencing tasks #######################################################################################
 # ####################################### Matrix multiplication layer 1 ###########################################################################
-for((layer_id=1; layer_id<=$number_of_layers; layer_id++))
-do
-
-$build_path/bin/server2 --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference> $debug_2/helpernode_layer${layer_id}.txt &
+# server 0 and server 1 send the requests of all layers in one session
+$build_path/bin/server2 --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --num-sessions 1 > $debug_2/helpernode.txt &
 pid1=$!
 
 wait $pid1
 check_exit_statuses $?
-echo "Helper node layer $layer_id is done"
-
-done
+echo "Helper node is done"
 
 wait
\ No newline at end of file
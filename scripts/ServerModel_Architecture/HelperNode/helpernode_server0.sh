@@ -150,43 +150,49 @@ then
 fi
 start=$(date +%s)
 #######################################Matrix multiplication layer 1 ###########################################################################
-for((; layer_id<$number_of_layers; layer_id++))
-do
-
-if [ $layer_id -gt 1 ];
-then
-    input_config="outputshare"
-fi
-
-
-$build_path/bin/server0 --WB_file file_config_model0 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --current-path $build_path --layer-id $layer_id --fractional-bits $fractional_bits > $debug_0/server0_layer${layer_id}.txt &
-pid1=$!
-wait $pid1
-check_exit_statuses $?
-echo "Layer $layer_id: Matrix multiplication and addition is done"
-
-# #######################################ReLu layer 1 ####################################################################################
-$build_path/bin/tensor_gt_relu --my-id 0 --party 0,$cs0_host,$relu0_port_inference --party 1,$cs1_host,$relu1_port_inference --arithmetic-protocol beavy --boolean-protocol yao --fractional-bits $fractional_bits --filepath file_config_input0 --current-path $build_path > $debug_0/tensor_gt_relu1_layer0.txt &
-pid1=$!
-wait $pid1
-check_exit_statuses $?
-echo "Layer $layer_id: ReLU is done"
+# server0 computes all layers over the same connections to the other server and the helper node.
+# It prints "Layer <id> done" when the output shares of a layer are written and starts the next
+# layer when it reads a line, i.e., once the ReLU step has written the input of that layer.
+coproc SERVER0 { $build_path/bin/server0 --WB_file file_config_model0 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --current-path $build_path --layer-id $layer_id --num-layers $number_of_layers --fractional-bits $fractional_bits; }
+server0_pid=$SERVER0_PID
+exec {server0_out}<&${SERVER0[0]} {server0_in}>&${SERVER0[1]}
+
+# copies the output of server0 to its log until it has finished the given layer
+wait_for_layer() {
+   local line
+   while IFS= read -r -u $server0_out line;
+   do
+      echo "$line" >> $debug_0/server0.txt
+      if [ "$line" == "Layer $1 done" ]; then
+         return 0
+      fi
+   done
+   return 1
+}
 
+for((; layer_id<=$number_of_layers; layer_id++))
+do
+   wait_for_layer $layer_id
+   check_exit_statuses $?
+   echo "Layer $layer_id: Matrix multiplication and addition is done"
+   if [ $layer_id -eq $number_of_layers ];
+   then
+      break
+   fi
+
+   #######################################ReLu layer ####################################################################################
+   $build_path/bin/tensor_gt_relu --my-id 0 --party 0,$cs0_host,$relu0_port_inference --party 1,$cs1_host,$relu1_port_inference --arithmetic-protocol beavy --boolean-protocol yao --fractional-bits $fractional_bits --filepath file_config_input0 --current-path $build_path > $debug_0/tensor_gt_relu1_layer0.txt &
+   pid1=$!
+   wait $pid1
+   check_exit_statuses $?
+   echo "Layer $layer_id: ReLU is done"
+   # the ReLU output is the input of the next layer
+   echo "next" >&$server0_in
 done
-#######################Next layer, layer 2, inputs for layer 2 ###################################################################################################
-
-#Updating the config file for layers 2 and above.
-if [ $layer_id -gt 1 ];
-then
-    input_config="outputshare"
-fi
-
-#######################################Matrix multiplication layer 2....n ###########################################################################
-$build_path/bin/server0 --WB_file file_config_model0 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference  --current-path $build_path --layer-id $layer_id --fractional-bits $fractional_bits > $debug_0/server0_layer${layer_id}.txt &
-pid1=$!
-wait $pid1
+cat <&$server0_out >> $debug_0/server0.txt
+wait $server0_pid
 check_exit_statuses $?
-echo "Layer $layer_id: Matrix multiplication and addition is done"
+
 
 ####################################### Argmax  ###########################################################################
 $build_path/bin/argmax --my-id 0 --threads 1 --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --arithmetic-protocol beavy --boolean-protocol beavy --repetitions 1 --config-filename file_config_input0 --config-input $image_share --current-path $build_path > $debug_0/argmax0_layer2.txt &
@@ -150,43 +150,49 @@ then
 fi
 start=$(date +%s)
 #######################################Matrix multiplication layer 1 ###########################################################################
-for((; layer_id<$number_of_layers; layer_id++))
-do
-
-if [ $layer_id -gt 1 ];
-then
-    input_config="outputshare"
-fi
-
-$build_path/bin/server1 --WB_file file_config_model1 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --current-path $build_path --layer-id $layer_id --fractional-bits $fractional_bits > $debug_1/server1_layer${layer_id}.txt &
-
-pid1=$!
-wait $pid1
-check_exit_statuses $?
-echo "Layer $layer_id: Matrix multiplication and addition is done"
+# server1 computes all layers over the same connections to the other server and the helper node.
+# It prints "Layer <id> done" when the output shares of a layer are written and starts the next
+# layer when it reads a line, i.e., once the ReLU step has written the input of that layer.
+coproc SERVER1 { $build_path/bin/server1 --WB_file file_config_model1 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --current-path $build_path --layer-id $layer_id --num-layers $number_of_layers --fractional-bits $fractional_bits; }
+server1_pid=$SERVER1_PID
+exec {server1_out}<&${SERVER1[0]} {server1_in}>&${SERVER1[1]}
+
+# copies the output of server1 to its log until it has finished the given layer
+wait_for_layer() {
+   local line
+   while IFS= read -r -u $server1_out line;
+   do
+      echo "$line" >> $debug_1/server1.txt
+      if [ "$line" == "Layer $1 done" ]; then
+         return 0
+      fi
+   done
+   return 1
+}
 
-# #######################################ReLu layer 1 ####################################################################################
-$build_path/bin/tensor_gt_relu --my-id 1 --party 0,$cs0_host,$relu0_port_inference --party 1,$cs1_host,$relu1_port_inference --arithmetic-protocol beavy --boolean-protocol yao --fractional-bits $fractional_bits --filepath file_config_input1 --current-path $build_path > $debug_1/tensor_gt_relu1_layer1.txt &
-pid1=$!
-wait $pid1
-check_exit_statuses $?
-echo "Layer $layer_id: ReLU is done"
+for((; layer_id<=$number_of_layers; layer_id++))
+do
+   wait_for_layer $layer_id
+   check_exit_statuses $?
+   echo "Layer $layer_id: Matrix multiplication and addition is done"
+   if [ $layer_id -eq $number_of_layers ];
+   then
+      break
+   fi
+
+   #######################################ReLu layer ####################################################################################
+   $build_path/bin/tensor_gt_relu --my-id 1 --party 0,$cs0_host,$relu0_port_inference --party 1,$cs1_host,$relu1_port_inference --arithmetic-protocol beavy --boolean-protocol yao --fractional-bits $fractional_bits --filepath file_config_input1 --current-path $build_path > $debug_1/tensor_gt_relu1_layer1.txt &
+   pid1=$!
+   wait $pid1
+   check_exit_statuses $?
+   echo "Layer $layer_id: ReLU is done"
+   # the ReLU output is the input of the next layer
+   echo "next" >&$server1_in
 done
-#######################Next layer, layer 2, inputs for layer 2 ###################################################################################################
-
-#Updating the config file for layers 2 and above.
-if [ $layer_id -gt 1 ];
-then
-    input_config="outputshare"
-fi
-
-#######################################Matrix multiplication layer 2 ###########################################################################
+cat <&$server1_out >> $debug_1/server1.txt
+wait $server1_pid
+check_exit_statuses $?
 
-$build_path/bin/server1 --WB_file file_config_model1 --input_file $input_config  --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --helper_node $helpernode_host,$helpernode_port_inference --current-path $build_path --layer-id $layer_id --fractional-bits $fractional_bits > $debug_1/server1_layer${layer_id}.txt &
-pid1=$!
-wait $pid1
-check_exit_statuses $? 
-echo "Layer $layer_id: Matrix multiplication and addition is done"
 
 ####################################### Argmax  ###########################################################################
 
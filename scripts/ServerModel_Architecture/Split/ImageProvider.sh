@@ -42,9 +42,19 @@ cs0_port_cs0_output_receiver=`echo $smpc_config | jq -r .cs0_port_cs0_output_rec
 cs0_port_cs1_output_receiver=`echo $smpc_config | jq -r .cs0_port_cs1_output_receiver`
 
 fractional_bits=`echo $smpc_config | jq -r .fractional_bits`
+# Receive the final output shares streamed directly by inference_engine
+direct_output=`echo $smpc_config | jq -r '.direct_output // false'`
 
 # Index of the image for which inferencing task is run
 image_id=`echo $smpc_config | jq -r .image_id`
+# Number of images (image_id, image_id + 1, ...) evaluated together, only supported by inference_engine
+batch_size=`echo $smpc_config | jq -r '.batch_size // 1'`
+if [[ $batch_size -gt 1 && $direct_output != "true" ]];
+then
+	# output_shares_receiver and Reconstruct handle the result of a single image
+	echo "batch_size > 1 requires direct_output"
+	exit 1
+fi
 
 if [ ! -d "$debug_ImageProv" ];
 then
@@ -55,13 +65,21 @@ fi
 #--------------------------------------------- Image Share Provider -------------------------------------------------------#
 # Create Image shares and send it to server 0 and server 1
 echo "Image Provider starts"
-$build_path/bin/image_provider_iudx --compute-server0-ip $cs0_host --compute-server0-port $cs0_port_image_receiver --compute-server1-ip $cs1_host --compute-server1-port $cs1_port_image_receiver --fractional-bits $fractional_bits --index $image_id --filepath $image_path > $debug_ImageProv/image_provider.txt &
+$build_path/bin/image_provider_iudx --compute-server0-ip $cs0_host --compute-server0-port $cs0_port_image_receiver --compute-server1-ip $cs1_host --compute-server1-port $cs1_port_image_receiver --fractional-bits $fractional_bits --index $image_id --batch-size $batch_size --filepath $image_path > $debug_ImageProv/image_provider.txt &
 pid1=$!
 wait $pid1
 check_exit_statuses $?
 echo "Image shares sent."
 #------------------------------------------ Share generators end  ----------------------------------------------------------#
 
+if [[ $direct_output == "true" ]];
+then
+#------------------------------------------ Inference result receiver ------------------------------------------------------#
+# Receiving the shares of the result from server 0 and server 1 and reconstructing it as soon as both arrived
+echo "Image Provider is waiting for the inferencing result"
+$build_path/bin/inference_result_receiver --listening-port0 $cs0_port_cs0_output_receiver --listening-port1 $cs0_port_cs1_output_receiver
+check_exit_statuses $?
+else
 #------------------------------------------ Output share receivers ---------------------------------------------------------#
 # Receiving the shares of the result from server 0 and server 1
 $build_path/bin/output_shares_receiver --my-id 0 --listening-port $cs0_port_cs0_output_receiver --current-path $output_shares_path > $debug_ImageProv/output_shares_receiver0.txt &
@@ -83,4 +101,5 @@ $build_path/bin/Reconstruct --current-path $output_shares_path
 pid1=$!
 wait $pid1
 check_exit_statuses $?
+fi
 wait
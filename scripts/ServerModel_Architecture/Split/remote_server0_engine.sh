@@ -0,0 +1,201 @@
+#!/bin/bash
+check_exit_statuses() {
+   for status in "$@";
+   do
+      if [ $status -ne 0 ]; then
+         echo "Exiting due to error."
+         exit 1  # Exit the script with a non-zero exit code
+      fi
+   done
+}
+# paths required to run cpp files
+image_config=${BASE_DIR}/config_files/file_config_input_remote
+build_path=${BASE_DIR}/build_debwithrelinfo_gcc
+image_path=${BASE_DIR}/data/ImageProvider
+image_provider_path=${BASE_DIR}/data/ImageProvider/Final_Output_Shares
+debug_0=${BASE_DIR}/logs/server0
+scripts_path=${BASE_DIR}/scripts
+smpc_config_path=${BASE_DIR}/config_files/smpc-split-config.json
+smpc_config=`cat $smpc_config_path`
+# #####################Inputs##########################################################################################################
+# Do dns reolution or not 
+cs0_dns_resolve=`echo $smpc_config | jq -r .cs0_dns_resolve`
+cs1_dns_resolve=`echo $smpc_config | jq -r .cs1_dns_resolve`
+reverse_ssh_dns_resolve=`echo $smpc_config | jq -r .reverse_ssh_dns_resolve`
+
+# cs0_host is the ip/domain of server0, cs1_host is the ip/domain of server1
+cs0_host=`echo $smpc_config | jq -r .cs0_host`
+cs1_host=`echo $smpc_config | jq -r .cs1_host`
+reverse_ssh_host=`echo $smpc_config | jq -r .reverse_ssh_host`
+
+if [[ $cs0_dns_resolve == "true" ]];
+then 
+cs0_host=`dig +short $cs0_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+if [[ $cs1_dns_resolve == "true" ]];
+then 
+cs1_host=`dig +short $cs1_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+if [[ $reverse_ssh_dns_resolve == "true" ]];
+then 
+reverse_ssh_host=`dig +short $reverse_ssh_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+# Ports on which weights provider  receiver listens/talks
+cs0_port_model_receiver=`echo $smpc_config | jq -r .cs0_port_model_receiver`
+cs1_port_model_receiver=`echo $smpc_config | jq -r .cs1_port_model_receiver`
+
+# Ports on which image provider  receiver listens/talks
+cs0_port_image_receiver=`echo $smpc_config | jq -r .cs0_port_image_receiver`
+cs1_port_image_receiver=`echo $smpc_config | jq -r .cs1_port_image_receiver`
+
+# Ports on which Image provider listens for final inference output
+cs0_port_cs0_output_receiver=`echo $smpc_config | jq -r .cs0_port_cs0_output_receiver`
+cs0_port_cs1_output_receiver=`echo $smpc_config | jq -r .cs0_port_cs1_output_receiver`
+
+# Stream the final output shares directly to the image provider's inference_result_receiver
+direct_output=`echo $smpc_config | jq -r '.direct_output // false'`
+output_receiver_options=""
+if [[ $direct_output == "true" ]];
+then
+output_receiver_options="--output-receiver-ip $reverse_ssh_host --output-receiver-port $cs0_port_cs0_output_receiver"
+fi
+
+# Ports on which server0 and server1 of the inferencing tasks talk to each other
+cs0_port_inference=`echo $smpc_config | jq -r .cs0_port_inference`
+cs1_port_inference=`echo $smpc_config | jq -r .cs1_port_inference`
+relu0_port_inference=`echo $smpc_config | jq -r .relu0_port_inference`
+relu1_port_inference=`echo $smpc_config | jq -r .relu1_port_inference`
+
+number_of_layers=`echo $smpc_config | jq -r .number_of_layers`
+fractional_bits=`echo $smpc_config | jq -r .fractional_bits`
+
+# Index of the image for which inferencing task is run
+image_id=`echo $smpc_config | jq -r .image_id`
+
+#number of splits
+# splits=`echo "$smpc_config" | jq -r .splits`
+
+# echo all input variables
+#echo "cs0_host $cs0_host"
+#echo "cs1_host $cs1_host"
+#echo "cs0_port_model_receiver $cs0_port_model_receiver"
+#echo "cs1_port_model_receiver $cs1_port_model_receiver"
+#echo "cs0_port_cs0_output_receiver $cs0_port_cs0_output_receiver"
+#echo "cs0_port_cs1_output_receiver $cs0_port_cs1_output_receiver"
+#echo "cs0_port_inference $cs0_port_inference"
+#echo "cs1_port_inference $cs1_port_inference"
+#echo "fractional bits: $fractional_bits"
+#echo "no. of splits: $splits"
+##########################################################################################################################################
+
+
+if [ ! -d "$debug_0" ];
+then
+	# Recursively create the required directories
+	mkdir -p $debug_0
+fi
+
+
+cd $build_path
+
+if [ -f finaloutput_0 ]; then
+   rm finaloutput_0
+   # echo "final output 0 is removed"
+fi
+
+if [ -f MemoryDetails0 ]; then
+   rm MemoryDetails0
+   # echo "Memory Details0 are removed"
+fi
+
+if [ -f AverageMemoryDetails0 ]; then
+   rm AverageMemoryDetails0
+   # echo "Average Memory Details0 are removed"
+fi
+
+if [ -f AverageMemory0 ]; then
+   rm AverageMemory0
+   # echo "Average Memory Details0 are removed"
+fi
+
+if [ -f AverageTimeDetails0 ]; then
+   rm AverageTimeDetails0
+   # echo "AverageTimeDetails0 is removed"
+fi
+
+if [ -f AverageTime0 ]; then
+   rm AverageTime0
+   # echo "AverageTime0 is removed"
+fi
+
+#########################Weights Share Receiver ############################################################################################
+echo "Weight shares receiver starts"
+$build_path/bin/weight_share_receiver_genr --my-id 0 --port $cs0_port_model_receiver --current-path $build_path > $debug_0/Weights_Share_Receiver.txt &
+pid1=$!
+
+#########################Image Share Receiver ############################################################################################
+echo "Image shares receiver starts"
+$build_path/bin/Image_Share_Receiver --my-id 0 --port $cs0_port_image_receiver --fractional-bits $fractional_bits --file-names $image_config --current-path $build_path > $debug_0/Image_Share_Receiver.txt &
+pid2=$!
+
+wait $pid1
+check_exit_statuses $? 
+wait $pid2
+check_exit_statuses $?
+
+echo "Weight shares received"
+echo "Image shares received"
+#########################Share generators end ############################################################################################
+
+########################Inferencing task starts ###############################################################################################
+echo "Inferencing task of the image shared starts"
+
+start=$(date +%s)
+
+####################################### Inference (all layers and argmax in one process) ##################################################
+$build_path/bin/inference_engine --my-id 0 --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --arithmetic-protocol beavy --boolean-protocol beavy --fractional-bits $fractional_bits --config-file-input remote_image_shares --config-file-model file_config_model0 --current-path $build_path $output_receiver_options > $debug_0/inference_engine0.txt &
+pid1=$!
+
+wait $pid1
+check_exit_statuses $?
+
+end=$(date +%s)
+
+echo "Inference of all $number_of_layers layers and argmax is done"
+
+####################################### Final output provider  ###########################################################################
+if [[ $direct_output != "true" ]];
+then
+   $build_path/bin/final_output_provider --my-id 0 --connection-ip $reverse_ssh_host --connection-port $cs0_port_cs0_output_receiver --config-input remote_image_shares --current-path $build_path > $debug_0/final_output_provider.txt &
+   pid3=$!
+   wait $pid3
+   check_exit_statuses $?
+   echo "Output shares of server 0 sent to the image provider"
+fi
+
+wait 
+
+awk '{ sum += $1 } END { print sum }' AverageTimeDetails0 >> AverageTime0
+
+sort -r -g AverageMemoryDetails0 | head  -1 >> AverageMemory0
+
+echo -e "\nInferencing Finished"
+
+Mem=`cat AverageMemory0`
+Time=`cat AverageTime0`
+
+Mem=$(printf "%.2f" $Mem) 
+Convert_KB_to_GB=$(printf "%.14f" 9.5367431640625E-7)
+Mem2=$(echo "$Convert_KB_to_GB * $Mem" | bc -l)
+
+Memory=$(printf "%.3f" $Mem2)
+
+echo "Memory requirement:" `printf "%.3f" $Memory` "GB"
+echo "Time taken by inferencing task:" $Time "ms"
+echo "Elapsed Time: $(($end-$start)) seconds"
+
+
+cd $scripts_path 
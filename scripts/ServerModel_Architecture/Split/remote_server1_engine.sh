@@ -0,0 +1,193 @@
+#!/bin/bash
+check_exit_statuses() {
+   for status in "$@";
+   do
+      if [ $status -ne 0 ]; then
+         echo "Exiting due to error."
+         exit 1  # Exit the script with a non-zero exit code
+      fi
+   done
+}
+image_config=${BASE_DIR}/config_files/file_config_input_remote
+build_path=${BASE_DIR}/build_debwithrelinfo_gcc
+model_provider_path=${BASE_DIR}/data/ModelProvider
+debug_1=${BASE_DIR}/logs/server1
+smpc_config_path=${BASE_DIR}/config_files/smpc-split-config.json
+smpc_config=`cat $smpc_config_path`
+# #####################Inputs##########################################################################################################
+# Do dns resolution or not 
+cs0_dns_resolve=`echo $smpc_config | jq -r .cs0_dns_resolve`
+cs1_dns_resolve=`echo $smpc_config | jq -r .cs1_dns_resolve`
+reverse_ssh_dns_resolve=`echo $smpc_config | jq -r .reverse_ssh_dns_resolve`
+
+# cs0_host is the ip/domain of server0, cs1_host is the ip/domain of server1
+cs0_host=`echo $smpc_config | jq -r .cs0_host`
+cs1_host=`echo $smpc_config | jq -r .cs1_host`
+reverse_ssh_host=`echo $smpc_config | jq -r .reverse_ssh_host`
+
+if [[ $cs0_dns_resolve == "true" ]];
+then 
+cs0_host=`dig +short $cs0_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+if [[ $cs1_dns_resolve == "true" ]];
+then 
+cs1_host=`dig +short $cs1_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+if [[ $reverse_ssh_dns_resolve == "true" ]];
+then 
+reverse_ssh_host=`dig +short $reverse_ssh_host | grep '^[.0-9]*$' | head -n 1`
+fi
+
+# Ports on which weights provider  receiver listens/talks
+cs0_port_model_receiver=`echo $smpc_config | jq -r .cs0_port_model_receiver`
+cs1_port_model_receiver=`echo $smpc_config | jq -r .cs1_port_model_receiver`
+
+# Ports on which image provider  receiver listens/talks
+cs0_port_image_receiver=`echo $smpc_config | jq -r .cs0_port_image_receiver`
+cs1_port_image_receiver=`echo $smpc_config | jq -r .cs1_port_image_receiver`
+
+# Port on which final output talks to image provider 
+cs0_port_cs1_output_receiver=`echo $smpc_config | jq -r .cs0_port_cs1_output_receiver`
+
+
+# Stream the final output shares directly to the image provider's inference_result_receiver
+direct_output=`echo $smpc_config | jq -r '.direct_output // false'`
+output_receiver_options=""
+if [[ $direct_output == "true" ]];
+then
+output_receiver_options="--output-receiver-ip $reverse_ssh_host --output-receiver-port $cs0_port_cs1_output_receiver"
+fi
+
+# Ports on which server0 and server1 of the inferencing tasks talk to each other
+cs0_port_inference=`echo $smpc_config | jq -r .cs0_port_inference`
+cs1_port_inference=`echo $smpc_config | jq -r .cs1_port_inference`
+relu0_port_inference=`echo $smpc_config | jq -r .relu0_port_inference`
+relu1_port_inference=`echo $smpc_config | jq -r .relu1_port_inference`
+
+number_of_layers=`echo $smpc_config | jq -r .number_of_layers`
+fractional_bits=`echo $smpc_config | jq -r .fractional_bits`
+
+#number of splits
+# splits=`echo "$smpc_config" | jq -r .splits`
+
+# echo all input variables
+#echo "cs0_host $cs0_host"
+#echo "cs1_host $cs1_host"
+#echo "cs0_port_model_receiver $cs0_port_model_receiver"
+#echo "cs1_port_model_receiver $cs1_port_model_receiver"
+#echo "cs0_port_cs1_output_receiver $cs0_port_cs1_output_receiver"
+#echo "cs0_port_inference $cs0_port_inference"
+#echo "cs1_port_inference $cs1_port_inference"
+#echo "fractional bits: $fractional_bits"
+#echo "no. of splits: $splits"
+##########################################################################################################################################
+
+if [ ! -d "$debug_1" ];
+then
+	mkdir -p $debug_1
+fi
+
+cd $build_path
+
+
+if [ -f finaloutput_1 ]; then
+   rm finaloutput_1
+   # echo "final output 1 is removed"
+fi
+
+if [ -f MemoryDetails1 ]; then
+   rm MemoryDetails1
+   # echo "Memory Details1 are removed"
+fi
+
+if [ -f AverageMemoryDetails1 ]; then
+   rm AverageMemoryDetails1
+   # echo "Average Memory Details1 are removed"
+fi
+if [ -f AverageMemory1 ]; then
+   rm AverageMemory1
+   # echo "Average Memory Details1 are removed"
+fi
+
+if [ -f AverageTimeDetails1 ]; then
+   rm AverageTimeDetails1
+   # echo "AverageTimeDetails1 is removed"
+fi
+
+if [ -f AverageTime1 ]; then
+   rm AverageTime1
+   # echo "AverageTime1 is removed"
+fi
+
+#########################Weights Share Receiver ############################################################################################
+echo "Weight shares receiver starts"
+$build_path/bin/weight_share_receiver_genr --my-id 1 --port $cs1_port_model_receiver --current-path $build_path > $debug_1/Weights_Share_Receiver.txt &
+pid1=$!
+
+#########################Image Share Receiver ############################################################################################
+echo "Image shares receiver starts"
+$build_path/bin/Image_Share_Receiver --my-id 1 --port $cs1_port_image_receiver --fractional-bits $fractional_bits --file-names $image_config --current-path $build_path > $debug_1/Image_Share_Receiver.txt &
+pid2=$!
+
+wait $pid1
+check_exit_statuses $? 
+wait $pid2
+check_exit_statuses $?
+
+echo "Weight shares received"
+echo "Image shares received"
+#########################Share generators end ############################################################################################
+
+
+########################Inferencing task starts ###############################################################################################
+
+#  echo "image_ids X"$image_id > MemoryDetails1 
+echo "Inferencing task of the image shared starts"
+
+start=$(date +%s)
+
+####################################### Inference (all layers and argmax in one process) ##################################################
+$build_path/bin/inference_engine --my-id 1 --party 0,$cs0_host,$cs0_port_inference --party 1,$cs1_host,$cs1_port_inference --arithmetic-protocol beavy --boolean-protocol beavy --fractional-bits $fractional_bits --config-file-input remote_image_shares --config-file-model file_config_model1 --current-path $build_path $output_receiver_options > $debug_1/inference_engine1.txt &
+pid1=$!
+
+wait $pid1
+check_exit_statuses $?
+
+end=$(date +%s)
+
+echo "Inference of all $number_of_layers layers and argmax is done"
+
+####################################### Final output provider  ###########################################################################
+if [[ $direct_output != "true" ]];
+then
+   $build_path/bin/final_output_provider --my-id 1 --connection-ip $reverse_ssh_host --connection-port $cs0_port_cs1_output_receiver --config-input remote_image_shares --current-path $build_path > $debug_1/final_output_provider.txt &
+   pid4=$!
+   wait $pid4
+   check_exit_statuses $?  
+   echo "Output shares of server 1 sent to the Image provider"
+fi
+
+wait 
+
+awk '{ sum += $1 } END { print sum }' AverageTimeDetails1 >> AverageTime1
+
+sort -r -g AverageMemoryDetails1 | head  -1 >> AverageMemory1
+
+echo -e "\nInferencing Finished"
+
+Mem=`cat AverageMemory1`
+Time=`cat AverageTime1`
+
+Mem=$(printf "%.2f" $Mem) 
+Convert_KB_to_GB=$(printf "%.14f" 9.5367431640625E-7)
+Mem2=$(echo "$Convert_KB_to_GB * $Mem" | bc -l)
+
+Memory=$(printf "%.3f" $Mem2)
+
+echo "Memory requirement:" `printf "%.3f" $Memory` "GB"
+echo "Time taken by inferencing task:" $Time "ms"
+echo "Elapsed Time: $(($end-$start)) seconds"
+
+cd $scripts_path
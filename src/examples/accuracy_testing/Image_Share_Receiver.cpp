@@ -39,6 +39,7 @@
 #include "compute_server/compute_server.h"
 #include "utility/logger.h"
 #include "utility/fixed_point.h"
+#include "utility/share_file.h"
 
 namespace po = boost::program_options;
 
@@ -58,6 +59,8 @@ struct Options {
   std::vector<std::string> filepaths;
   std::string currentpath;
   int port;
+  bool binary_shares;
+  bool seed_compressed;
 };
 
 void read_filenames(Options& options) {
@@ -121,13 +124,27 @@ void generate_filepaths(Options& options) {
 
 void retrieve_shares(Options& options) {
   std::ofstream shares_file;
-  auto [frac_bits, shares_and_sizes] = COMPUTE_SERVER::get_provider_mat_mul_data(options.port);
+  auto [frac_bits, shares_and_sizes] =
+      COMPUTE_SERVER::get_provider_mat_mul_data(options.port, options.seed_compressed);
   std::vector<COMPUTE_SERVER::Shares> image_shares_all = shares_and_sizes.first;
   // options.image.row = shares_and_sizes.second[0];
   // options.image.col = shares_and_sizes.second[1];
   options.fractional_bits = frac_bits;
 
   auto temp = options.filepaths[1];
+  if (options.binary_shares) {
+    std::vector<std::uint64_t> Delta, delta;
+    Delta.reserve(image_shares_all.size());
+    delta.reserve(image_shares_all.size());
+    for (const auto& share : image_shares_all) {
+      Delta.push_back(share.Delta);
+      delta.push_back(share.delta);
+    }
+    MOTION::write_share_file(temp, shares_and_sizes.second[0], shares_and_sizes.second[1],
+                             frac_bits, Delta, delta);
+    std::cout << "Number of image share pairs received:" << image_shares_all.size() << "\n";
+    return;
+  }
   shares_file.open(temp, std::ios_base::out);
   if (!shares_file) {
     std::cerr << "Unable to create/open file "<<temp<<"\n";
@@ -179,6 +196,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("fractional-bits", po::value<std::size_t>()->default_value(16), "number of fractional bits for fixed-point arithmetic")
     ("file-names",po::value<std::string>()->required(), "filename")
     ("current-path",po::value<std::string>()->required(), "current path build_debwithrelinfo")
+    ("binary-shares", po::bool_switch()->default_value(false), "store the shares in the binary share file format")
+    ("seed-compressed", po::bool_switch()->default_value(false), "expect seed-compressed shares from the provider")
     ;
   // clang-format on
 
@@ -203,6 +222,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
   options.filenames = vm["file-names"].as<std::string>();
   options.currentpath = vm["current-path"].as<std::string>();
+  options.binary_shares = vm["binary-shares"].as<bool>();
+  options.seed_compressed = vm["seed-compressed"].as<bool>();
   // ----------------- Input Validation ----------------------------------------//
   if (options.my_id > 1) {
     std::cerr << "my-id must be 0 or 1\n";
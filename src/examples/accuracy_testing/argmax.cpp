@@ -28,7 +28,6 @@ beavy --boolean-protocol yao --repetitions 1 --config-filename file_config_input
 
 #include <algorithm>
 #include <cmath>
-#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <random>
@@ -41,9 +40,6 @@ beavy --boolean-protocol yao --repetitions 1 --config-filename file_config_input
 #include <boost/log/trivial.hpp>
 #include <boost/program_options.hpp>
 
-#include "algorithm/circuit_loader.h"
-#include "base/gate_factory.h"
-#include "base/two_party_backend.h"
 #include "communication/communication_layer.h"
 #include "communication/tcp_transport.h"
 #include "compute_server/compute_server.h"
@@ -55,6 +51,7 @@ beavy --boolean-protocol yao --repetitions 1 --config-filename file_config_input
 #include "tensor/tensor.h"
 #include "tensor/tensor_op.h"
 #include "tensor/tensor_op_factory.h"
+#include "utility/bit_vector.h"
 
 namespace po = boost::program_options;
 
@@ -274,7 +271,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("threads", po::value<std::size_t>()->default_value(0), "number of threads to use for gate evaluation")
     ("json", po::bool_switch()->default_value(false), "output data in JSON format")
     ("arithmetic-protocol", po::value<std::string>()->required(), "2PC protocol (GMW or BEAVY)")
-    ("boolean-protocol", po::value<std::string>()->required(), "2PC protocol (Yao, GMW or BEAVY)")
+    ("boolean-protocol", po::value<std::string>()->required(), "2PC protocol (Yao or BEAVY)")
     ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
     ("num-simd", po::value<std::size_t>()->default_value(1), "number of SIMD values")
      ("current-path",po::value<std::string>()->required(), "current path build_debwithrelinfo")
@@ -332,8 +329,6 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   boost::algorithm::to_lower(boolean_protocol);
   if (boolean_protocol == "yao") {
     options.boolean_protocol = MOTION::MPCProtocol::Yao;
-  } else if (boolean_protocol == "gmw") {
-    options.boolean_protocol = MOTION::MPCProtocol::BooleanGMW;
   } else if (boolean_protocol == "beavy") {
     options.boolean_protocol = MOTION::MPCProtocol::BooleanBEAVY;
   } else {
@@ -401,228 +396,64 @@ void print_stats(const Options& options,
   }
 }
 
-auto create_composite_circuit(const Options& options, MOTION::TwoPartyBackend& backend) {
-  auto& gate_factory_arith = backend.get_gate_factory(options.arithmetic_protocol);  // gmw
-  auto& gate_factory_bool = backend.get_gate_factory(options.boolean_protocol);      // beavy
-
-  // share the inputs using the arithmetic protocol
-  // NB: the inputs need to always be specified in the same order:
-  // here we first specify the input of party 0, then that of party 1
-
-  std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<uint64_t>>> input_1;
-  std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<uint64_t>>> promises_1;
-  // std::vector<std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<uint64_t>>>>input_final;
-  //  MOTION::WireVector input_0_arith, input_1_arith;
-  std::vector<MOTION::WireVector> input_bool, input_bool_1;
-  for (int i = 0; i < options.num_elements; i++) {
-    auto pair = gate_factory_arith.make_arithmetic_64_input_gate_shares(1);
-    auto promises = std::move(pair.first);
-    auto input_a_arith = std::move(pair.second);
-
-    auto Delta = std::move(promises[0]);
-    input_1.push_back(std::move(Delta));
-    auto delta = std::move(promises[1]);
-    input_1.push_back(std::move(delta));
-
-    auto temp1 = backend.convert(options.boolean_protocol, input_a_arith);
-    auto temp2 = backend.convert(options.boolean_protocol, input_a_arith);
-    input_bool.push_back(std::move(temp1));
-    input_bool_1.push_back(std::move(temp2));
+// argmax over the input shares in a single tensor graph, returns the boolean BEAVY shares of the
+// one-hot vector (1 for the maximum)
+auto create_composite_circuit(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
+  auto& arithmetic_tof = backend.get_tensor_op_factory(options.arithmetic_protocol);
+  auto& yao_tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::Yao);
+  auto& argmax_tof = backend.get_tensor_op_factory(options.boolean_protocol);
+  auto& beavy_tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::BooleanBEAVY);
+
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = options.num_elements, .width_ = 1};
+  auto [input_promises, input_tensor] = arithmetic_tof.make_arithmetic_64_tensor_input_shares(dims);
+
+  auto argmax_input = yao_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, input_tensor);
+  if (options.boolean_protocol != MOTION::MPCProtocol::Yao) {
+    argmax_input = yao_tof.make_tensor_conversion(options.boolean_protocol, argmax_input);
   }
-
-  MOTION::CircuitLoader circuit_loader, circuit_loader_1;
-  auto& gt_circuit =
-      circuit_loader.load_gt_circuit(64, options.boolean_protocol != MOTION::MPCProtocol::Yao);
-  auto& gtmux_circuit =
-      circuit_loader.load_gtmux_circuit(64, options.boolean_protocol != MOTION::MPCProtocol::Yao);
-
-  auto max = std::move(input_bool[0]);
-  // auto output_future = gate_factory_arith.make_arithmetic_64_output_gate_my(MOTION::ALL_PARTIES,
-  // max); auto output_bool_0 = gate_factory_bool.make_boolean_output_gate_my(MOTION::ALL_PARTIES,
-  // max);
-
-  auto n = input_bool.size();
-  for (int i = 1; i < n; ++i) {
-    auto intermediate_wire = std::move(input_bool[i]);
-    max = backend.make_circuit(gtmux_circuit, intermediate_wire, max);
-  }
-
-  std::vector<MOTION::WireVector> output_final;
-  int n1 = input_bool_1.size();
-  for (int j = 0; j < n1; ++j) {
-    auto temp_0 = std::move(input_bool_1[j]);
-    auto output1 = backend.make_circuit(gt_circuit, max, temp_0);
-    output_final.push_back(output1);
-  }
-
-  // const int k=26;
-  // auto temp1=backend.convert(options.arithmetic_protocol,max);
-  // auto output_future = gate_factory_arith.make_arithmetic_64_output_gate_my(MOTION::ALL_PARTIES,
-  // temp1);
-
-  int k = options.num_elements;
-
-  // std::array<ENCRYPTO::ReusableFiberFuture<MOTION::BitValues>, 26>* outputbool =
-  // new std::array<ENCRYPTO::ReusableFiberFuture<MOTION::BitValues>, 26>();
-  std::vector<size_t> gate_ids(10);
-  for (int i = 0; i < options.num_elements; i++) {
-    // (*outputbool)[i] =
-    //     gate_factory_bool.make_boolean_output_gate_my(MOTION::ALL_PARTIES, output_final[i]);
-    gate_ids[i] = gate_factory_bool.make_boolean_output_gate_my_wo_getting_output(
-        MOTION::ALL_PARTIES, output_final[i]);
-    // std::cout << gate_ids[i] << std::endl;
+  auto one_hot = argmax_tof.make_tensor_argmax_op(argmax_input);
+  if (options.boolean_protocol != MOTION::MPCProtocol::BooleanBEAVY) {
+    one_hot = argmax_tof.make_tensor_conversion(MOTION::MPCProtocol::BooleanBEAVY, one_hot);
   }
+  auto output_futures = beavy_tof.make_boolean_tensor_output_shares(one_hot);
 
-  return std::make_pair(gate_ids, std::move(input_1));
+  return std::make_pair(std::move(output_futures), std::move(input_promises));
 }
 
-// Reads the public and private share from each gate file and consolidates it to a single file to
-// share to the image provider.
-int consolidate_share_files(const Options& options, size_t num_outputs, size_t first_gate_number) {
-  std::string op = getenv("BASE_DIR");
-  std::ofstream outdata;
-
-  if (options.my_id == 0) {
-    op += "/build_debwithrelinfo_gcc/server0/Boolean_Output_Shares/Final_Boolean_Shares_server0_";
-    op += options.inputfilename;
-    op += ".txt";
-  } else {
-    op += "/build_debwithrelinfo_gcc/server1/Boolean_Output_Shares/Final_Boolean_Shares_server1_";
-    op += options.inputfilename;
-    op += ".txt";
+// Writes the shares of the one-hot vector to the file read by the image provider. Bit 0 of each
+// element carries the result, its public share is inverted to keep the encoding of the former
+// per-gate files (0 for the maximum, 1 otherwise).
+void write_final_shares(const Options& options, const std::vector<ENCRYPTO::BitVector<>>& Delta,
+                        const std::vector<ENCRYPTO::BitVector<>>& delta) {
+  const std::string server = "server" + std::to_string(options.my_id);
+  const std::string op = std::string(getenv("BASE_DIR")) + "/build_debwithrelinfo_gcc/" + server +
+                         "/Boolean_Output_Shares/Final_Boolean_Shares_" + server + "_" +
+                         options.inputfilename + ".txt";
+  std::ofstream outdata(op);
+  if (!outdata) {
+    throw std::runtime_error("could not create the final boolean share file " + op);
   }
-  outdata.open(op);
-  assert(outdata);
-  // outdata << options.my_id <<"\n";
-
-  // outdata << options.inputfilename << "\n";
 
+  const auto num_outputs = Delta.at(0).GetSize();
   outdata << num_outputs << "\n";
-
-  for (size_t i = 0; i < num_outputs; ++i) {
-    std::filesystem::__cxx11::path ip = getenv("BASE_DIR");
-    std::ifstream indata;
-
-    if (options.my_id == 0) {
-      ip += "/build_debwithrelinfo_gcc/server0/Boolean_Output_Shares/output_share_for_server0_gate";
-      ip += std::to_string(first_gate_number + i);
-      ip += ".txt";
-    } else {
-      // ip += "/server1/Boolean_Output_Shares/output_share_for_server1_gate";
-      ip += "/build_debwithrelinfo_gcc/server1/Boolean_Output_Shares/output_share_for_server1_gate";
-      ip += std::to_string(first_gate_number + i);
-      ip += ".txt";
-    }
-
-    try {
-      indata.open(ip);
-      if (indata) {
-        std::cout << "File found\n";
-      } else {
-        std::cout << "File not found\n";
-      }
-    } catch (std::ifstream::failure e) {
-      std::cerr << "Error while opening the boolean output share with gate file.\n";
-      return EXIT_FAILURE;
-    }
-
-    auto output_Delta = read_file(indata);
-    auto output_delta = read_file(indata);
-
-    // outdata << first_gate_number+i << " ";
-
-    // std::cout << output_Delta << " " << output_delta << "\n";
-
-    outdata << output_Delta << " " << output_delta << "\n";
-
-    remove(ip);
+  for (std::size_t i = 0; i < num_outputs; ++i) {
+    outdata << !Delta[0].Get(i) << " " << delta[0].Get(i) << "\n";
   }
-
-  outdata.close();
 }
 
-void run_composite_circuit(const Options& options, MOTION::TwoPartyBackend& backend) {
-  // auto [output_futures, input_promises] = create_composite_circuit(options, backend);
-  auto [gate_ids, input_promises] = create_composite_circuit(options, backend);
-  auto& gate_factory_bool = backend.get_gate_factory(options.boolean_protocol);
-  auto& gate_factory_arith = backend.get_gate_factory(options.arithmetic_protocol);
+void run_composite_circuit(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
+  auto [output_futures, input_promises] = create_composite_circuit(options, backend);
   if (options.no_run) {
     return;
   }
 
-  int j = 0;
-  for (int i = 0; i < options.num_elements; ++i) {
-    input_promises[j].set_value({options.input.Delta_T[i]});
-
-    input_promises[j + 1].set_value({options.input.delta_T[i]});
-
-    j += 2;
-  }
+  input_promises[0].set_value(options.input.Delta_T);
+  input_promises[1].set_value(options.input.delta_T);
 
-  // backend.run_wo_broadcast();
   backend.run();
 
-  std::sort(gate_ids.begin(), gate_ids.end());
-
-  // std::cout << gate_ids[0] << std::endl;
-
-  consolidate_share_files(options, gate_ids.size(), gate_ids[0]);
-
-  // execute the protocol
-  // int ans = 0;
-  // std::vector<bool> gt_result;
-  // for (int i = 0; i < options.num_elements; i++) {
-  //   auto temp = output_futures[i].get().at(0).Get(0);
-
-  //   if (temp == 0) {
-  //     ans = i;
-  //     break;
-  //   }
-  //   gt_result.push_back(temp);
-  // }
-
-  // std::string fn = options.inputfilename;
-  // delete [] output_futures;
-  // delete output_futures;
-  // auto bvs=output_futures.get();
-  // auto gt_result=bvs.at(0);
-  // auto mult_result = bvs.at(0);
-  // auto temp=bvs.at(0).Get(0);
-
-  // if (!options.json) {
-  //   // std::cout << "Input is " << options.x << " and output is " << ans;
-  //   if (options.x == ans && options.my_id == 1) {
-  //     /////// Read the counter number from counter file
-  //     // std::string path = std::filesystem::current_path();
-  //     std::string path = options.currentpath;
-  //     std::string t1 = path + "/" + "count";
-  //     std::ifstream file1;
-  //     file1.open(t1);
-  //     if (file1) {
-  //       std::cout << "File found\n";
-  //     } else {
-  //       std::cout << "File not found\n";
-  //     }
-  //     int counter;
-  //     file1 >> counter;
-
-  //     file1.close();
-
-  //     ///// Increment the number by 1 and rewrite it to the counter file.
-  //     std::ofstream file2;
-  //     file2.open(t1, std::ios_base::out);
-  //     counter = counter + 1;
-  //     file2 << counter;
-  //     file2.close();
-  //   } else if (options.x != ans) {
-  //     std::string path = options.currentpath;
-  //     // std::string path = std::filesystem::current_path();
-  //     std::string t1 = path + "/" + "nomatch";
-  //     std::ofstream file2;
-  //     file2.open(t1, std::ios_base::app);
-  //     file2 << options.inputfilename << "\n";
-  //   }
-  // }
+  write_final_shares(options, output_futures[0].get(), output_futures[1].get());
 }
 
 int main(int argc, char* argv[]) {
@@ -643,8 +474,8 @@ int main(int argc, char* argv[]) {
     comm_layer->set_logger(logger);
     MOTION::Statistics::AccumulatedRunTimeStats run_time_stats;
     MOTION::Statistics::AccumulatedCommunicationStats comm_stats;
-    MOTION::TwoPartyBackend backend(*comm_layer, options->threads,
-                                    options->sync_between_setup_and_online, logger);
+    MOTION::TwoPartyTensorBackend backend(*comm_layer, options->threads,
+                                          options->sync_between_setup_and_online, logger);
     run_composite_circuit(*options, backend);
     comm_layer->sync();
     comm_stats.add(comm_layer->get_transport_statistics());
@@ -37,6 +37,7 @@
 #include <boost/program_options.hpp>
 
 #include "utility/logger.h"
+#include "utility/share_file.h"
 
 #define MAX_CONNECT_RETRIES 50
 // #include "communication/communication_layer.h"
@@ -229,11 +230,19 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
   // Reading contents from file
-  Shares shares_data[10]; //hardcoded
+  std::vector<Shares> shares_data;
   int i, number_of_elements;
   std::ifstream output_shares_file;
-  
-  try{
+
+  if (MOTION::is_binary_share_file(options->fullfilepath)) {
+    const MOTION::MappedShareFile output_shares(options->fullfilepath);
+    number_of_elements = output_shares.get_rows() * output_shares.get_cols();
+    shares_data.resize(number_of_elements);
+    for (i = 0; i < number_of_elements; i++) {
+      shares_data[i].Delta = output_shares.get_Delta()[i];
+      shares_data[i].delta = output_shares.get_delta()[i];
+    }
+  } else try{
     output_shares_file.open(options->fullfilepath);
     if (!output_shares_file)
       {
@@ -243,6 +252,7 @@ int main(int argc, char* argv[]) {
     
     std::string line;
     output_shares_file >> number_of_elements;
+    shares_data.resize(number_of_elements);
     for (i = 0; i < number_of_elements; i++) {
       output_shares_file >> shares_data[i].Delta;
       output_shares_file >> shares_data[i].delta;
@@ -278,7 +288,7 @@ int main(int argc, char* argv[]) {
   //----------------Send data---------------------------//
   std::cout<<"Sending the final output shares.\n";
   try{
-    write_struct(socket, shares_data, number_of_elements);
+    write_struct(socket, shares_data.data(), number_of_elements);
   }
   catch(std::exception& e)
       {
@@ -0,0 +1,952 @@
+/*
+Runs the complete inference of a fully connected network in a single process. All layers
+(GEMM -> add bias -> ReLU -> ... -> GEMM -> add bias) are built as one tensor graph and evaluated in
+a single TwoPartyTensorBackend session, so the connection setup and the preprocessing (base OTs,
+OT extension) are paid once per image instead of once per layer. The argmax over the output of the
+last layer is part of the same graph (a pairwise tournament of logarithmic depth in the boolean
+protocol), its boolean shares are collected in memory and written to
+server{0,1}/Boolean_Output_Shares/Final_Boolean_Shares_server{0,1}_<config-file-input>.txt as
+expected by final_output_provider: one bit per class, which is 0 only for the predicted class.
+With --output-receiver-port, the shares are instead streamed to the image provider's
+inference_result_receiver as one framed message per request (the layout of a binary share file),
+over a connection that is established once and kept for all requests.
+
+An image share file (or image request) with B columns is a batch of B images: all of them are
+evaluated in one circuit, i.e., one setup phase and one set of communication rounds per batch, and
+the final shares hold one column of class bits per image. Bias shares with a single column are
+added to every image. Batches need --output-receiver-port: the final share files and the
+final_output_provider -> output_shares_receiver -> Reconstruct chain hold the result of one image.
+
+The model config (file_config_model0/1, written by weight_share_receiver_genr) lists the weight and
+bias share files of every layer on consecutive lines.
+
+With --image-port the engine stays resident: the model shares are parsed once and every image that
+the image provider sends to this port is evaluated against them on the same connection, reusing the
+base OTs of the previous request. With --model-port, a new model version can be pushed by the
+weights provider at any time. Before every request, the servers exchange digests of the public
+shares of the models they hold and switch to the newest model held by both, so a request is never
+evaluated with different models, even if an upload failed on one server only.
+With --dealer, the GEMM triples are dealt by the helper node (server2 --dealer-port) instead of
+being generated with OTs; the connection to the dealer is kept for all requests.
+With --seed-compressed, the providers send a PRG seed and the public Delta values instead of
+(Delta, delta) pairs; the providers must be started with --seed-compressed as well.
+The ReLUs use the Yao chain by default. With --relu sign, they extract the sign bit in Boolean
+BEAVY instead: less communication, but 8 online rounds per ReLU instead of about 3, so it only pays
+off on low-latency links.
+
+Server-0
+./bin/inference_engine --my-id 0 --party 0,::1,7002 --party 1,::1,7000 --arithmetic-protocol beavy
+--boolean-protocol beavy --fractional-bits 13 --config-file-input remote_image_shares
+--config-file-model file_config_model0 --current-path ${BASE_DIR}/build_debwithrelinfo_gcc
+
+Server-1
+./bin/inference_engine --my-id 1 --party 0,::1,7002 --party 1,::1,7000 --arithmetic-protocol beavy
+--boolean-protocol beavy --fractional-bits 13 --config-file-input remote_image_shares
+--config-file-model file_config_model1 --current-path ${BASE_DIR}/build_debwithrelinfo_gcc
+*/
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/program_options.hpp>
+#include <fmt/format.h>
+
+#include "communication/communication_layer.h"
+#include "communication/message.h"
+#include "communication/message_handler.h"
+#include "communication/tcp_transport.h"
+#include "compute_server/compute_server.h"
+#include "crypto/base_ots/base_ot_provider.h"
+#include "crypto/multiplication_triple/linalg_triple_provider.h"
+#include "statistics/analysis.h"
+#include "utility/logger.h"
+#include "utility/share_file.h"
+
+#include "base/two_party_tensor_backend.h"
+#include "protocols/beavy/tensor.h"
+#include "tensor/output_sink.h"
+#include "tensor/tensor.h"
+#include "tensor/tensor_op.h"
+#include "tensor/tensor_op_factory.h"
+#include "utility/bit_vector.h"
+
+namespace po = boost::program_options;
+
+struct Matrix {
+  std::vector<std::uint64_t> Delta;
+  std::vector<std::uint64_t> delta;
+  std::size_t row;
+  std::size_t col;
+};
+
+struct Layer {
+  Matrix W;
+  Matrix B;
+};
+
+struct Options {
+  std::size_t threads;
+  bool json;
+  std::size_t num_simd;
+  bool sync_between_setup_and_online;
+  MOTION::MPCProtocol arithmetic_protocol;
+  MOTION::MPCProtocol boolean_protocol;
+  // ReLU via the BEAVY sign extraction instead of the Yao chain
+  bool sign_relu;
+  std::size_t fractional_bits;
+  std::size_t gemm_tile_rows;
+  std::string base_ot_state;
+  bool binary_shares;
+  std::string imageprovider;
+  std::string modelpath;
+  std::string currentpath;
+  std::size_t my_id;
+  MOTION::Communication::tcp_parties_config tcp_config;
+  bool no_run = false;
+  int image_port = 0;
+  int model_port = 0;
+  std::size_t num_requests;
+  bool seed_compressed;
+  std::string output_receiver_ip;
+  int output_receiver_port = 0;
+  std::optional<MOTION::Communication::tcp_connection_config> dealer;
+  Matrix image_file;
+  std::vector<Layer> layers;
+};
+
+// FNV-1a over the dimensions and the public shares of all layers: Delta is the same on both
+// servers, so equal digests identify the same model independently of when a server received it
+std::uint64_t model_digest(const std::vector<Layer>& layers) {
+  std::uint64_t digest = 0xcbf29ce484222325;
+  const auto add = [&digest](std::uint64_t value) {
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+      digest ^= (value >> (8 * i)) & 0xff;
+      digest *= 0x100000001b3;
+    }
+  };
+  for (const auto& layer : layers) {
+    for (const auto* matrix : {&layer.W, &layer.B}) {
+      add(matrix->row);
+      add(matrix->col);
+      std::for_each(std::begin(matrix->Delta), std::end(matrix->Delta), add);
+    }
+  }
+  return digest;
+}
+
+struct ModelVersion {
+  std::uint64_t digest;
+  std::vector<Layer> layers;
+};
+
+// models pushed by the weights provider while serving, numbered in the order this server received
+// them (version 0 is the model of the config file). The numbers are local, a failed upload shifts
+// them on one server only, so the servers agree on a model by its digest.
+struct PendingModels {
+  std::mutex mutex;
+  std::map<std::size_t, ModelVersion> models;
+  std::size_t latest_version = 0;
+  std::atomic<bool> stop = false;
+};
+
+// receives the digests of the models the other server holds
+class ModelVersionHandler : public MOTION::Communication::MessageHandler {
+ public:
+  void received_message(std::size_t, std::vector<std::uint8_t>&& raw_message) override {
+    const auto message = MOTION::Communication::GetMessage(raw_message.data());
+    const auto payload = message->payload();
+    std::optional<std::vector<std::uint64_t>> digests;
+    if (payload != nullptr && payload->size() > 0 && payload->size() % sizeof(std::uint64_t) == 0) {
+      digests.emplace(payload->size() / sizeof(std::uint64_t));
+      std::memcpy(digests->data(), payload->data(), payload->size());
+    }
+    {
+      std::scoped_lock lock(mutex_);
+      digests_.push_back(std::move(digests));
+    }
+    cv_.notify_all();
+  }
+
+  std::vector<std::uint64_t> wait_digests() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return !digests_.empty(); });
+    auto digests = std::move(digests_.front());
+    digests_.pop_front();
+    if (!digests.has_value()) {
+      throw std::runtime_error("received a malformed list of model digests");
+    }
+    return std::move(*digests);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::optional<std::vector<std::uint64_t>>> digests_;
+};
+
+void testMemoryOccupied(int WriteToFiles, int my_id, std::string path) {
+  int tSize = 0, resident = 0, share = 0;
+  std::ifstream buffer("/proc/self/statm");
+  buffer >> tSize >> resident >> share;
+  buffer.close();
+
+  long page_size_kb =
+      sysconf(_SC_PAGE_SIZE) / 1024;  // in case x86-64 is configured to use 2MB pages
+  double rss = resident * page_size_kb;
+  std::cout << "RSS - " << rss << " kB\n";
+  double shared_mem = share * page_size_kb;
+  std::cout << "Shared Memory - " << shared_mem << " kB\n";
+  std::cout << "Private Memory - " << rss - shared_mem << "kB\n";
+  std::cout << std::endl;
+  if (WriteToFiles == 1) {
+    /////// Generate path for the AverageMemoryDetails file and MemoryDetails file
+    std::string t1 = path + "/" + "AverageMemoryDetails" + std::to_string(my_id);
+    std::string t2 = path + "/" + "MemoryDetails" + std::to_string(my_id);
+
+    ///// Write to the AverageMemoryDetails files
+    std::ofstream file1;
+    file1.open(t1, std::ios_base::app);
+    file1 << rss;
+    file1 << "\n";
+    file1.close();
+
+    std::ofstream file2;
+    file2.open(t2, std::ios_base::app);
+    file2 << "Inference engine : \n";
+    file2 << "RSS - " << rss << " kB\n";
+    file2 << "Shared Memory - " << shared_mem << " kB\n";
+    file2 << "Private Memory - " << rss - shared_mem << "kB\n";
+    file2.close();
+  }
+}
+
+// reads a share file consisting of a "rows cols" header followed by one "Delta delta" line per
+// element
+void read_shares(const std::string& path, Matrix& matrix) {
+  if (MOTION::is_binary_share_file(path)) {
+    const MOTION::MappedShareFile shares(path);
+    matrix.row = shares.get_rows();
+    matrix.col = shares.get_cols();
+    matrix.Delta = shares.copy_Delta(0, matrix.row);
+    matrix.delta = shares.copy_delta(0, matrix.row);
+    return;
+  }
+  std::ifstream indata(path);
+  if (!indata) {
+    throw std::runtime_error("could not open share file " + path);
+  }
+  if (!(indata >> matrix.row >> matrix.col)) {
+    throw std::runtime_error("could not read the dimensions from share file " + path);
+  }
+  const auto num_elements = matrix.row * matrix.col;
+  matrix.Delta.resize(num_elements);
+  matrix.delta.resize(num_elements);
+  for (std::size_t i = 0; i < num_elements; ++i) {
+    if (!(indata >> matrix.Delta[i] >> matrix.delta[i])) {
+      throw std::runtime_error("share file " + path + " contains fewer elements than expected");
+    }
+  }
+}
+
+void check_dimensions(const Options& options) {
+  // check that the layers can be chained, a bias with a single column is added to every image of
+  // the batch
+  std::size_t input_rows = options.image_file.row;
+  for (std::size_t i = 0; i < options.layers.size(); ++i) {
+    const auto& layer = options.layers[i];
+    if (layer.W.col != input_rows || layer.B.row != layer.W.row ||
+        (layer.B.col != 1 && layer.B.col != options.image_file.col)) {
+      throw std::runtime_error(fmt::format("dimension mismatch in layer {}", i + 1));
+    }
+    input_rows = layer.W.row;
+  }
+  if (options.image_file.col > 1 && options.output_receiver_port == 0) {
+    throw std::runtime_error(fmt::format(
+        "a batch of {} images needs --output-receiver-port, the final share files hold one image",
+        options.image_file.col));
+  }
+}
+
+void file_read(Options* options) {
+  const std::string path = options->currentpath;
+
+  // the model config lists the weight and bias share files of each layer on consecutive lines
+  std::ifstream model_config(path + "/" + options->modelpath);
+  if (!model_config) {
+    throw std::runtime_error("could not open model config " + path + "/" + options->modelpath);
+  }
+  std::vector<std::string> share_files;
+  for (std::string line; std::getline(model_config, line);) {
+    boost::algorithm::trim(line);
+    if (!line.empty()) {
+      share_files.push_back(line);
+    }
+  }
+  if (share_files.empty() || share_files.size() % 2 != 0) {
+    throw std::runtime_error("model config must list a weight and a bias file for every layer");
+  }
+
+  options->layers.resize(share_files.size() / 2);
+  for (std::size_t i = 0; i < options->layers.size(); ++i) {
+    read_shares(share_files[2 * i], options->layers[i].W);
+    read_shares(share_files[2 * i + 1], options->layers[i].B);
+  }
+
+  // when serving, the images arrive over the network
+  if (options->image_port == 0) {
+    read_shares(path + "/server" + std::to_string(options->my_id) + "/Image_shares/" +
+                    options->imageprovider,
+                options->image_file);
+    check_dimensions(*options);
+  }
+}
+
+Matrix to_matrix(const std::vector<COMPUTE_SERVER::Shares>& shares, std::size_t row,
+                 std::size_t col) {
+  if (shares.size() != row * col) {
+    throw std::runtime_error(
+        fmt::format("received {} shares for a {}x{} matrix", shares.size(), row, col));
+  }
+  Matrix matrix{.row = row, .col = col};
+  matrix.Delta.reserve(shares.size());
+  matrix.delta.reserve(shares.size());
+  for (const auto& share : shares) {
+    matrix.Delta.push_back(share.Delta);
+    matrix.delta.push_back(share.delta);
+  }
+  return matrix;
+}
+
+// receives model versions from the weights provider until the stop flag is set, the shared state
+// outlives serve_requests since the thread may still wait for a connection
+void receive_models(int port, bool seed_compressed, std::size_t fractional_bits,
+                    std::shared_ptr<PendingModels> pending_models) {
+  while (!pending_models->stop) {
+    try {
+      auto [num_layers, frac_bits, data_and_dims] =
+          COMPUTE_SERVER::get_provider_total_data_genr(port, seed_compressed);
+      auto& [shares, dims] = data_and_dims;
+      if (num_layers < 1 || shares.size() != 2 * static_cast<std::size_t>(num_layers)) {
+        throw std::runtime_error("received an incomplete model");
+      }
+      if (frac_bits != fractional_bits) {
+        throw std::runtime_error(fmt::format("model uses {} fractional bits, expected {}",
+                                             frac_bits, fractional_bits));
+      }
+      std::vector<Layer> layers(num_layers);
+      for (std::size_t i = 0; i < layers.size(); ++i) {
+        layers[i].W = to_matrix(shares[2 * i], dims[2 * i].first, dims[2 * i].second);
+        layers[i].B = to_matrix(shares[2 * i + 1], dims[2 * i + 1].first, dims[2 * i + 1].second);
+      }
+      const auto digest = model_digest(layers);
+      std::scoped_lock lock(pending_models->mutex);
+      const auto version = ++pending_models->latest_version;
+      pending_models->models.emplace(version, ModelVersion{digest, std::move(layers)});
+      std::cout << fmt::format("Received model version {} ({:016x}) with {} layers\n", version,
+                               digest, num_layers);
+    } catch (std::exception& e) {
+      std::cerr << "error while receiving a model: " << e.what() << "\n";
+    }
+  }
+}
+
+std::optional<Options> parse_program_options(int argc, char* argv[]) {
+  Options options;
+  boost::program_options::options_description desc("Allowed options");
+  // clang-format off
+  desc.add_options()
+    ("help,h", po::bool_switch()->default_value(false),"produce help message")
+    ("config-file-input", po::value<std::string>()->required(), "name of the image share file")
+    ("config-file-model", po::value<std::string>()->required(), "config file listing the model shares")
+    ("my-id", po::value<std::size_t>()->required(), "my party id")
+    ("party", po::value<std::vector<std::string>>()->multitoken(),
+     "(party id, IP, port), e.g., --party 1,127.0.0.1,7777")
+    ("threads", po::value<std::size_t>()->default_value(0), "number of threads to use for gate evaluation")
+    ("json", po::bool_switch()->default_value(false), "output data in JSON format")
+    ("fractional-bits", po::value<std::size_t>()->default_value(16),
+     "number of fractional bits for fixed-point arithmetic")
+    ("gemm-tile-rows", po::value<std::size_t>()->default_value(0),
+     "number of output rows each GEMM processes at once (0 = all rows), bounds the setup buffers "
+     "of the triples but not their OT extension")
+    ("binary-shares", po::bool_switch()->default_value(false),
+     "write the final shares in the binary share file format")
+    ("base-ot-state", po::value<std::string>()->default_value(""),
+     "file to load base OTs from if it exists, they are stored to it before every OT extension; "
+     "both servers must use files of the same session (empty = compute fresh base OTs)")
+    ("arithmetic-protocol", po::value<std::string>()->required(), "2PC protocol of the layers, only BEAVY is supported: the shares are read and "
+     "written as BEAVY (Delta, delta) pairs")
+    ("boolean-protocol", po::value<std::string>()->required(), "2PC protocol used for the argmax (Yao or BEAVY)")
+    ("relu", po::value<std::string>()->default_value("yao"),
+     "ReLU of the arithmetic shares: yao (negate, conversion to Yao, garbled ReLU, conversion back: "
+     "about 3 online rounds, but garbled tables) or sign (BEAVY only: sign bit extracted in Boolean "
+     "BEAVY, less communication, but 8 online rounds)")
+    ("num-simd", po::value<std::size_t>()->default_value(1), "number of SIMD values")
+    ("current-path",po::value<std::string>()->required(), "current path build_debwithrelinfo")
+    ("sync-between-setup-and-online", po::bool_switch()->default_value(false),
+     "run a synchronization protocol before the online phase starts")
+    ("no-run", po::bool_switch()->default_value(false), "just build the circuit, but not execute it")
+    ("image-port", po::value<int>()->default_value(0),
+     "serve inference requests: receive image shares on this port (0 = evaluate config-file-input once)")
+    ("model-port", po::value<int>()->default_value(0),
+     "while serving, receive new model versions on this port (0 = keep the initial model)")
+    ("num-requests", po::value<std::size_t>()->default_value(0),
+     "while serving, stop after this many requests (0 = serve forever)")
+    ("seed-compressed", po::bool_switch()->default_value(false),
+     "while serving, expect seed-compressed shares from the image and weights providers")
+    ("output-receiver-ip", po::value<std::string>()->default_value("127.0.0.1"),
+     "IP of the image provider's inference result receiver")
+    ("output-receiver-port", po::value<int>()->default_value(0),
+     "send the final shares to the inference result receiver on this port (0 = write them to a file)")
+    ("dealer", po::value<std::string>(),
+     "(IP, port) of the helper node's triple dealer, party i connects to port + i, e.g., "
+     "--dealer 127.0.0.1,7010 (default: generate the triples with OTs)")
+    ;
+  // clang-format on
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  bool help = vm["help"].as<bool>();
+  if (help) {
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+  try {
+    po::notify(vm);
+  } catch (std::exception& e) {
+    std::cerr << "error:" << e.what() << "\n\n";
+    std::cerr << desc << "\n";
+    return std::nullopt;
+  }
+
+  options.my_id = vm["my-id"].as<std::size_t>();
+  options.threads = vm["threads"].as<std::size_t>();
+  options.json = vm["json"].as<bool>();
+  options.num_simd = vm["num-simd"].as<std::size_t>();
+  options.sync_between_setup_and_online = vm["sync-between-setup-and-online"].as<bool>();
+  options.no_run = vm["no-run"].as<bool>();
+  options.currentpath = vm["current-path"].as<std::string>();
+  options.imageprovider = vm["config-file-input"].as<std::string>();
+  options.modelpath = vm["config-file-model"].as<std::string>();
+  options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
+  options.gemm_tile_rows = vm["gemm-tile-rows"].as<std::size_t>();
+  options.base_ot_state = vm["base-ot-state"].as<std::string>();
+  options.binary_shares = vm["binary-shares"].as<bool>();
+  options.image_port = vm["image-port"].as<int>();
+  options.model_port = vm["model-port"].as<int>();
+  options.num_requests = vm["num-requests"].as<std::size_t>();
+  options.seed_compressed = vm["seed-compressed"].as<bool>();
+  options.output_receiver_ip = vm["output-receiver-ip"].as<std::string>();
+  options.output_receiver_port = vm["output-receiver-port"].as<int>();
+  if (options.my_id > 1) {
+    std::cerr << "my-id must be one of 0 and 1\n";
+    return std::nullopt;
+  }
+
+  auto arithmetic_protocol = vm["arithmetic-protocol"].as<std::string>();
+  boost::algorithm::to_lower(arithmetic_protocol);
+  if (arithmetic_protocol == "gmw") {
+    std::cerr << "GMW is not supported: the image and model shares are BEAVY shares\n";
+    return std::nullopt;
+  } else if (arithmetic_protocol == "beavy") {
+    options.arithmetic_protocol = MOTION::MPCProtocol::ArithmeticBEAVY;
+  } else {
+    std::cerr << "invalid protocol: " << arithmetic_protocol << "\n";
+    return std::nullopt;
+  }
+  auto boolean_protocol = vm["boolean-protocol"].as<std::string>();
+  boost::algorithm::to_lower(boolean_protocol);
+  if (boolean_protocol == "yao") {
+    options.boolean_protocol = MOTION::MPCProtocol::Yao;
+  } else if (boolean_protocol == "beavy") {
+    options.boolean_protocol = MOTION::MPCProtocol::BooleanBEAVY;
+  } else {
+    std::cerr << "invalid protocol: " << boolean_protocol << "\n";
+    return std::nullopt;
+  }
+  auto relu = vm["relu"].as<std::string>();
+  boost::algorithm::to_lower(relu);
+  if (relu == "yao") {
+    options.sign_relu = false;
+  } else if (relu == "sign") {
+    if (options.arithmetic_protocol != MOTION::MPCProtocol::ArithmeticBEAVY) {
+      std::cerr << "--relu sign needs BEAVY as the arithmetic protocol\n";
+      return std::nullopt;
+    }
+    options.sign_relu = true;
+  } else {
+    std::cerr << "invalid ReLU: " << relu << "\n";
+    return std::nullopt;
+  }
+
+  try {
+    file_read(&options);
+  } catch (std::runtime_error& e) {
+    std::cerr << "error while reading the shares: " << e.what() << "\n";
+    return std::nullopt;
+  }
+
+  const auto parse_party_argument =
+      [](const auto& s) -> std::pair<std::size_t, MOTION::Communication::tcp_connection_config> {
+    const static std::regex party_argument_re("([01]),([^,]+),(\\d{1,5})");
+    std::smatch match;
+    if (!std::regex_match(s, match, party_argument_re)) {
+      throw std::invalid_argument("invalid party argument");
+    }
+    auto id = boost::lexical_cast<std::size_t>(match[1]);
+    auto host = match[2];
+    auto port = boost::lexical_cast<std::uint16_t>(match[3]);
+    return {id, {host, port}};
+  };
+
+  const std::vector<std::string> party_infos = vm["party"].as<std::vector<std::string>>();
+  if (party_infos.size() != 2) {
+    std::cerr << "expecting two --party options\n";
+    return std::nullopt;
+  }
+
+  options.tcp_config.resize(2);
+
+  const auto [id0, conn_info0] = parse_party_argument(party_infos[0]);
+  const auto [id1, conn_info1] = parse_party_argument(party_infos[1]);
+  if (id0 == id1) {
+    std::cerr << "need party arguments for party 0 and 1\n";
+    return std::nullopt;
+  }
+  options.tcp_config[id0] = conn_info0;
+  options.tcp_config[id1] = conn_info1;
+
+  if (vm.count("dealer")) {
+    const static std::regex dealer_argument_re("([^,]+),(\\d{1,5})");
+    std::smatch match;
+    const auto dealer_info = vm["dealer"].as<std::string>();
+    if (!std::regex_match(dealer_info, match, dealer_argument_re)) {
+      std::cerr << "invalid dealer argument: " << dealer_info << "\n";
+      return std::nullopt;
+    }
+    options.dealer = {match[1], boost::lexical_cast<std::uint16_t>(match[2])};
+  }
+
+  return options;
+}
+
+std::unique_ptr<MOTION::Communication::CommunicationLayer> setup_communication(
+    const Options& options) {
+  MOTION::Communication::TCPSetupHelper helper(options.my_id, options.tcp_config);
+  return std::make_unique<MOTION::Communication::CommunicationLayer>(options.my_id,
+                                                                     helper.setup_connections());
+}
+
+// connects to the triple dealer of the helper node, which accepts party i on its port + i
+std::unique_ptr<MOTION::Communication::Transport> connect_to_dealer(const Options& options) {
+  const auto& [host, port] = *options.dealer;
+  // the dealer is party 0 of this connection, this party only connects
+  MOTION::Communication::TCPSetupHelper helper(
+      1, {{host, static_cast<std::uint16_t>(port + options.my_id)}, {"0.0.0.0", 0}});
+  return std::move(helper.setup_connections().at(0));
+}
+
+void print_stats(const Options& options,
+                 const MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
+                 const MOTION::Statistics::AccumulatedCommunicationStats& comm_stats) {
+  if (options.json) {
+    auto obj = MOTION::Statistics::to_json("inference_engine", run_time_stats, comm_stats);
+    obj.emplace("party_id", options.my_id);
+    obj.emplace("arithmetic_protocol", MOTION::ToString(options.arithmetic_protocol));
+    obj.emplace("boolean_protocol", MOTION::ToString(options.boolean_protocol));
+    obj.emplace("sign_relu", options.sign_relu);
+    obj.emplace("simd", options.num_simd);
+    obj.emplace("threads", options.threads);
+    obj.emplace("gemm_tile_rows", options.gemm_tile_rows);
+    obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
+    std::cout << obj << "\n";
+  } else {
+    std::cout << MOTION::Statistics::print_stats("inference_engine", run_time_stats, comm_stats);
+  }
+}
+
+// repeats every element of a column vector num_cols times, replicating the shares of a value is a
+// valid sharing of the replicated values
+Matrix broadcast_columns(const Matrix& vector, std::size_t num_cols) {
+  if (vector.col == num_cols) {
+    return vector;
+  }
+  assert(vector.col == 1);
+  Matrix matrix{.row = vector.row, .col = num_cols};
+  matrix.Delta.reserve(vector.row * num_cols);
+  matrix.delta.reserve(vector.row * num_cols);
+  for (std::size_t i = 0; i < vector.row; ++i) {
+    matrix.Delta.insert(std::end(matrix.Delta), num_cols, vector.Delta[i]);
+    matrix.delta.insert(std::end(matrix.delta), num_cols, vector.delta[i]);
+  }
+  return matrix;
+}
+
+MOTION::tensor::TensorCP make_input_tensor(MOTION::tensor::TensorOpFactory& arithmetic_tof,
+                                           const MOTION::tensor::TensorDimensions& dims,
+                                           const Matrix& matrix) {
+  auto [promises, tensor] = arithmetic_tof.make_arithmetic_64_tensor_input_shares(dims);
+  promises[0].set_value(matrix.Delta);
+  promises[1].set_value(matrix.delta);
+  return tensor;
+}
+
+// builds the whole network: every layer computes W * X + B, all but the last layer are followed by
+// a ReLU
+// the columns of X are the images of the batch, so every GEMM is a matrix-matrix product and all
+// images share the setup phase and the communication rounds of the circuit
+auto create_network(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
+  auto& arithmetic_tof = backend.get_tensor_op_factory(options.arithmetic_protocol);
+  auto& boolean_tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::Yao);
+
+  const auto make_activation = [&](const auto& input) -> MOTION::tensor::TensorCP {
+    // BEAVY can compute the ReLU of arithmetic tensors directly, which trades the garbled tables of
+    // the Yao chain for more online rounds
+    if (options.sign_relu) {
+      return arithmetic_tof.make_tensor_relu_op(input);
+    }
+    const auto negated_tensor = arithmetic_tof.make_tensor_negate(input);
+    const auto boolean_tensor =
+        boolean_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, negated_tensor);
+    const auto relu_tensor = boolean_tof.make_tensor_relu_op(boolean_tensor);
+    const auto finBoolean_tensor =
+        boolean_tof.make_tensor_conversion(options.arithmetic_protocol, relu_tensor);
+    return arithmetic_tof.make_tensor_negate(finBoolean_tensor);
+  };
+
+  std::array<std::size_t, 2> input_shape = {options.image_file.row, options.image_file.col};
+  MOTION::tensor::TensorCP layer_input =
+      make_input_tensor(arithmetic_tof,
+                        {.batch_size_ = 1,
+                         .num_channels_ = 1,
+                         .height_ = input_shape[0],
+                         .width_ = input_shape[1]},
+                        options.image_file);
+
+  for (std::size_t i = 0; i < options.layers.size(); ++i) {
+    const auto& layer = options.layers[i];
+    const MOTION::tensor::GemmOp gemm_op = {.input_A_shape_ = {layer.W.row, layer.W.col},
+                                            .input_B_shape_ = input_shape,
+                                            .output_shape_ = {layer.W.row, input_shape[1]},
+                                            .tile_rows_ = options.gemm_tile_rows};
+
+    const auto tensor_W =
+        make_input_tensor(arithmetic_tof, gemm_op.get_input_A_tensor_dims(), layer.W);
+    const auto tensor_B = make_input_tensor(arithmetic_tof, gemm_op.get_output_tensor_dims(),
+                                            broadcast_columns(layer.B, input_shape[1]));
+
+    // with BEAVY, the bias is added in the epilogue of the GEMM gate
+    layer_input = arithmetic_tof.make_tensor_gemm_op(gemm_op, tensor_W, layer_input, tensor_B,
+                                                     options.fractional_bits);
+    if (i + 1 < options.layers.size()) {
+      layer_input = make_activation(layer_input);
+    }
+    input_shape = gemm_op.output_shape_;
+  }
+
+  // argmax over each column of the output of the last layer, i.e., one per image, its boolean
+  // BEAVY shares are handed over in memory
+  auto argmax_input = boolean_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, layer_input);
+  if (options.boolean_protocol != MOTION::MPCProtocol::Yao) {
+    argmax_input = boolean_tof.make_tensor_conversion(options.boolean_protocol, argmax_input);
+  }
+  auto& argmax_tof = backend.get_tensor_op_factory(options.boolean_protocol);
+  auto one_hot = argmax_tof.make_tensor_argmax_op(argmax_input);
+  if (options.boolean_protocol != MOTION::MPCProtocol::BooleanBEAVY) {
+    one_hot = argmax_tof.make_tensor_conversion(MOTION::MPCProtocol::BooleanBEAVY, one_hot);
+  }
+  auto& beavy_tof = backend.get_tensor_op_factory(MOTION::MPCProtocol::BooleanBEAVY);
+  return beavy_tof.make_boolean_tensor_output_shares(one_hot);
+}
+
+// (Delta, delta) of the final shares, one bit per class and image (a classes x images matrix): only
+// bit 0 of the one-hot elements can be set, inverting its public share gives the encoding expected
+// by the image provider (0 for the predicted class, 1 otherwise)
+struct FinalShares {
+  std::vector<std::uint64_t> Delta;
+  std::vector<std::uint64_t> delta;
+  std::size_t num_images;
+};
+
+FinalShares make_final_shares(const std::vector<ENCRYPTO::BitVector<>>& one_hot_Delta,
+                              const std::vector<ENCRYPTO::BitVector<>>& one_hot_delta,
+                              std::size_t num_images) {
+  const auto num_outputs = one_hot_Delta.at(0).GetSize();
+  FinalShares shares{std::vector<std::uint64_t>(num_outputs),
+                     std::vector<std::uint64_t>(num_outputs), num_images};
+  for (std::size_t i = 0; i < num_outputs; ++i) {
+    shares.Delta[i] = !one_hot_Delta[0].Get(i);
+    shares.delta[i] = one_hot_delta[0].Get(i);
+  }
+  return shares;
+}
+
+// writes the final shares of a single image into the file read by final_output_provider
+void write_final_shares(const Options& options, const FinalShares& shares) {
+  if (shares.num_images != 1) {
+    throw std::logic_error("write_final_shares: the final share files hold one image");
+  }
+  const std::string dir = options.currentpath + "/server" + std::to_string(options.my_id) +
+                          "/Boolean_Output_Shares/";
+  const std::string server = "server" + std::to_string(options.my_id);
+  const auto num_outputs = shares.Delta.size();
+
+  const std::string op =
+      dir + "Final_Boolean_Shares_" + server + "_" + options.imageprovider + ".txt";
+  if (options.binary_shares) {
+    MOTION::write_share_file(op, num_outputs, 1, options.fractional_bits, shares.Delta,
+                             shares.delta);
+    return;
+  }
+  std::ofstream outdata(op);
+  if (!outdata) {
+    throw std::runtime_error("could not create the final boolean share file in " + dir);
+  }
+  outdata << num_outputs << "\n";
+  for (std::size_t i = 0; i < num_outputs; ++i) {
+    outdata << shares.Delta[i] << " " << shares.delta[i] << "\n";
+  }
+}
+
+// base OTs carried from one request to the next
+using BaseOTs = std::pair<MOTION::ReceiverMsgs, MOTION::SenderMsgs>;
+
+void run_inference(const Options& options, MOTION::Communication::CommunicationLayer& comm_layer,
+                   std::shared_ptr<MOTION::Logger> logger,
+                   MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
+                   std::optional<BaseOTs>& base_ots,
+                   MOTION::tensor::SocketOutputSink* output_receiver,
+                   MOTION::Communication::Transport* dealer_transport) {
+  const auto other_id = 1 - options.my_id;
+  MOTION::Statistics::RunTimeStats dealer_stats;
+  MOTION::TwoPartyTensorBackend backend(comm_layer, options.threads,
+                                        options.sync_between_setup_and_online, logger);
+  if (dealer_transport != nullptr) {
+    backend.set_linalg_triple_provider(std::make_shared<MOTION::DealerLinAlgTripleProvider>(
+        options.my_id, *dealer_transport, dealer_stats, logger));
+  }
+  if (base_ots.has_value()) {
+    backend.get_base_ot_provider().ImportBaseOTs(other_id, base_ots->first);
+    backend.get_base_ot_provider().ImportBaseOTs(other_id, base_ots->second);
+  } else if (!options.base_ot_state.empty() && std::filesystem::exists(options.base_ot_state)) {
+    backend.get_base_ot_provider().LoadBaseOTs(options.base_ot_state);
+  }
+  backend.set_base_ot_state_file(options.base_ot_state);
+  auto output_futures = create_network(options, backend);
+  if (options.no_run) {
+    return;
+  }
+  backend.run();
+  run_time_stats.add(backend.get_run_time_stats());
+  base_ots = backend.get_base_ot_provider().ExportBaseOTs(other_id);
+
+  const auto final_shares = make_final_shares(output_futures[0].get(), output_futures[1].get(),
+                                              options.image_file.col);
+  if (output_receiver != nullptr) {
+    // a classes x images matrix in the layout of a binary share file
+    const auto num_classes = final_shares.Delta.size() / final_shares.num_images;
+    output_receiver->write(
+        {.batch_size_ = 1, .num_channels_ = 1, .height_ = num_classes,
+         .width_ = final_shares.num_images},
+        final_shares.Delta, final_shares.delta);
+    output_receiver->flush();
+  } else {
+    write_final_shares(options, final_shares);
+  }
+}
+
+// both servers receive the same sequence of models, but not necessarily at the same time and a
+// failed upload may be missing on one of them: exchange the digests of the current and the pending
+// models (oldest first) and agree on the newest model of server 0 that server 1 holds as well
+std::uint64_t agree_on_model(MOTION::Communication::CommunicationLayer& comm_layer,
+                             ModelVersionHandler& version_handler, std::size_t my_id,
+                             const std::vector<std::uint64_t>& my_digests) {
+  const std::vector<std::uint8_t> payload(
+      reinterpret_cast<const std::uint8_t*>(my_digests.data()),
+      reinterpret_cast<const std::uint8_t*>(my_digests.data() + my_digests.size()));
+  comm_layer.send_message(1 - my_id, MOTION::Communication::BuildMessage(
+                                         MOTION::Communication::MessageType::ApplicationMessage,
+                                         &payload));
+  const auto other_digests = version_handler.wait_digests();
+  const auto& digests_0 = my_id == 0 ? my_digests : other_digests;
+  const auto& digests_1 = my_id == 0 ? other_digests : my_digests;
+  const auto it = std::find_first_of(std::rbegin(digests_0), std::rend(digests_0),
+                                     std::begin(digests_1), std::end(digests_1));
+  if (it == std::rend(digests_0)) {
+    throw std::runtime_error("the servers do not hold a common model");
+  }
+  return *it;
+}
+
+// evaluates every image received on the image port against the resident model
+void serve_requests(Options& options, MOTION::Communication::CommunicationLayer& comm_layer,
+                    std::shared_ptr<MOTION::Logger> logger,
+                    MOTION::Statistics::AccumulatedRunTimeStats& run_time_stats,
+                    MOTION::tensor::SocketOutputSink* output_receiver,
+                    MOTION::Communication::Transport* dealer_transport) {
+  auto pending_models = std::make_shared<PendingModels>();
+  if (options.model_port != 0) {
+    std::thread(receive_models, options.model_port, options.seed_compressed,
+                options.fractional_bits, pending_models)
+        .detach();
+  }
+  auto version_handler = std::make_shared<ModelVersionHandler>();
+  comm_layer.register_message_handler([version_handler](auto) { return version_handler; },
+                                      {MOTION::Communication::MessageType::ApplicationMessage});
+  comm_layer.start();
+  std::size_t model_version = 0;
+  auto current_digest = model_digest(options.layers);
+  std::optional<BaseOTs> base_ots;
+  for (std::size_t request = 0; options.num_requests == 0 || request < options.num_requests;
+       ++request) {
+    auto [frac_bits, shares_and_dims] =
+        COMPUTE_SERVER::get_provider_mat_mul_data(options.image_port, options.seed_compressed);
+    if (frac_bits != options.fractional_bits) {
+      throw std::runtime_error(fmt::format("image uses {} fractional bits, expected {}", frac_bits,
+                                           options.fractional_bits));
+    }
+    const auto& [shares, dims] = shares_and_dims;
+    // the current model followed by the pending ones in the order they were received
+    std::vector<std::uint64_t> digests = {current_digest};
+    std::vector<std::size_t> versions = {model_version};
+    {
+      std::scoped_lock lock(pending_models->mutex);
+      for (const auto& [version, model] : pending_models->models) {
+        versions.push_back(version);
+        digests.push_back(model.digest);
+      }
+    }
+    const auto digest = agree_on_model(comm_layer, *version_handler, options.my_id, digests);
+    const auto index = static_cast<std::size_t>(
+        std::find(std::begin(digests), std::end(digests), digest) - std::begin(digests));
+    if (versions[index] > model_version) {
+      std::scoped_lock lock(pending_models->mutex);
+      auto& models = pending_models->models;
+      options.layers = std::move(models.at(versions[index]).layers);
+      models.erase(models.begin(), models.upper_bound(versions[index]));
+      model_version = versions[index];
+      current_digest = digest;
+      std::cout << fmt::format("Switched to model version {} ({:016x})\n", model_version, digest);
+    }
+    if (index + 1 < digests.size()) {
+      std::cout << "The other server does not hold the newest model yet, keeping model version "
+                << model_version << "\n";
+    }
+    options.image_file = to_matrix(shares, dims.at(0), dims.at(1));
+    check_dimensions(options);
+    run_inference(options, comm_layer, logger, run_time_stats, base_ots, output_receiver,
+                  dealer_transport);
+    std::cout << "Finished request " << request << "\n";
+  }
+  pending_models->stop = true;
+  comm_layer.deregister_message_handler({MOTION::Communication::MessageType::ApplicationMessage});
+}
+
+int main(int argc, char* argv[]) {
+  auto options = parse_program_options(argc, argv);
+  int WriteToFiles = 1;
+  if (!options.has_value()) {
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto comm_layer = setup_communication(*options);
+    auto logger = std::make_shared<MOTION::Logger>(options->my_id,
+                                                   boost::log::trivial::severity_level::trace);
+    comm_layer->set_logger(logger);
+    MOTION::Statistics::AccumulatedRunTimeStats run_time_stats;
+    MOTION::Statistics::AccumulatedCommunicationStats comm_stats;
+    // connection to the image provider's inference_result_receiver, kept open for all requests
+    std::unique_ptr<MOTION::tensor::SocketOutputSink> output_receiver;
+    if (options->output_receiver_port != 0) {
+      constexpr std::size_t max_connect_attempts = 50;
+      output_receiver = std::make_unique<MOTION::tensor::SocketOutputSink>(
+          options->output_receiver_ip, options->output_receiver_port, options->fractional_bits,
+          max_connect_attempts);
+    }
+    std::unique_ptr<MOTION::Communication::Transport> dealer_transport;
+    if (options->dealer.has_value()) {
+      dealer_transport = connect_to_dealer(*options);
+    }
+    if (options->image_port != 0) {
+      serve_requests(*options, *comm_layer, logger, run_time_stats, output_receiver.get(),
+                     dealer_transport.get());
+    } else {
+      std::optional<BaseOTs> base_ots;
+      run_inference(*options, *comm_layer, logger, run_time_stats, base_ots,
+                    output_receiver.get(), dealer_transport.get());
+    }
+    if (dealer_transport != nullptr) {
+      // lets the dealer wait for the next pair of parties
+      dealer_transport->shutdown();
+    }
+    comm_layer->sync();
+    comm_stats.add(comm_layer->get_transport_statistics());
+    comm_layer->reset_transport_statistics();
+    testMemoryOccupied(WriteToFiles, options->my_id, options->currentpath);
+    comm_layer->shutdown();
+    print_stats(*options, run_time_stats, comm_stats);
+    if (WriteToFiles == 1) {
+      std::string path = options->currentpath;
+      std::string t1 = path + "/" + "AverageTimeDetails" + std::to_string(options->my_id);
+      std::string t2 = path + "/" + "MemoryDetails" + std::to_string(options->my_id);
+
+      std::ofstream file2;
+      file2.open(t2, std::ios_base::app);
+      std::string time_str =
+          MOTION::Statistics::print_stats_short("inference_engine", run_time_stats, comm_stats);
+      double exec_time = std::stod(time_str);
+      file2 << "Execution time - " << exec_time << "msec\n";
+      file2.close();
+
+      std::ofstream file1;
+      file1.open(t1, std::ios_base::app);
+      file1 << exec_time;
+      file1 << "\n";
+      file1.close();
+    }
+  } catch (std::runtime_error& e) {
+    std::cerr << "ERROR OCCURRED: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
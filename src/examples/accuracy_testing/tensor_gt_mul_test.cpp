@@ -68,8 +68,10 @@ Server-1
 #include "protocols/beavy/tensor.h"
 #include "tensor/tensor.h"
 #include "tensor/tensor_op.h"
+#include "tensor/output_sink.h"
 #include "tensor/tensor_op_factory.h"
 #include "utility/new_fixed_point.h"
+#include "utility/share_file.h"
 
 namespace po = boost::program_options;
 int j = 0;
@@ -188,6 +190,15 @@ std::string read_filepath(std::ifstream& indata, int count) {
 }
 
 int image_shares(Options* options, std::string p) {
+  if (MOTION::is_binary_share_file(p)) {
+    const MOTION::MappedShareFile shares(p);
+    options->image_file.row = shares.get_rows();
+    options->image_file.col = shares.get_cols();
+    options->image_file.Delta = shares.copy_Delta(0, shares.get_rows());
+    options->image_file.delta = shares.copy_delta(0, shares.get_rows());
+    return EXIT_SUCCESS;
+  }
+
   std::ifstream temps;
   try {
     temps.open(p);
@@ -238,6 +249,15 @@ int image_shares(Options* options, std::string p) {
 }
 
 int W_shares(Options* options, std::string p) {
+  if (MOTION::is_binary_share_file(p)) {
+    const MOTION::MappedShareFile shares(p);
+    options->W_file.row = shares.get_rows();
+    options->W_file.col = shares.get_cols();
+    options->W_file.Delta = shares.copy_Delta(0, shares.get_rows());
+    options->W_file.delta = shares.copy_delta(0, shares.get_rows());
+    return EXIT_SUCCESS;
+  }
+
   std::ifstream indata;
   try {
     indata.open(p);
@@ -288,6 +308,15 @@ int W_shares(Options* options, std::string p) {
 }
 
 int B_shares(Options* options, std::string p) {
+  if (MOTION::is_binary_share_file(p)) {
+    const MOTION::MappedShareFile shares(p);
+    options->B_file.row = shares.get_rows();
+    options->B_file.col = shares.get_cols();
+    options->B_file.Delta = shares.copy_Delta(0, shares.get_rows());
+    options->B_file.delta = shares.copy_delta(0, shares.get_rows());
+    return EXIT_SUCCESS;
+  }
+
   std::ifstream indata;
   try {
     if (std::ifstream(p)) {
@@ -601,18 +630,26 @@ auto create_composite_circuit(const Options& options, MOTION::TwoPartyTensorBack
   ENCRYPTO::ReusableFiberFuture<std::vector<std::uint64_t>> output_future, main_output_future,
       main_output;
 
+  // the shares are written to server{id}/outputshare_{id} and file_config_input{id} points to them,
+  // which is where the next step of the pipeline reads its input
+  const auto id = std::to_string(options.my_id);
+  auto output_sink = std::make_shared<MOTION::tensor::TextShareFileOutputSink>(
+      options.currentpath + "/server" + id + "/outputshare_" + id,
+      options.currentpath + "/file_config_input" + id);
   if (options.my_id == 0) {
-    arithmetic_tof.make_arithmetic_tensor_output_other(add_output1);
+    arithmetic_tof.make_arithmetic_tensor_output_other(add_output1, output_sink);
   } else {
-    main_output_future = arithmetic_tof.make_arithmetic_64_tensor_output_my(add_output1);
+    main_output_future =
+        arithmetic_tof.make_arithmetic_64_tensor_output_my(add_output1, output_sink);
   }
 
-  return std::move(main_output_future);
+  return std::make_pair(std::move(main_output_future), output_sink);
 }
 
 void run_composite_circuit(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
-  auto output_future = create_composite_circuit(options, backend);
+  auto [output_future, output_sink] = create_composite_circuit(options, backend);
   backend.run();
+  output_sink->flush();
   if (options.my_id == 1) {
     auto main = output_future.get();
     //   std::vector<long double> mod_x;
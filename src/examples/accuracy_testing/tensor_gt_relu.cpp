@@ -65,6 +65,7 @@ Server-1
 #include "protocols/beavy/tensor.h"
 #include "tensor/tensor.h"
 #include "tensor/tensor_op.h"
+#include "tensor/output_sink.h"
 #include "tensor/tensor_op_factory.h"
 #include "utility/fixed_point.h"
 
@@ -125,6 +126,8 @@ struct Options {
   bool sync_between_setup_and_online;
   MOTION::MPCProtocol arithmetic_protocol;
   MOTION::MPCProtocol boolean_protocol;
+  // ReLU via the BEAVY sign extraction instead of the Yao chain
+  bool sign_relu;
   //////////////////////////changes////////////////////////////
   Matrix input;
   std::uint64_t num_elements;
@@ -285,6 +288,10 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
      "number of fractional bits for fixed-point arithmetic")
     ("arithmetic-protocol", po::value<std::string>()->required(), "2PC protocol (GMW or BEAVY)")
     ("boolean-protocol", po::value<std::string>()->required(), "2PC protocol (Yao, GMW or BEAVY)")
+    ("relu", po::value<std::string>()->default_value("yao"),
+     "ReLU of the arithmetic shares: yao (negate, conversion to Yao, garbled ReLU, conversion back: "
+     "about 3 online rounds, but garbled tables) or sign (BEAVY only: sign bit extracted in Boolean "
+     "BEAVY, less communication, but 8 online rounds)")
     ("filepath", po::value<std::string>()->required(), "Path of the shares file from build_debwithrelinfo folder")
     ("repetitions", po::value<std::size_t>()->default_value(1), "number of repetitions")
     ("num-simd", po::value<std::size_t>()->default_value(1), "number of SIMD values")
@@ -353,6 +360,20 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     std::cerr << "invalid protocol: " << boolean_protocol << "\n";
     return std::nullopt;
   }
+  auto relu = vm["relu"].as<std::string>();
+  boost::algorithm::to_lower(relu);
+  if (relu == "yao") {
+    options.sign_relu = false;
+  } else if (relu == "sign") {
+    if (options.arithmetic_protocol != MOTION::MPCProtocol::ArithmeticBEAVY) {
+      std::cerr << "--relu sign needs BEAVY as the arithmetic protocol\n";
+      return std::nullopt;
+    }
+    options.sign_relu = true;
+  } else {
+    std::cerr << "invalid ReLU: " << relu << "\n";
+    return std::nullopt;
+  }
 
   //////////////////////////////////////////////////////////////////
   file_read(&options);
@@ -407,6 +428,7 @@ void print_stats(const Options& options,
     obj.emplace("party_id", options.my_id);
     obj.emplace("arithmetic_protocol", MOTION::ToString(options.arithmetic_protocol));
     obj.emplace("boolean_protocol", MOTION::ToString(options.boolean_protocol));
+    obj.emplace("sign_relu", options.sign_relu);
     obj.emplace("simd", options.num_simd);
     obj.emplace("threads", options.threads);
     obj.emplace("sync_between_setup_and_online", options.sync_between_setup_and_online);
@@ -448,7 +470,12 @@ auto create_composite_circuit(const Options& options, MOTION::TwoPartyTensorBack
 
   std::function<MOTION::tensor::TensorCP(const MOTION::tensor::TensorCP&)> make_activation;
 
-  make_activation = [&](const auto& input) {
+  make_activation = [&](const auto& input) -> MOTION::tensor::TensorCP {
+    // BEAVY can compute the ReLU of arithmetic tensors directly, which trades the garbled tables of
+    // the Yao chain for more online rounds
+    if (options.sign_relu) {
+      return arithmetic_tof.make_tensor_relu_op(input);
+    }
     const auto negated_tensor = arithmetic_tof.make_tensor_negate(input);
     const auto boolean_tensor =
         boolean_tof.make_tensor_conversion(MOTION::MPCProtocol::Yao, negated_tensor);
@@ -463,18 +490,26 @@ auto create_composite_circuit(const Options& options, MOTION::TwoPartyTensorBack
   ENCRYPTO::ReusableFiberFuture<std::vector<std::uint64_t>> output_future, main_output_future,
       main_output;
 
+  // the shares are written to server{id}/outputshare_{id} and file_config_input{id} points to them,
+  // which is where the next step of the pipeline reads its input
+  const auto id = std::to_string(options.my_id);
+  auto output_sink = std::make_shared<MOTION::tensor::TextShareFileOutputSink>(
+      options.currentpath + "/server" + id + "/outputshare_" + id,
+      options.currentpath + "/file_config_input" + id);
   if (options.my_id == 0) {
-    arithmetic_tof.make_arithmetic_tensor_output_other(relu_output);
+    arithmetic_tof.make_arithmetic_tensor_output_other(relu_output, output_sink);
   } else {
-    main_output_future = arithmetic_tof.make_arithmetic_64_tensor_output_my(relu_output);
+    main_output_future =
+        arithmetic_tof.make_arithmetic_64_tensor_output_my(relu_output, output_sink);
   }
 
-  return std::move(main_output_future);
+  return std::make_pair(std::move(main_output_future), output_sink);
 }
 
 void run_composite_circuit(const Options& options, MOTION::TwoPartyTensorBackend& backend) {
-  auto output_future = create_composite_circuit(options, backend);
+  auto [output_future, output_sink] = create_composite_circuit(options, backend);
   backend.run();
+  output_sink->flush();
   // if (options.my_id == 1) {
   //   auto main = output_future.get();
 
@@ -3,6 +3,11 @@
 ./bin/weight_share_receiver_genr --my-id 0 --port 1234 --current-path ${BASE_DIR}/build_debwithrelinfo_gcc
 
 ./bin/weight_share_receiver_genr --my-id 1 --port 1235 --current-path ${BASE_DIR}/build_debwithrelinfo_gcc
+
+With --binary-shares the shares are stored in the binary share file format (utility/share_file.h)
+instead of one decimal "Delta delta" pair per line.
+With --seed-compressed the weights provider (also started with --seed-compressed) sends a PRG seed
+and the Delta values per matrix, and delta is expanded locally.
 */
 // MIT License
 //
@@ -48,6 +53,7 @@
 #include "compute_server/compute_server.h"
 #include "utility/logger.h"
 #include "utility/fixed_point.h"
+#include "utility/share_file.h"
 
 namespace po = boost::program_options;
 
@@ -58,6 +64,8 @@ struct Options {
   std::string currentpath;
   int port;
   int number_of_layers;
+  bool binary_shares;
+  bool seed_compressed;
 };
 
 std::optional<Options> parse_program_options(int argc, char* argv[]) {
@@ -69,6 +77,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
     ("my-id", po::value<std::size_t>()->required(), "my party id")
     ("port" , po::value<int>()->required(), "Port number on which to listen")
     ("current-path",po::value<std::string>()->required(), "current path build_debwithrelinfo")
+    ("binary-shares", po::bool_switch()->default_value(false), "store the shares in the binary share file format")
+    ("seed-compressed", po::bool_switch()->default_value(false), "expect seed-compressed shares from the provider")
     ;
   // clang-format on
 
@@ -91,6 +101,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.port = vm["port"].as<int>();
   // options.filenames = vm["file-names"].as<std::string>();
   options.currentpath = vm["current-path"].as<std::string>();
+  options.binary_shares = vm["binary-shares"].as<bool>();
+  options.seed_compressed = vm["seed-compressed"].as<bool>();
   // ----------------- Input Validation ----------------------------------------//
   if (options.my_id > 1) {
     std::cerr << "my-id must be 0 or 1\n";
@@ -158,7 +170,7 @@ void retrieve_shares(Options& options) {
   ////////////////////////////////////////////////////////////
 
   auto [numberOfLayers, frac, data_and_dims] =
-      COMPUTE_SERVER::get_provider_total_data_genr(options.port);
+      COMPUTE_SERVER::get_provider_total_data_genr(options.port, options.seed_compressed);
   options.number_of_layers = numberOfLayers;
   if(options.number_of_layers<1){
     throw std::runtime_error("Number of layers cannot be lesser than one.\n");
@@ -170,6 +182,18 @@ void retrieve_shares(Options& options) {
     std::cout << "Writing shares to file "<< data_share_file_path << "\n";
     std::vector<COMPUTE_SERVER::Shares> input_values_dp1 = data_and_dims.first[i];
     auto currentdims = data_and_dims.second[i];
+    if (options.binary_shares) {
+      std::vector<std::uint64_t> Delta, delta;
+      Delta.reserve(input_values_dp1.size());
+      delta.reserve(input_values_dp1.size());
+      for (const auto& share : input_values_dp1) {
+        Delta.push_back(share.Delta);
+        delta.push_back(share.delta);
+      }
+      MOTION::write_share_file(data_share_file_path, currentdims.first, currentdims.second, frac,
+                               Delta, delta);
+      continue;
+    }
     file.open(data_share_file_path, std::ios_base::out);
     if(!file.is_open()){
         file.close();
@@ -0,0 +1,120 @@
+// Typed bulk messages exchanged by server 0, server 1 and the helper node.
+//
+// A message consists of a fixed-size Header followed by a contiguous payload of uint64 values,
+// both in little-endian byte order. This is the host representation, so a message is built and
+// read with one memcpy per part instead of serializing every value byte by byte.
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "crypto/random/aes128_ctr_rng.h"
+
+namespace bulk_message {
+
+static_assert(std::endian::native == std::endian::little,
+              "the bulk message format requires a little-endian host");
+
+enum class MessageType : std::uint64_t {
+  weight_shares = 1,  // server i -> helper node: secret shares of W
+  input_shares,       // server i -> helper node: secret shares of X
+  z_minus_r,          // helper node -> server 1: Z - R
+  public_output,      // server 0 -> server 1: public share of the output
+  output_shares,      // server 1 -> server 0: public shares and then secret shares of the output
+};
+
+struct Header {
+  MessageType type;
+  std::uint64_t request_id;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t size;  // number of uint64 values in the payload
+};
+static_assert(sizeof(Header) == 5 * sizeof(std::uint64_t));
+
+// Builds a message from the header and the concatenation of parts; header.size is set accordingly.
+inline std::vector<std::uint8_t> encode(Header header,
+                                        std::initializer_list<std::span<const std::uint64_t>> parts) {
+  header.size = 0;
+  for (const auto& part : parts) {
+    header.size += part.size();
+  }
+  std::vector<std::uint8_t> message(sizeof(Header) + header.size * sizeof(std::uint64_t));
+  std::memcpy(message.data(), &header, sizeof(Header));
+  auto* payload = message.data() + sizeof(Header);
+  for (const auto& part : parts) {
+    std::memcpy(payload, part.data(), part.size_bytes());
+    payload += part.size_bytes();
+  }
+  return message;
+}
+
+// Returns the type of a message, e.g., to dispatch it before calling decode_header.
+inline MessageType get_type(const std::vector<std::uint8_t>& message) {
+  if (message.size() < sizeof(Header)) {
+    throw std::runtime_error("bulk message of " + std::to_string(message.size()) +
+                             " bytes is shorter than its header");
+  }
+  MessageType type;
+  std::memcpy(&type, message.data(), sizeof(type));
+  return type;
+}
+
+// Reads and checks the header of a message of the expected type.
+inline Header decode_header(const std::vector<std::uint8_t>& message, MessageType expected_type) {
+  if (message.size() < sizeof(Header)) {
+    throw std::runtime_error("bulk message of " + std::to_string(message.size()) +
+                             " bytes is shorter than its header");
+  }
+  Header header;
+  std::memcpy(&header, message.data(), sizeof(Header));
+  if (header.type != expected_type) {
+    throw std::runtime_error("expected bulk message of type " +
+                             std::to_string(static_cast<std::uint64_t>(expected_type)) +
+                             " but received type " +
+                             std::to_string(static_cast<std::uint64_t>(header.type)));
+  }
+  if (message.size() != sizeof(Header) + header.size * sizeof(std::uint64_t)) {
+    throw std::runtime_error("bulk message of " + std::to_string(message.size()) +
+                             " bytes does not match its payload size " +
+                             std::to_string(header.size));
+  }
+  return header;
+}
+
+// Copies count payload values starting at value first of a message checked by decode_header.
+inline void copy_payload(const std::vector<std::uint8_t>& message, std::size_t first,
+                         std::size_t count, std::uint64_t* output) {
+  if ((first + count) * sizeof(std::uint64_t) > message.size() - sizeof(Header)) {
+    throw std::runtime_error("payload range exceeds the bulk message");
+  }
+  std::memcpy(output, message.data() + sizeof(Header) + first * sizeof(std::uint64_t),
+              count * sizeof(std::uint64_t));
+}
+
+// seed of a session from which server 0 and the helper node expand R, the mask of Z = W * X
+using Seed = std::array<std::byte, AES128_CTR_RNG::block_size>;
+
+// Expands the n values of R of request request_id from the session seed. Every request uses its own
+// range of 2^40 blocks of the stream, so request ids are limited to 24 bits.
+inline void expand_R(const Seed& seed, std::uint64_t request_id, std::uint64_t* R, std::size_t n) {
+  constexpr unsigned block_range_bits = 40;
+  if (request_id >> (64 - block_range_bits) != 0) {
+    throw std::runtime_error("request id " + std::to_string(request_id) +
+                             " exceeds the 24 bits of the R stream counter");
+  }
+  AES128_CTR_RNG rng;
+  rng.set_key(seed.data(), request_id << block_range_bits);
+  rng.random_bytes(reinterpret_cast<std::byte*>(R), n * sizeof(std::uint64_t));
+}
+
+}  // namespace bulk_message
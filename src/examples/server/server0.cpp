@@ -1,5 +1,6 @@
 //./bin/server0 --WB_file file_config_model0 --input_file 9
 #include <unistd.h>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <random>
@@ -9,6 +10,7 @@
 #include "communication/communication_layer.h"
 #include "communication/message_handler.h"
 #include "communication/tcp_transport.h"
+#include "crypto/random/aes128_ctr_rng.h"
 #include "utility/logger.h"
 
 #include <boost/algorithm/string.hpp>
@@ -23,6 +25,8 @@
 #include <vector>
 #include "utility/new_fixed_point.h"
 
+#include "bulk_message.h"
+
 #include <boost/chrono.hpp>
 #include <boost/thread/thread.hpp>
 #include <chrono>
@@ -32,9 +36,13 @@ using namespace std::chrono;
 std::vector<std::uint64_t> R;
 std::vector<std::uint64_t> wpublic, xpublic, wsecret, xsecret, bpublic, bsecret;
 std::vector<std::uint64_t> randomnum, prod1;
-bool helpernode_ready_flag = false;
-int operations_done_flag = 0;
+// shared between the main thread and the message handler thread
+std::atomic<bool> helpernode_ready_flag = false;
+// 1 once the local product is computed, 2 once the output shares of the layer are written
+std::atomic<int> operations_done_flag = 0;
 std::uint64_t fractional_bits;
+// id of the helper node request of this layer
+std::atomic<std::uint64_t> request_id;
 namespace po = boost::program_options;
 
 void testMemoryOccupied(int WriteToFiles, int my_id, std::string path) {
@@ -77,6 +85,7 @@ struct Options {
   std::string WB_file;
   std::string input_file;
   std::size_t layer_id;
+  std::size_t num_layers;
   std::string current_path;
   MOTION::Communication::tcp_parties_config tcp_config;
   std::size_t fractional_bits;
@@ -89,6 +98,10 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   desc.add_options()
     ("help,h", po::bool_switch()->default_value(false),"produce help message")
     ("layer-id", po::value<std::size_t>()->required(), "layer id")
+    ("num-layers", po::value<std::size_t>()->default_value(1),
+     "number of consecutive layers from layer-id on that are computed over the same connections; "
+     "every further layer starts when a line is read from stdin, i.e., once the ReLU step has "
+     "written its input to outputshare_0")
     ("WB_file", po::value<std::string>()->required(), "Weights and Bias Filename")  
     ("input_file", po::value<std::string>()->required(), "Input File name") 
     ("party", po::value<std::vector<std::string>>()->multitoken(),
@@ -119,6 +132,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.current_path = vm["current-path"].as<std::string>();
   options.input_file = vm["input_file"].as<std::string>();
   options.layer_id = vm["layer-id"].as<std::size_t>();
+  options.num_layers = vm["num-layers"].as<std::size_t>();
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
   fractional_bits = options.fractional_bits;
   std::cout<<"Fractional bits: "<<fractional_bits<<std::endl;
@@ -179,25 +193,6 @@ void print_message(std::vector<std::uint8_t>& message) {
   return;
 }
 
-std::uint64_t getuint64(std::vector<std::uint8_t>& message, int index) {
-  //Converts 8->64
-  std::uint64_t num = 0;
-  for (auto i = 0; i < 8; i++) {
-    num = num << 8;
-    num = num | message[(index + 1) * 8 - 1 - i];
-  }
-  return num;
-}
-
-void adduint64(std::uint64_t num, std::vector<std::uint8_t>& message) {
-  //Converts 64->8
-  for (auto i = 0; i < sizeof(num); i++) {
-    std::uint8_t byte = num & 0xff;
-    message.push_back(byte);
-    num = num >> 8;
-  }
-}
-
 template <typename E>
 std::uint64_t RandomNumGenerator(E &engine)
 {
@@ -207,6 +202,11 @@ std::uint64_t RandomNumGenerator(E &engine)
      return dis(engine);
 }
 
+using bulk_message::Seed;
+using bulk_message::expand_R;
+// seed for R, sent by the helper node with its acknowledgement
+Seed R_seed;
+
 std::vector<std::uint64_t>multiplicate(std::vector<uint64_t>&a,std::vector<uint64_t>&b)
 {   
     if(a[1]!=b[0])
@@ -316,18 +316,20 @@ void operations()
     //output=output+random(local secret share)
 
     __gnu_parallel::transform(prod1_begin, prod1_end, random_begin, prod1_begin , std::plus{});   
-    operations_done_flag++;
 
 }
 
 class TestMessageHandler : public MOTION::Communication::MessageHandler {
   void received_message(std::size_t party_id, std::vector<std::uint8_t>&& message) override {
     std::cout << "Message received from party " << party_id << "\n";
-    if(message.size()==1 && message[0]==(std::uint8_t)1)
+    // the acknowledgement of the helper node carries the seed for R
+    if(message.size()==1+R_seed.size() && message[0]==(std::uint8_t)1)
       {
         if(party_id==2)
           {
             std::cout<<"\nHelper node has acknowledged receiving the start connection message.\n";
+            std::transform(message.begin() + 1, message.end(), R_seed.begin(),
+                           [](auto b) { return std::byte(b); });
             helpernode_ready_flag = true;
             return;
           }
@@ -344,54 +346,33 @@ class TestMessageHandler : public MOTION::Communication::MessageHandler {
         boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
       }
     
-    int k = message.size() / 8;
     if(party_id==2)
     {
-      std::cout <<"R-Message size before converting to 64bit uint: "<<message.size() <<std::endl;
-      if(message.size()<=0)
-        {
-          std::cerr<<"Empty message received from party "<<party_id<<std::endl;
-          exit(1);
-        }
-      for (auto i = 0; i < k; ++i) {
-        auto temp = getuint64(message, i);
-        R.push_back(temp);
-      }
-      std::cout<<"k="<<k<<"   R.size()="<<R.size()<<std::endl;
-      if (R.size() == k) {
-        std::cout<<"Before operations\n";
-        operations();
-        operations_done_flag++;
-        std::cout<<"After operations\n";
-        }
-      
+      // R is expanded from the seed, the helper node sends nothing else
+      std::cerr<<"Unexpected message of size "<<message.size()<<" from the helper node"<<std::endl;
+      exit(1);
     }
     else if(party_id==1)
     { 
-      while(operations_done_flag!=2)
+      while(operations_done_flag!=1)
         {
           std::cout<<".";
           boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
         }
-      std::vector<std::uint64_t>Final_public;
-      std::vector<std::uint64_t>secretshare1;
-      std::cout <<"\nReceived message from Party 1 of size "<< message.size() << "\n"; //should be 258
-    
-      //to push rows and column 
-      for(int i=0;i<2;i++)
-      {
-        auto j=getuint64(message,i);
-        Final_public.push_back(j);
-        secretshare1.push_back(j);
-      }
-
-      for(int i=2;i<k-1;i=i+2)
-      { 
-        auto temp = getuint64(message, i);
-        Final_public.push_back(temp);
-        auto temp2=getuint64(message, i+1);
-        secretshare1.push_back(temp2);
+      std::cout <<"\nReceived message from Party 1 of size "<< message.size() << "\n";
+      // payload: the public shares and then the secret shares of party 1
+      const auto header = bulk_message::decode_header(message, bulk_message::MessageType::output_shares);
+      const std::size_t n = header.rows * header.cols;
+      if (header.request_id != request_id || header.size != 2 * n) {
+        std::cerr<<"Received output shares of request "<<header.request_id<<" with "<<header.size<<" values, expected request "<<request_id<<" with "<<2 * n<<" values"<<std::endl;
+        exit(1);
       }
+      std::vector<std::uint64_t>Final_public(n + 2);
+      std::vector<std::uint64_t>secretshare1(n + 2);
+      Final_public[0] = secretshare1[0] = header.rows;
+      Final_public[1] = secretshare1[1] = header.cols;
+      bulk_message::copy_payload(message, 0, n, Final_public.data() + 2);
+      bulk_message::copy_payload(message, n, n, secretshare1.data() + 2);
       auto finalpublic_begin = Final_public.begin();
       auto finalpublic_end = Final_public.end();
       advance(finalpublic_begin,2);
@@ -449,6 +430,8 @@ class TestMessageHandler : public MOTION::Communication::MessageHandler {
       }
     config_file<<totalpath;
     config_file.close();
+    // the output of this layer is written
+    operations_done_flag++;
   } 
 }
 }; 
@@ -505,8 +488,6 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
     }
 
     auto k = 0;
-    adduint64(rows, message);
-    adduint64(col, message);
     wpublic.push_back(rows);
     wpublic.push_back(col);
     wsecret.push_back(rows);
@@ -527,7 +508,6 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
         std::cerr << "Weight shares file contains less number of elements" << std::endl;
         exit(1);
       }
-      adduint64(secret_share, message);
       k++;
     }
     std::cout<<"Number of weight shares read: "<<k<<"\n"; 
@@ -540,6 +520,9 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
       }
     }
     file.close();
+    message = bulk_message::encode(
+        {bulk_message::MessageType::weight_shares, request_id, rows, col},
+        {std::span(wsecret).subspan(2)});
 
     file.open(bpath);
     if (!file) {
@@ -623,8 +606,6 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
       exit(1);
     }
     auto k = 0;
-    adduint64(rows, message);
-    adduint64(col, message);
     xpublic.push_back(rows);
     xpublic.push_back(col);
     xsecret.push_back(rows);
@@ -645,7 +626,6 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
       std::cerr << "Input shares file contains less number of elements" << std::endl;
       exit(1);
       }
-      adduint64(secret_share, message);
       k++;
     }
     if (k == rows * col) {
@@ -657,6 +637,9 @@ void read_shares(int choice,int my_id, std::vector<uint8_t>&message,const Option
       }
     }
     file.close();
+    message = bulk_message::encode(
+        {bulk_message::MessageType::input_shares, request_id, rows, col},
+        {std::span(xsecret).subspan(2)});
   }
 }
 
@@ -714,60 +697,95 @@ int main(int argc, char* argv[]) {
     comm_layer->register_fallback_message_handler([](auto party_id) { return std::make_shared<TestMessageHandler>(); });
 
 
-    read_shares(1,0,message1,*options); //Weight shares
-    read_shares(2,0,message2,*options); //Input shares
+    // all layers are computed over the connections of this session, request_id = layer id
+    for(std::size_t layer_id=options->layer_id; layer_id<options->layer_id+options->num_layers; ++layer_id)
+    {
+      Options layer_options = *options;
+      layer_options.layer_id = layer_id;
+      if(layer_id>options->layer_id)
+        {
+          // wait until the ReLU step has written the input of this layer
+          std::string line;
+          if(!std::getline(std::cin, line))
+            {
+              std::cerr<<"Input closed before layer "<<layer_id<<std::endl;
+              return EXIT_FAILURE;
+            }
+          layer_options.input_file = "outputshare";
+        }
+      request_id = layer_id;
+      operations_done_flag = 0;
+      for(auto* v : {&wpublic, &wsecret, &bpublic, &bsecret, &xpublic, &xsecret})
+        {
+          v->clear();
+        }
+      message1.clear();
+      message2.clear();
 
-    //Waiting to receive the acknowledgement from helpernode
-    while(!helpernode_ready_flag)
-      {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
-      }
+      read_shares(1,0,message1,layer_options); //Weight shares
+      read_shares(2,0,message2,layer_options); //Input shares
 
+      //Waiting to receive the acknowledgement from helpernode
+      while(!helpernode_ready_flag)
+        {
+          std::cout<<".";
+          boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+        }
 
-    std::cout<<"Weight shares size: "<<message1.size()<<"\n";
-    std::cout<<"Input shares size: "<<message2.size()<<"\n";
-    std::cout<<"Sending Weight shares to the helper node\n";
 
-    try{
-      comm_layer->send_message(helpernode_id, message1);
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending the weight shares to helper node: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
+      std::cout<<"Weight shares size: "<<message1.size()<<"\n";
+      std::cout<<"Input shares size: "<<message2.size()<<"\n";
+      std::cout<<"Sending Weight shares to the helper node\n";
 
-    try{  
-      comm_layer->send_message(helpernode_id, message2);
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending the input shares to helper node: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
-        
-    testMemoryOccupied(WriteToFiles,0, options->current_path);
-    //Waiting for the operations to complete. 
-    std::cout<<std::endl;
-    while(operations_done_flag!=2)
-      {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+      try{
+        comm_layer->send_message(helpernode_id, message1);
       }
+      catch (std::runtime_error& e) {
+        std::cerr << "Error occurred while sending the weight shares to helper node: " << e.what() << "\n";
+        return EXIT_FAILURE;
+      }
+
+      try{  
+        comm_layer->send_message(helpernode_id, message2);
+      }
+      catch (std::runtime_error& e) {
+        std::cerr << "Error occurred while sending the input shares to helper node: " << e.what() << "\n";
+        return EXIT_FAILURE;
+      }
+        
+      // R = [rows][cols][values expanded from the seed], the helper node computes the same values
+      R.resize(2 + wpublic[0] * xpublic[1]);
+      R[0] = wpublic[0];
+      R[1] = xpublic[1];
+      expand_R(R_seed, request_id, R.data() + 2, R.size() - 2);
+      operations();
+      // publishes prod1 and randomnum to the handler of the other server's output message
+      operations_done_flag++;
+
+      testMemoryOccupied(WriteToFiles,0, options->current_path);
+      std::cout<<std::endl;
     
-    std::vector<std::uint8_t>mes0;
-    for(int i=0;i<prod1.size();i++)
-    {  
-      auto temp=prod1[i];
-      adduint64(temp, mes0);
-    }
-    std::cout<<"Sending DEL_C0 to the Party 1\n";
-    try{
-    comm_layer->send_message(1,mes0);
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending the output public share to Server-1: " << e.what() << "\n";
-      return EXIT_FAILURE;
+      auto mes0 = bulk_message::encode(
+          {bulk_message::MessageType::public_output, request_id, prod1[0], prod1[1]},
+          {std::span(prod1).subspan(2)});
+      std::cout<<"Sending DEL_C0 to the Party 1\n";
+      try{
+      comm_layer->send_message(1,mes0);
+      }
+      catch (std::runtime_error& e) {
+        std::cerr << "Error occurred while sending the output public share to Server-1: " << e.what() << "\n";
+        return EXIT_FAILURE;
+      }
+      //Waiting for the output shares of this layer to be written
+      while(operations_done_flag!=2)
+        {
+          boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+        }
+      std::cout<<"Layer "<<layer_id<<" done"<<std::endl;
     }
+    // the helper node keeps running and waits for the end of the session before it disconnects
+    std::vector<std::uint8_t> ended{(std::uint8_t)0};
+    comm_layer->send_message(helpernode_id, ended);
     comm_layer->shutdown();
   auto stop = high_resolution_clock::now();
   auto duration = duration_cast<milliseconds>(stop - start);
@@ -25,6 +25,8 @@
 #include <parallel/algorithm>
 #include <vector>
 #include "utility/new_fixed_point.h"
+
+#include "bulk_message.h"
 using namespace std::chrono;
 
 std::vector<std::uint64_t> Z;  //
@@ -33,6 +35,8 @@ std::vector<std::uint64_t> randomnum;
 int operations_done_flag = 0;
 bool helpernode_ready_flag = false;
 std::uint64_t fractional_bits;
+// id of the helper node request of this layer
+std::uint64_t request_id;
 namespace po = boost::program_options;
 
 void testMemoryOccupied(int WriteToFiles, int my_id, std::string path) {
@@ -75,6 +79,7 @@ struct Options {
   std::string WB_file;
   std::string input_file;
   std::size_t layer_id;
+  std::size_t num_layers;
   std::string current_path;
   MOTION::Communication::tcp_parties_config tcp_config;
   std::size_t fractional_bits;
@@ -87,6 +92,10 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   desc.add_options()
     ("help,h", po::bool_switch()->default_value(false),"produce help message")
     ("layer-id", po::value<std::size_t>()->required(), "layer id")
+    ("num-layers", po::value<std::size_t>()->default_value(1),
+     "number of consecutive layers from layer-id on that are computed over the same connections; "
+     "every further layer starts when a line is read from stdin, i.e., once the ReLU step has "
+     "written its input to outputshare_1")
     ("WB_file", po::value<std::string>()->required(), "Weights and Bias Filename")  
     ("input_file", po::value<std::string>()->required(), "Input File name") 
     ("party", po::value<std::vector<std::string>>()->multitoken(),
@@ -117,6 +126,7 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.current_path = vm["current-path"].as<std::string>();
   options.input_file = vm["input_file"].as<std::string>();
   options.layer_id = vm["layer-id"].as<std::size_t>();
+  options.num_layers = vm["num-layers"].as<std::size_t>();
   options.fractional_bits = vm["fractional-bits"].as<std::size_t>();
   fractional_bits = options.fractional_bits;
   // clang-format on;
@@ -173,25 +183,6 @@ void print_message(std::vector<std::uint8_t>& message) {
   return;
 }
 
-std::uint64_t getuint64(std::vector<std::uint8_t>& message, int index) {
-  //Converts 8->64
-  std::uint64_t num = 0;
-  for (auto i = 0; i < 8; i++) {
-    num = num << 8;
-    num = num | message[(index + 1) * 8 - 1 - i];
-  }
-  return num;
-}
-
-void adduint64(std::uint64_t num, std::vector<std::uint8_t>& message) {
-  //Converts 64->8
-  for (auto i = 0; i < sizeof(num); i++) {
-    std::uint8_t byte = num & 0xff;
-    message.push_back(byte);
-    num = num >> 8;
-  }
-}
-
 template <typename E>
 std::uint64_t RandomNumGenerator(E &engine)
 {
@@ -330,24 +321,20 @@ class TestMessageHandler : public MOTION::Communication::MessageHandler {
         std::cout<<".";
         boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
       }
-    int k = message.size() / 8;
     if(party_id==2)
     {
     std::cout << "(Z-R) received from helper node of size "<<message.size() <<std::endl;
-    if(message.size()<=0)
-      {
-        std::cerr<<"Empty message received from party "<<party_id<<std::endl;
-        exit(1);
-      }
-    for (auto i = 0; i < k; ++i) {
-      auto temp = getuint64(message, i);
-      Z.push_back(temp);
-    }
-    // std::cout<<"\n\n";
-    if (Z.size() == k) {
-      operations();
-      operations_done_flag++;
+    const auto header = bulk_message::decode_header(message, bulk_message::MessageType::z_minus_r);
+    if (header.request_id != request_id || header.size != header.rows * header.cols) {
+      std::cerr<<"Received (Z-R) for request "<<header.request_id<<" with "<<header.size<<" values instead of request "<<request_id<<std::endl;
+      exit(1);
     }
+    Z.resize(header.size + 2);
+    Z[0] = header.rows;
+    Z[1] = header.cols;
+    bulk_message::copy_payload(message, 0, header.size, Z.data() + 2);
+    operations();
+    operations_done_flag++;
     }
   else if(party_id==0)
   { 
@@ -357,13 +344,16 @@ class TestMessageHandler : public MOTION::Communication::MessageHandler {
         boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
       }
     std::cout << "\nDEL_C0 received from party " << party_id << "of size \n";
-    std::vector<std::uint64_t>Final_public;
     std::cout <<"After receiving from Party 0 , message size is "<< message.size() << "\n"; 
-    for(int i=0;i<k;i++)
-    { 
-      auto temp = getuint64(message, i);
-      Final_public.push_back(temp);
+    const auto header = bulk_message::decode_header(message, bulk_message::MessageType::public_output);
+    if (header.request_id != request_id || header.size != Z.size() - 2) {
+      std::cerr<<"Received DEL_C0 of request "<<header.request_id<<" with "<<header.size<<" values, expected request "<<request_id<<" with "<<Z.size() - 2<<" values"<<std::endl;
+      exit(1);
     }
+    std::vector<std::uint64_t>Final_public(header.size + 2);
+    Final_public[0] = header.rows;
+    Final_public[1] = header.cols;
+    bulk_message::copy_payload(message, 0, header.size, Final_public.data() + 2);
     auto finalpublic_begin = Final_public.begin();
     auto finalpublic_end = Final_public.end();
     advance(finalpublic_begin,2);
@@ -417,6 +407,8 @@ class TestMessageHandler : public MOTION::Communication::MessageHandler {
       }
     config_file<<totalpath;
     config_file.close();
+    // the output of this layer is written
+    operations_done_flag++;
   }    
 } 
 };
@@ -471,8 +463,6 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
     }
 
     auto k = 0;
-    adduint64(rows, message);
-    adduint64(col, message);
     wpublic.push_back(rows);
     wpublic.push_back(col);
     wsecret.push_back(rows);
@@ -493,7 +483,6 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
         std::cerr << "Weight shares file contains less number of elements" << std::endl;
         exit(1);
       }
-      adduint64(secret_share, message);
       k++;
     }
     std::cout<<"Number of weight shares read: "<<k<<"\n"; 
@@ -506,6 +495,9 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
       }
     }
     file.close();
+    message = bulk_message::encode(
+        {bulk_message::MessageType::weight_shares, request_id, rows, col},
+        {std::span(wsecret).subspan(2)});
 
     file.open(bpath);
     if (!file) {
@@ -589,8 +581,6 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
       exit(1);
     }
     auto k = 0;
-    adduint64(rows, message);
-    adduint64(col, message);
     xpublic.push_back(rows);
     xpublic.push_back(col);
     xsecret.push_back(rows);
@@ -611,7 +601,6 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
         std::cerr << "File contains less number of elements" << std::endl;
         exit(1);
       }
-      adduint64(secret_share, message);
       k++;
       }
     if (k == rows * col) {
@@ -623,6 +612,9 @@ void read_shares(int choice,int my_id,std::vector<uint8_t>&message,const Options
         }
       }
     file.close();
+    message = bulk_message::encode(
+        {bulk_message::MessageType::input_shares, request_id, rows, col},
+        {std::span(xsecret).subspan(2)});
   }
 }
 
@@ -681,57 +673,74 @@ int main(int argc, char* argv[]) {
           [](auto party_id) { return std::make_shared<TestMessageHandler>(); }); 
 
     
-    read_shares(1,1,message1,*options);
-    read_shares(2,1,message2,*options);
+    // all layers are computed over the connections of this session, request_id = layer id
+    for(std::size_t layer_id=options->layer_id; layer_id<options->layer_id+options->num_layers; ++layer_id)
+    {
+      Options layer_options = *options;
+      layer_options.layer_id = layer_id;
+      if(layer_id>options->layer_id)
+        {
+          // wait until the ReLU step has written the input of this layer
+          std::string line;
+          if(!std::getline(std::cin, line))
+            {
+              std::cerr<<"Input closed before layer "<<layer_id<<std::endl;
+              return EXIT_FAILURE;
+            }
+          layer_options.input_file = "outputshare";
+        }
+      request_id = layer_id;
+      operations_done_flag = 0;
+      for(auto* v : {&wpublic, &wsecret, &bpublic, &bsecret, &xpublic, &xsecret})
+        {
+          v->clear();
+        }
+      message1.clear();
+      message2.clear();
 
-    //Waiting to receive the acknowledgement from helpernode
-    while(!helpernode_ready_flag)
-      {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
-      }
+      read_shares(1,1,message1,layer_options);
+      read_shares(2,1,message2,layer_options);
 
-    std::cout<<"Weights shares size: "<<message1.size()<<"\n";
-    std::cout<<"Input shares size: "<<message2.size()<<"\n";
+      //Waiting to receive the acknowledgement from helpernode
+      while(!helpernode_ready_flag)
+        {
+          std::cout<<".";
+          boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+        }
+
+      std::cout<<"Weights shares size: "<<message1.size()<<"\n";
+      std::cout<<"Input shares size: "<<message2.size()<<"\n";
     
-    std::cout<<"Sending Weights shares to the helper node\n";
-    try{
-      comm_layer->send_message(helpernode_id, message1);
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending the weight shares to helper node: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
+      std::cout<<"Sending Weights shares to the helper node\n";
+      try{
+        comm_layer->send_message(helpernode_id, message1);
+      }
+      catch (std::runtime_error& e) {
+        std::cerr << "Error occurred while sending the weight shares to helper node: " << e.what() << "\n";
+        return EXIT_FAILURE;
+      }
 
-    try{  
-      comm_layer->send_message(helpernode_id, message2);
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending the input shares to helper node: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
+      try{  
+        comm_layer->send_message(helpernode_id, message2);
+      }
+      catch (std::runtime_error& e) {
+        std::cerr << "Error occurred while sending the input shares to helper node: " << e.what() << "\n";
+        return EXIT_FAILURE;
+      }
 
 
       testMemoryOccupied(WriteToFiles,1, options->current_path);
       //Waiting for the operations to complete. 
-      while(operations_done_flag!=2)
+      // the handler of the other server's output message may already have set the flag to 3
+      while(operations_done_flag<2)
         {
           std::cout<<".";
           boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
         }
-      std::vector<std::uint8_t>mes1;
-      for(int i=0;i<Z.size();i++)
-      { 
-        //to push zth members first and condition checking is done to not push rows and columns twice
-        auto temp=Z[i];
-        adduint64(temp,mes1);
-        if(i>1)
-        { 
-          //to send secret shares
-          auto temp2=randomnum[i]; 
-          adduint64(temp2,mes1);
-        }
-      }
+      // public shares Z and then secret shares of party 1
+      auto mes1 = bulk_message::encode(
+          {bulk_message::MessageType::output_shares, request_id, Z[0], Z[1]},
+          {std::span(Z).subspan(2), std::span(randomnum).subspan(2)});
       std::cout<<"Sending DEL_C1 to the Party0\n";
       try{
       comm_layer->send_message(0,mes1);
@@ -740,6 +749,16 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error occurred while sending the output public share to Server-1: " << e.what() << "\n";
         return EXIT_FAILURE;
       }
+      //Waiting for the output shares of this layer to be written
+      while(operations_done_flag!=3)
+        {
+          boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+        }
+      std::cout<<"Layer "<<layer_id<<" done"<<std::endl;
+    }
+      // the helper node keeps running and waits for the end of the session before it disconnects
+      std::vector<std::uint8_t> ended{(std::uint8_t)0};
+      comm_layer->send_message(helpernode_id, ended);
       comm_layer->shutdown();
       auto stop = high_resolution_clock::now();
       auto duration = duration_cast<milliseconds>(stop - start);
@@ -1,4 +1,21 @@
-//./bin/server2
+//./bin/server2 --party 0,127.0.0.1,7000 --party 1,127.0.0.1,7001 --helper_node 127.0.0.1,7002
+//
+// The helper node is a long-lived service. In every session it connects to server 0 and server 1
+// and serves multiplication requests until both servers have sent the end of session message; then
+// it waits for the next session. Requests are keyed by the request id in front of every message, so
+// one session may carry the requests of several layers. --num-sessions stops it after that many
+// sessions (0 = serve forever).
+//
+// Every server sends a weight_shares message with its shares of W and an input_shares message with
+// its shares of X (see bulk_message.h). The reply is a z_minus_r message with Z - R to server 1,
+// where Z = (W0 + W1) * (X0 + X1). R is not
+// sent: the helper node sends a PRG seed to server 0 with the acknowledgement of each session, and
+// both expand R of a request from it (see bulk_message::expand_R).
+//
+// With --dealer-port, the helper node additionally deals the GEMM, convolution, and ReLU triples of
+// the tensor backend (see LinAlgTripleDealer) to servers started with --dealer, e.g.,
+// inference_engine: party i connects to port dealer-port + i and the triples of every run are dealt
+// on these connections until both parties close them.
 
 #include <bits/stdc++.h>
 #include <filesystem>
@@ -9,6 +26,8 @@
 #include "communication/communication_layer.h"
 #include "communication/message_handler.h"
 #include "communication/tcp_transport.h"
+#include "crypto/multiplication_triple/linalg_triple_provider.h"
+#include "crypto/random/aes128_ctr_rng.h"
 #include "utility/logger.h"
 
 #include <boost/algorithm/string.hpp>
@@ -23,19 +42,18 @@
 #include <iterator>
 #include <parallel/algorithm>
 #include <vector>
+#include "utility/linear_algebra.h"
 #include "utility/new_fixed_point.h"
 
-std::vector<std::uint64_t> x0, w0;
-std::vector<std::uint64_t> x1, w1;
-int c1 = 1, c2 = 1, c3 = 1, c4 = 1;
-bool operations_done_flag = false, server0_ready_flag = false, server1_ready_flag = false;
-std::uint64_t w_rows = 0, w_cols = 0, x_rows = 0, x_cols = 0;
-std::vector<std::uint8_t> msg_Z, msg_R;
+#include "bulk_message.h"
+
 namespace po = boost::program_options;
 
 struct Options {
   std::size_t my_id;
   std::uint16_t my_port;
+  std::size_t num_sessions;
+  std::uint16_t dealer_port;
   MOTION::Communication::tcp_parties_config tcp_config;
 };
 
@@ -49,6 +67,10 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
      "(party id, IP, port), e.g., --party 1,127.0.0.1,7777")
     ("helper_node", po::value<std::string>()->multitoken(),
      "(helpernode IP, port), e.g., --helper_node 127.0.0.1,7777") 
+    ("num-sessions", po::value<std::size_t>()->default_value(0),
+     "number of sessions to serve before exiting (0 = serve forever)")
+    ("dealer-port", po::value<std::uint16_t>()->default_value(0),
+     "deal the triples of the tensor backend to party i on this port + i (0 = do not deal triples)")
   ;
  
   po::variables_map vm;
@@ -110,6 +132,8 @@ std::optional<Options> parse_program_options(int argc, char* argv[]) {
   options.tcp_config[id0] = conn_info0;
   options.tcp_config[id1] = conn_info1;
   options.tcp_config[2] = conn_info_helpernode;
+  options.num_sessions = vm["num-sessions"].as<std::size_t>();
+  options.dealer_port = vm["dealer-port"].as<std::uint16_t>();
 
   // clang-format on;
   return options;
@@ -121,85 +145,66 @@ void print_message(std::vector<std::uint8_t>& message) {
   return;
 }
 
-void adduint64(std::uint64_t num, std::vector<std::uint8_t>& message) {
-  for (auto i = 0; i < sizeof(num); i++) {
-    std::uint8_t byte = num & 0xff;
-    message.push_back(byte);
-    num = num >> 8;
-  }
-}
-
-
-std::uint64_t getuint64(std::vector<std::uint8_t>& message, int index) {
-  std::uint64_t num = 0;
-  for (auto i = 0; i < 8; i++) {
-    num = num << 8;
-    num = num | message[(index + 1) * 8 - 1 - i];
-  }
-  return num;
-}
-
-template <typename E>
-std::uint64_t RandomNumGenerator(E &engine)
-{
-     std::uniform_int_distribution<unsigned long long> dis(
-         std::numeric_limits<std::uint64_t>::min(),
-         std::numeric_limits<std::uint64_t>::max());
-     return dis(engine);
-}
+using bulk_message::Seed;
+using bulk_message::expand_R;
 
+// Computes Z = W * X on the ring of 64-bit integers. W (rows x cols) and X (cols x batch, row-major)
+// are prefixed by their dimensions, and so is Z. X may consist of several input columns, e.g., a
+// batch of images, which are all multiplied in one cache-blocked and multithreaded GEMM.
 std::vector<std::uint64_t>multiplicate(std::vector<uint64_t>&w0,std::vector<uint64_t>&x0)
 {
-    //z=(256*784 * 784*1)= 256*1
+    //z=(256*784 * 784*B)= 256*B
     if(w0.size()<=2 || x0.size()<=2)
       {
-        std::cerr<<"Shares unavailable to perform computations. Weight shares size is "<<w0.size()<<"  and input shares size is "<<x0.size()<<std::endl;
-        exit(1);
+        throw std::runtime_error("Shares unavailable to perform computations. Weight shares size is " +
+                                 std::to_string(w0.size()) + " and input shares size is " +
+                                 std::to_string(x0.size()));
       }
-    
-    auto x0_begin = x0.begin();
-    advance(x0_begin, 2);
-
-    std::vector<std::uint64_t>z;// Output shares.
-    z.push_back(w0[0]); // Output row size = Weights row size
-    z.push_back(x0[1]); // Output column size =  Input column size
-
-    std::vector<std::uint64_t>tempw;
-    int count=2;
-    for(int i=0;i<w0[0];i++)
-    { 
-      tempw.push_back(w0[0]);
-      tempw.push_back(x0[1]);
-      for(int k=0;k<w0[1];k++)
+    const std::uint64_t rows = w0[0], cols = w0[1], batch = x0[1];
+    if(cols != x0[0] || w0.size() != rows * cols + 2 || x0.size() != cols * batch + 2)
       {
-        tempw.push_back(w0[count]);
-        count++;
+        throw std::runtime_error("Dimensions of the weight shares (" + std::to_string(rows) + "x" +
+                                 std::to_string(cols) + ") and the input shares (" +
+                                 std::to_string(x0[0]) + "x" + std::to_string(batch) +
+                                 ") do not match");
       }
-      auto tempw_begin=tempw.begin();
-      auto tempw_end=tempw.end();
-
-      advance(tempw_begin, 2);
-      __gnu_parallel::transform(tempw_begin, tempw_end, x0_begin, tempw_begin , std::multiplies{});
-      
-      std::uint64_t sum=0;
-      for(int j=2;j<tempw.size();j++)
-      {
-        sum+=tempw[j];
-      }
-      z.push_back(sum);
-      tempw.clear();
-    }
+
+    std::vector<std::uint64_t>z(rows * batch + 2);// Output shares.
+    z[0] = rows; // Output row size = Weights row size
+    z[1] = batch; // Output column size =  Input column size
+    MOTION::matrix_multiply(rows, cols, batch, w0.data() + 2, x0.data() + 2, z.data() + 2);
     return z;
-    
 }
 
 
-void operations()
-{   
+// Shares of one multiplication request received so far. matrices[i] holds the W and the X shares
+// of server i, each prefixed with its rows and columns.
+struct HelperRequest {
+  std::array<std::array<std::vector<std::uint64_t>, 2>, 2> matrices;
+
+  bool is_complete() const {
+    return std::all_of(matrices.begin(), matrices.end(), [](const auto& m) {
+      return !m[0].empty() && !m[1].empty();
+    });
+  }
+};
+
+// Computes Z = (W0 + W1) * (X0 + X1) and returns the z_minus_r message for server 1.
+std::vector<std::uint8_t> operations(std::uint64_t request_id, HelperRequest& request,
+                                     const Seed& seed)
+{
+  auto& w0 = request.matrices[0][0];
+  auto& x0 = request.matrices[0][1];
+  auto& w1 = request.matrices[1][0];
+  auto& x1 = request.matrices[1][1];
   if(w0.size()<=2 || x0.size()<=2 || w1.size()<=2 || x1.size()<=2)
     {
-      std::cerr<<"Shares unavailable to perform computations.\n";
-      exit(1);
+      throw std::runtime_error("Shares unavailable to perform computations");
+    }
+  if(w0.size()!=w1.size() || x0.size()!=x1.size())
+    {
+      throw std::runtime_error("Shares of server 0 and server 1 differ in size for request " +
+                               std::to_string(request_id));
     }
   auto w0_begin = w0.begin(); 
   auto w1_begin = w1.begin(); 
@@ -228,24 +233,18 @@ void operations()
   std::cout<<"w0:"<<*w0_begin<<"\n";
   
 
-  //z=(256*784 * 784*1)= 256*1
+  //z=(256*784 * 784*B)= 256*B
   std::vector<std::uint64_t>z=multiplicate(w0,x0);
 
   //-----------------------------------------------------------------------------------------------
-  std::cout<<"Computed Z=w0.x0 of size "<<z.size()<<"\n";
+  std::cout<<"Computed Z=w0.x0 of size "<<z.size()<<" for request "<<request_id<<"\n";
 
   std::vector<std::uint64_t>r;
-  r.resize(x0.size(),0);
-  r[0]=w0[0];
-  r[1]=x0[1];
+  r.resize(z.size(),0);
+  r[0]=z[0];
+  r[1]=z[1];
   
-  for(int i=2;i<z.size();i++)
-  { 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    auto temp=RandomNumGenerator(gen);
-    r[i]=temp;
-  }
+  expand_R(seed, request_id, r.data() + 2, r.size() - 2);
   std::cout<<"Generated Random value R of size "<<r.size()<<std::endl;
   auto r_begin = r.begin();
   advance(r_begin,2);
@@ -262,129 +261,158 @@ void operations()
 
 
   //Final output:-
-  //  std::cout<<"Final Output -:- \n";
-  for(int i=0;i<z.size();i++)
-  {
-  adduint64(z[i],msg_Z); //z=z-r  server1
-  adduint64(r[i],msg_R); //r  server0
-  }
-  operations_done_flag = true; 
+  return bulk_message::encode({bulk_message::MessageType::z_minus_r, request_id, z[0], z[1]},
+                              {std::span(z).subspan(2)}); //z=z-r  server1
 }
 
-class TestMessageHandler : public MOTION::Communication::MessageHandler {
-  void received_message(std::size_t party_id, std::vector<std::uint8_t>&&message) {
-    //layer 1 - (w0 -> 256*784, x0 ->784*1 server0),(w1 -> 256*784 , x1->784*1 server1)
-    //layer 2 - (w0 -> 10*256, x0 ->256*1 server0), (w1 -> 10*256 , x1->256*1 server1)
-    int size_msg=message.size()/8;
-    // To set the flags after the helper node receives start message from server 0 and server 1.
-    if(message.size()==1 && message[0]==(std::uint8_t)1)
-      {
-        if(party_id==0)
-          {
-            std::cout<<"Server 0 has started.\n";
-            server0_ready_flag = true;
-            return;
-          }
-        else if(party_id==1)
-          {
-            std::cout<<"Server 1 has started.\n";
-            server1_ready_flag = true;
-            return;
-          }
-        else
-          {
-            std::cerr<<"Received the message \"1\" from unknown party "<<party_id<<std::endl;
-            return;
-          }
-      }
-    while((!server0_ready_flag) || (!server1_ready_flag))
-      {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(400));
-      }
-    auto i=0;
-    for(i=1;i<size_msg;i++)
-    { 
-      auto temp=getuint64(message,i);
-      if(i==1 && c1==1 && party_id==0)
-      {
-          w_rows=getuint64(message,i-1);
-          w_cols=getuint64(message,i);
-          w0.push_back(w_rows);
-          w0.push_back(w_cols);
-          c1++;
-      }
-      else if(i==1 && c2==1 && party_id==1)
-      {
-          w_rows=getuint64(message,i-1);
-          w_cols=getuint64(message,i);
-          w1.push_back(w_rows);
-          w1.push_back(w_cols);
-          c2++;
-      }
-      else if(i==1 && c3==1 && party_id==0)
-      {
-          x_rows=getuint64(message,i-1);
-          x_cols=getuint64(message,i);
-          x0.push_back(x_rows);
-          x0.push_back(x_cols);
-          c3++;
-      }
-      else if(i==1 && c4==1 && party_id==1)
+// State of the helper node for one session with server 0 and server 1
+class HelperNode {
+ public:
+  HelperNode(MOTION::Communication::CommunicationLayer& comm_layer) : comm_layer_(comm_layer) {
+    AES128_CTR_RNG::get_thread_instance().random_blocks(seed_.data(), 1);
+  }
+
+  // seed from which the helper node and server 0 expand R in this session
+  const Seed& get_seed() const { return seed_; }
+
+  // Runs in the receiver thread of the communication layer. Errors are reported and fail the
+  // session instead of terminating the helper node.
+  void received_message(std::size_t party_id, std::vector<std::uint8_t>&& message) {
+    try {
+      handle_message(party_id, std::move(message));
+    }
+    catch (std::exception& e) {
+      std::cerr<<"Error occurred while handling a message of party "<<party_id<<": "<<e.what()<<std::endl;
+      std::scoped_lock lock(mutex_);
+      failed_ = true;
+      cv_.notify_all();
+    }
+  }
+
+  // Returns false if the session failed before both servers have started.
+  bool wait_for_start() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return failed_ || (started_[0] && started_[1]); });
+    return !failed_;
+  }
+
+  // Returns false if the session failed.
+  bool wait_for_end() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return failed_ || (ended_[0] && ended_[1]); });
+    if(!requests_.empty())
       {
-          x_rows=getuint64(message,i-1);
-          x_cols=getuint64(message,i);
-          x1.push_back(x_rows);
-          x1.push_back(x_cols);
-          c4++;
+        std::cerr<<requests_.size()<<" incomplete request(s) at the end of the session.\n";
       }
-      else if(c1>=2 && c1<=(w_cols*w_rows+1) && i>1 && party_id==0)
+    return !failed_;
+  }
+
+ private:
+  void handle_message(std::size_t party_id, std::vector<std::uint8_t>&& message) {
+    if(party_id>1)
       {
-          w0.push_back(temp);
-          c1++;
+        throw std::runtime_error("message from unknown party " + std::to_string(party_id));
       }
-      else if(c2>=2 && c2<=(w_cols*w_rows+1) && i>1 && party_id==1)
+    // To set the flags after the helper node receives start or end message from server 0 and server 1.
+    if(message.size()==1)
       {
-          w1.push_back(temp);
-          c2++;
+        std::scoped_lock lock(mutex_);
+        switch(message[0])
+          {
+          case 1:
+            std::cout<<"Server "<<party_id<<" has started.\n";
+            started_[party_id] = true;
+            break;
+          case 0:
+            std::cout<<"Server "<<party_id<<" has ended the session.\n";
+            ended_[party_id] = true;
+            break;
+          default:
+            throw std::runtime_error("unknown control message " + std::to_string(message[0]));
+          }
+        cv_.notify_all();
+        return;
       }
-      else if(c3>=2 && c3<=x_rows+1 && i>1 && party_id==0)
+    // index of the matrix in a request: W or X, depending on the message type
+    std::size_t matrix_index;
+    const auto type = bulk_message::get_type(message);
+    switch(type)
       {
-          x0.push_back(temp);
-          c3++;
+      case bulk_message::MessageType::weight_shares:
+        matrix_index = 0;
+        break;
+      case bulk_message::MessageType::input_shares:
+        matrix_index = 1;
+        break;
+      default:
+        throw std::runtime_error("unexpected bulk message of type " +
+                                 std::to_string(static_cast<std::uint64_t>(type)));
       }
-      else if(c4>=2 && c4<=x_rows+1 && i>1 && party_id==1)
+    const auto header = bulk_message::decode_header(message, type);
+    const std::uint64_t request_id = header.request_id;
+    if(header.size!=header.rows*header.cols || header.size==0)
       {
-          x1.push_back(temp);
-          c4++;
+        throw std::runtime_error("expected " + std::to_string(header.rows * header.cols) +
+                                 " shares but received " + std::to_string(header.size));
       }
+    std::vector<std::uint64_t> matrix(header.size+2);
+    matrix[0]=header.rows;
+    matrix[1]=header.cols;
+    bulk_message::copy_payload(message, 0, header.size, matrix.data()+2);
+
+    HelperRequest request;
+    {
+      std::scoped_lock lock(mutex_);
+      auto& pending = requests_[request_id];
+      if(!pending.matrices[party_id][matrix_index].empty())
+        {
+          throw std::runtime_error("duplicate shares for request " + std::to_string(request_id));
+        }
+      pending.matrices[party_id][matrix_index] = std::move(matrix);
+      if(!pending.is_complete())
+        {
+          return;
+        }
+      request = std::move(pending);
+      requests_.erase(request_id);
     }
-    // std::cout<<"W0 size="<<w0.size()<<" W1 size="<<w1.size()<<" X0 size="<<x0.size()<<" X1 size="<<x1.size()<<std::endl;
-    // std::cout<<"c1 : "<<c1<<" "<<"c2 : "<<c2<<" "<<"c3 : "<<c3<<" "<<"c4 : "<<c4<<"\n";
-    // std::cout<<"w_rows="<<w_rows<<" w_cols="<<w_cols<<std::endl;
-    if(c1==(w_cols*w_rows+2) && c2==(w_cols*w_rows+2) && c3==w_cols+2 && c4==w_cols+2)
-    { 
-      operations();
-    }
+
+    auto msg_Z = operations(request_id, request, seed_);
+    std::cout<<"Sending (Z-R) of size "<<msg_Z.size()<<" to party 1.\n";
+    comm_layer_.send_message(1,std::move(msg_Z));//z-r
   }
+
+  MOTION::Communication::CommunicationLayer& comm_layer_;
+  Seed seed_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::array<bool, 2> started_ = {false, false};
+  std::array<bool, 2> ended_ = {false, false};
+  bool failed_ = false;
+  std::unordered_map<std::uint64_t, HelperRequest> requests_;
 };
 
+class TestMessageHandler : public MOTION::Communication::MessageHandler {
+ public:
+  TestMessageHandler(std::shared_ptr<HelperNode> helper_node) : helper_node_(helper_node) {}
 
-int main(int argc, char* argv[]) {
-  std::cout<<"Started the helper node.\n";
+  void received_message(std::size_t party_id, std::vector<std::uint8_t>&&message) override {
+    helper_node_->received_message(party_id, std::move(message));
+  }
+
+ private:
+  std::shared_ptr<HelperNode> helper_node_;
+};
 
+// Serves one session: connects to server 0 and server 1 and answers their requests until both have
+// ended the session.
+int serve_session(const Options& options) {
   int my_id = 2;
-  auto options = parse_program_options(argc, argv);
-  if (!options.has_value()) {
-    std::cerr<<"No options given.\n";
-    return EXIT_FAILURE;
-  }
   std::unique_ptr<MOTION::Communication::CommunicationLayer> comm_layer;
-  std::shared_ptr<MOTION::Logger> logger;
   try{
       try{
         std::cout<<"Setting up the connections.";
-        MOTION::Communication::TCPSetupHelper helper(my_id, options->tcp_config);
+        MOTION::Communication::TCPSetupHelper helper(my_id, options.tcp_config);
         comm_layer = std::make_unique<MOTION::Communication::CommunicationLayer>(
             my_id, helper.setup_connections());
       }
@@ -392,14 +420,6 @@ int main(int argc, char* argv[]) {
       std::cerr << "Error occurred during connection setup: " << e.what() << "\n";
       return EXIT_FAILURE;
     }
-    // try{
-    // logger = std::make_shared<MOTION::Logger>(my_id, boost::log::trivial::severity_level::trace);
-    // comm_layer->set_logger(logger);
-    // }
-    // catch (std::runtime_error& e) {
-    //   std::cerr << "Error occurred during logger setup: " << e.what() << "\n";
-    //   return EXIT_FAILURE;
-    // }
     std::cout<<"Starting the communication layer\n";
     try{
       comm_layer->start();
@@ -409,14 +429,15 @@ int main(int argc, char* argv[]) {
       return EXIT_FAILURE;
     }
     std::cout<<"Start Receiving messages in parallel\n";
+    auto helper_node = std::make_shared<HelperNode>(*comm_layer);
     comm_layer->register_fallback_message_handler(
-        [](auto party_id) { return std::make_shared<TestMessageHandler>(); });
+        [helper_node](auto party_id) { return std::make_shared<TestMessageHandler>(helper_node); });
     
     //Waiting for server 0 and 1 to send their start messages. 
-    while((!server0_ready_flag) || (!server1_ready_flag))
+    if(!helper_node->wait_for_start())
       {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(400));
+        comm_layer->shutdown();
+        return EXIT_FAILURE;
       }
 
     // Sending acknowledgement message to server 0 and 1, after receiving the start message.
@@ -429,8 +450,12 @@ int main(int argc, char* argv[]) {
       std::cerr << "Error occurred while sending the ack message to server 1: " << e.what() << "\n";
       return EXIT_FAILURE;
     }
+    // server 0 additionally receives the seed for R
+    std::vector<std::uint8_t> ack_seed{(std::uint8_t)1};
+    std::transform(helper_node->get_seed().begin(), helper_node->get_seed().end(),
+                   std::back_inserter(ack_seed), [](auto b) { return std::uint8_t(b); });
     try{
-      comm_layer->send_message(0,ack);
+      comm_layer->send_message(0,ack_seed);
     }
     catch (std::runtime_error& e) {
       std::cerr << "Error occurred while sending the ack message to server 0: " << e.what() << "\n";
@@ -438,34 +463,94 @@ int main(int argc, char* argv[]) {
     }
     std::cout<<"Sent acknowledgement message to server 0 and 1\n";
 
-    //Waiting for the operations to complete before sending the results to the servers.
-    while(!operations_done_flag)
+    //Requests are answered by the message handlers until both servers end the session.
+    const bool success = helper_node->wait_for_end();
+    comm_layer->shutdown();
+    if(!success)
       {
-        std::cout<<".";
-        boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+        return EXIT_FAILURE;
       }
-    
-    std::cout<<"Sending (Z-R) of size "<<msg_Z.size()<<" to party 1.\n";
-    try{  
-      comm_layer->send_message(1,msg_Z);//z-r
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending (Z-R) to server 1: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
-    std::cout<<"Sending R of size "<<msg_R.size()<<" to party 0.\n";
-    try{
-    comm_layer->send_message(0,msg_R);//r
-    }
-    catch (std::runtime_error& e) {
-      std::cerr << "Error occurred while sending (R) to server 0: " << e.what() << "\n";
-      return EXIT_FAILURE;
-    }
-    comm_layer->shutdown();
   }
   catch (std::runtime_error& e) {
     std::cerr << "ERROR OCCURRED: " << e.what() << "\n";
     return EXIT_FAILURE;
   }
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+// Deals triples to one pair of connections of party 0 and party 1 at a time until the helper node
+// exits. Failed runs are retried after an increasing delay, the helper node exits if the dealer
+// ports cannot be bound.
+void serve_dealer(const Options& options) {
+  const auto& host = options.tcp_config[2].first;
+  // the dealer is party 0 of the connection to each party
+  const auto accept_party = [&host, &options](std::size_t party_id) {
+    MOTION::Communication::TCPSetupHelper helper(
+        0, {{host, static_cast<std::uint16_t>(options.dealer_port + party_id)}, {host, 0}});
+    return std::move(helper.setup_connections().at(1));
+  };
+  constexpr std::size_t min_retry_delay_ms = 100, max_retry_delay_ms = 10000;
+  std::size_t retry_delay_ms = min_retry_delay_ms;
+  while(true)
+    {
+      std::unique_ptr<MOTION::Communication::Transport> transport_0, transport_1;
+      try{
+        auto future_transport_1 = std::async(std::launch::async, accept_party, 1);
+        transport_0 = accept_party(0);
+        transport_1 = future_transport_1.get();
+      }
+      catch (boost::system::system_error& e) {
+        // raised while opening and binding the acceptors, retrying cannot succeed
+        std::cerr << "Unable to listen on the dealer ports: " << e.what() << "\n";
+        std::exit(EXIT_FAILURE);
+      }
+      catch (std::exception& e) {
+        std::cerr << "Error occurred while connecting to the parties: " << e.what() << "\n";
+      }
+      if(transport_0 && transport_1)
+        {
+          try{
+            MOTION::LinAlgTripleDealer dealer(*transport_0, *transport_1);
+            std::size_t num_runs = 0;
+            while(dealer.deal())
+              {
+                ++num_runs;
+              }
+            std::cout<<"Dealt the triples of "<<num_runs<<" run(s).\n";
+            transport_0->shutdown();
+            transport_1->shutdown();
+            retry_delay_ms = min_retry_delay_ms;
+            continue;
+          }
+          catch (std::exception& e) {
+            std::cerr << "Error occurred while dealing triples: " << e.what() << "\n";
+          }
+        }
+      std::cerr << "Retrying in " << retry_delay_ms << " ms.\n";
+      boost::this_thread::sleep_for(boost::chrono::milliseconds(retry_delay_ms));
+      retry_delay_ms = std::min(2 * retry_delay_ms, max_retry_delay_ms);
+    }
+}
+
+int main(int argc, char* argv[]) {
+  std::cout<<"Started the helper node.\n";
+
+  auto options = parse_program_options(argc, argv);
+  if (!options.has_value()) {
+    std::cerr<<"No options given.\n";
+    return EXIT_FAILURE;
+  }
+  if(options->dealer_port!=0)
+    {
+      std::thread(serve_dealer, *options).detach();
+    }
+  for(std::size_t session=0; options->num_sessions==0 || session<options->num_sessions; ++session)
+    {
+      std::cout<<"Waiting for session "<<session<<".\n";
+      if(serve_session(*options)!=EXIT_SUCCESS)
+        {
+          std::cerr<<"Session "<<session<<" failed.\n";
+        }
+    }
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 #include "circuit_loader.h"
 
 #include <algorithm>
+#include <array>
 #include <exception>
 #include <filesystem>
 #include <optional>
@@ -132,6 +133,58 @@ const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_relu_circuit(std::size
   return algo_cache_[name];
 }
 
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_add_msb_circuit(std::size_t bit_size) {
+  if (bit_size != 8 && bit_size != 16 && bit_size != 32 && bit_size != 64) {
+    throw std::logic_error(fmt::format("unsupported bit size: {}", bit_size));
+  }
+  const auto name = fmt::format("__circuit_loader_builtin__add_msb_{}_bit", bit_size);
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+  const auto& add_algo =
+      load_circuit(fmt::format("int_add{}_depth.bristol", bit_size), CircuitFormat::Bristol);
+  const auto num_inputs = 2 * bit_size;
+
+  // mark the wires the most significant output bit depends on, the gates are topologically sorted
+  std::vector<bool> needed(add_algo.n_wires_, false);
+  needed.at(add_algo.n_wires_ - 1) = true;
+  for (auto gate_it = add_algo.gates_.rbegin(); gate_it != add_algo.gates_.rend(); ++gate_it) {
+    if (needed.at(gate_it->output_wire_)) {
+      needed.at(gate_it->parent_a_) = true;
+      if (gate_it->parent_b_.has_value()) {
+        needed.at(*gate_it->parent_b_) = true;
+      }
+    }
+  }
+
+  // keep these gates and renumber their output wires consecutively after the inputs
+  std::vector<std::size_t> new_wire(add_algo.n_wires_);
+  for (std::size_t wire_i = 0; wire_i < num_inputs; ++wire_i) {
+    new_wire[wire_i] = wire_i;
+  }
+  std::vector<ENCRYPTO::PrimitiveOperation> gates;
+  for (const auto& op : add_algo.gates_) {
+    if (!needed.at(op.output_wire_)) {
+      continue;
+    }
+    auto& new_op = gates.emplace_back(op);
+    new_op.parent_a_ = new_wire.at(op.parent_a_);
+    if (op.parent_b_.has_value()) {
+      new_op.parent_b_ = new_wire.at(*op.parent_b_);
+    }
+    new_op.output_wire_ = new_wire.at(op.output_wire_) = num_inputs + gates.size() - 1;
+  }
+  assert(!gates.empty() && gates.back().output_wire_ == new_wire.at(add_algo.n_wires_ - 1));
+
+  ENCRYPTO::AlgorithmDescription algo{.n_output_wires_ = 1,
+                                      .n_input_wires_parent_a_ = num_inputs,
+                                      .n_wires_ = num_inputs + gates.size(),
+                                      .n_gates_ = gates.size(),
+                                      .gates_ = std::move(gates)};
+  return algo_cache_[name] = std::move(algo);
+}
+
 const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_gt_circuit(std::size_t bit_size,
                                                                      bool depth_optimized) {
   if (bit_size != 8 && bit_size != 16 && bit_size != 32 && bit_size != 64) {
@@ -390,4 +443,200 @@ const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_gt_tensor_circuit(std:
   return load_tree_circuit(name, bit_size, num_inputs);
 }
 
+const ENCRYPTO::AlgorithmDescription& CircuitLoader::load_argmax_circuit(std::size_t bit_size,
+                                                                         std::size_t num_inputs,
+                                                                         bool one_hot,
+                                                                         bool depth_optimized) {
+  if (num_inputs < 2) {
+    throw std::logic_error("need at least two inputs to combine");
+  }
+  std::size_t index_bits = 0;
+  while ((std::size_t(1) << index_bits) < num_inputs) {
+    ++index_bits;
+  }
+  if (!one_hot && index_bits > bit_size) {
+    throw std::logic_error(
+        fmt::format("cannot represent an index of {} inputs with {} bits", num_inputs, bit_size));
+  }
+
+  const auto name = fmt::format("__circuit_loader_builtin__argmax_{}_bit_{}_inputs_{}_{}", bit_size,
+                                num_inputs, one_hot ? "one_hot" : "index",
+                                depth_optimized ? "depth" : "size");
+  auto it = algo_cache_.find(name);
+  if (it != std::end(algo_cache_)) {
+    return it->second;
+  }
+  const auto& gt_algo = load_gt_circuit(bit_size, depth_optimized);
+
+  using ENCRYPTO::PrimitiveOperationType;
+  std::vector<ENCRYPTO::PrimitiveOperation> gates;
+  std::size_t wire_offset = bit_size * num_inputs;  // number of input wires
+  const auto add_gate = [&gates, &wire_offset](PrimitiveOperationType type, std::size_t parent_a,
+                                               std::optional<std::size_t> parent_b =
+                                                   std::nullopt) {
+    gates.push_back(ENCRYPTO::PrimitiveOperation{
+        .type_ = type, .parent_a_ = parent_a, .parent_b_ = parent_b, .output_wire_ = wire_offset});
+    return wire_offset++;
+  };
+
+  // index bits are tracked as constants as long as possible, which saves most of the AND gates of
+  // the first rounds
+  struct Bit {
+    bool is_constant;
+    bool value;
+    std::size_t wire;
+  };
+  const auto make_constant = [](bool value) { return Bit{true, value, 0}; };
+  const auto make_wire = [](std::size_t wire) { return Bit{false, false, wire}; };
+  const auto invert = [&](const Bit& x) {
+    return x.is_constant ? make_constant(!x.value)
+                         : make_wire(add_gate(PrimitiveOperationType::INV, x.wire));
+  };
+  const auto conjunction = [&](const Bit& x, const Bit& y) {
+    if (x.is_constant) {
+      return x.value ? y : x;
+    }
+    if (y.is_constant) {
+      return y.value ? x : y;
+    }
+    return make_wire(add_gate(PrimitiveOperationType::AND, x.wire, y.wire));
+  };
+  // c ? y : x
+  const auto select = [&](std::size_t c, const Bit& x, const Bit& y) {
+    if (x.is_constant && y.is_constant) {
+      if (x.value == y.value) {
+        return x;
+      }
+      return y.value ? make_wire(c) : make_wire(add_gate(PrimitiveOperationType::INV, c));
+    }
+    if (x.is_constant || y.is_constant) {
+      // c ? y : 0 = c & y and c ? 0 : x = !c & x
+      // c ? y : 1 = !(c & !y) and c ? 1 : x = !(!c & !x)
+      const auto c_bit = make_wire(c);
+      const auto guard = x.is_constant ? c_bit : invert(c_bit);
+      const auto& other = x.is_constant ? y : x;
+      if (!(x.is_constant ? x.value : y.value)) {
+        return conjunction(guard, other);
+      }
+      return invert(conjunction(guard, invert(other)));
+    }
+    const auto diff = add_gate(PrimitiveOperationType::XOR, x.wire, y.wire);
+    const auto masked = add_gate(PrimitiveOperationType::AND, diff, c);
+    return make_wire(add_gate(PrimitiveOperationType::XOR, x.wire, masked));
+  };
+
+  struct Candidate {
+    std::vector<std::size_t> value_wires;
+    std::vector<Bit> index;
+  };
+  std::vector<Candidate> candidates(num_inputs);
+  for (std::size_t i = 0; i < num_inputs; ++i) {
+    auto& candidate = candidates.at(i);
+    candidate.value_wires.resize(bit_size);
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      candidate.value_wires.at(bit_j) = bit_j * num_inputs + i;
+    }
+    for (std::size_t bit_j = 0; bit_j < index_bits; ++bit_j) {
+      candidate.index.push_back(make_constant((i >> bit_j) & 1));
+    }
+  }
+  const auto zero_wire = add_gate(PrimitiveOperationType::XOR, 0, 0);
+
+  // the later candidate b replaces a only if it is strictly greater
+  const auto play = [&](const Candidate& a, const Candidate& b) {
+    const auto gt_offset = wire_offset;
+    const auto map_wire = [&a, &b, bit_size, gt_offset](std::size_t w) {
+      if (w < bit_size) {
+        return b.value_wires.at(w);
+      } else if (w < 2 * bit_size) {
+        return a.value_wires.at(w - bit_size);
+      }
+      return w - 2 * bit_size + gt_offset;
+    };
+    std::transform(std::begin(gt_algo.gates_), std::end(gt_algo.gates_),
+                   std::back_inserter(gates), [&map_wire](ENCRYPTO::PrimitiveOperation op) {
+                     op.parent_a_ = map_wire(op.parent_a_);
+                     if (op.parent_b_.has_value()) {
+                       *op.parent_b_ = map_wire(*op.parent_b_);
+                     }
+                     op.output_wire_ = map_wire(op.output_wire_);
+                     return op;
+                   });
+    wire_offset += gt_algo.n_wires_ - 2 * bit_size;
+    const auto choice = map_wire(gt_algo.n_wires_ - 1);
+
+    Candidate winner;
+    winner.value_wires.resize(bit_size);
+    for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+      winner.value_wires.at(bit_j) =
+          select(choice, make_wire(a.value_wires.at(bit_j)), make_wire(b.value_wires.at(bit_j)))
+              .wire;
+    }
+    for (std::size_t bit_j = 0; bit_j < index_bits; ++bit_j) {
+      winner.index.push_back(select(choice, a.index.at(bit_j), b.index.at(bit_j)));
+    }
+    return winner;
+  };
+
+  // all matches of a round are independent, so the depth is logarithmic in num_inputs
+  while (candidates.size() > 1) {
+    std::vector<Candidate> winners;
+    for (std::size_t i = 0; i + 1 < candidates.size(); i += 2) {
+      winners.push_back(play(candidates.at(i), candidates.at(i + 1)));
+    }
+    if (candidates.size() % 2 == 1) {
+      winners.push_back(std::move(candidates.back()));
+    }
+    candidates = std::move(winners);
+  }
+  const auto& index = candidates.at(0).index;
+
+  std::vector<Bit> outputs;
+  if (one_hot) {
+    // decode the index, the terms of step k decode its lowest k + 1 bits
+    std::vector<Bit> terms{make_constant(true)};
+    for (std::size_t bit_k = 0; bit_k < index_bits; ++bit_k) {
+      const std::array<Bit, 2> literals = {invert(index.at(bit_k)), index.at(bit_k)};
+      const auto num_terms = std::min(num_inputs, std::size_t(1) << (bit_k + 1));
+      std::vector<Bit> next_terms;
+      for (std::size_t t = 0; t < num_terms; ++t) {
+        const auto& prefix = terms.at(t & ((std::size_t(1) << bit_k) - 1));
+        next_terms.push_back(conjunction(prefix, literals.at((t >> bit_k) & 1)));
+      }
+      terms = std::move(next_terms);
+    }
+    outputs.resize(bit_size * num_inputs, make_constant(false));
+    std::copy(std::begin(terms), std::end(terms), std::begin(outputs));
+  } else {
+    outputs.resize(bit_size, make_constant(false));
+    std::copy(std::begin(index), std::end(index), std::begin(outputs));
+  }
+
+  // the outputs have to be the last wires of the circuit
+  for (const auto& bit : outputs) {
+    if (!bit.is_constant) {
+      add_gate(PrimitiveOperationType::XOR, bit.wire, zero_wire);
+    } else if (bit.value) {
+      add_gate(PrimitiveOperationType::INV, zero_wire);
+    } else {
+      add_gate(PrimitiveOperationType::XOR, zero_wire, zero_wire);
+    }
+  }
+
+  ENCRYPTO::AlgorithmDescription algo{.n_output_wires_ = outputs.size(),
+                                      .n_input_wires_parent_a_ = bit_size * num_inputs,
+                                      .n_wires_ = wire_offset,
+                                      .n_gates_ = gates.size(),
+                                      .gates_ = std::move(gates)};
+  for (std::size_t i = 0; i < algo.n_gates_; ++i) {
+    [[maybe_unused]] const auto& op = algo.gates_.at(i);
+    assert(op.parent_a_ < op.output_wire_);
+    assert(!op.parent_b_.has_value() || *op.parent_b_ < op.output_wire_);
+    assert(op.output_wire_ < algo.n_wires_);
+  }
+
+  algo_cache_[name] = std::move(algo);
+  return algo_cache_[name];
+}
+
 }  // namespace MOTION
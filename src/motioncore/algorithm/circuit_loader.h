@@ -42,6 +42,10 @@ class CircuitLoader {
   ~CircuitLoader();
   const ENCRYPTO::AlgorithmDescription& load_circuit(std::string name, CircuitFormat);
   const ENCRYPTO::AlgorithmDescription& load_relu_circuit(std::size_t bit_size);
+  // most significant bit of the sum of two bit_size bit integers (wires 0 to bit_size - 1 and
+  // bit_size to 2 * bit_size - 1), i.e., the depth-optimized adder reduced to the gates that its
+  // last output depends on
+  const ENCRYPTO::AlgorithmDescription& load_add_msb_circuit(std::size_t bit_size);
   const ENCRYPTO::AlgorithmDescription& load_gt_circuit(std::size_t bit_size,
                                                         bool depth_optimized = false);
   const ENCRYPTO::AlgorithmDescription& load_gtmod_circuit(std::size_t bit_size,
@@ -57,6 +61,15 @@ class CircuitLoader {
   const ENCRYPTO::AlgorithmDescription& load_gt_tensor_circuit(std::size_t bit_size,
                                                              std::size_t num_inputs,
                                                              bool depth_optimized = false);
+  // argmax of num_inputs signed values as a pairwise tournament of logarithmic depth; the first
+  // maximum wins ties
+  // input and output wires are ordered bit-major, i.e., wire bit_j * num_inputs + i holds bit j of
+  // value i, so that they match the key/share layout of a tensor
+  // outputs either the zero-padded index (bit_size wires) or a one-hot vector (bit_size *
+  // num_inputs wires, only bit 0 of each element can be set)
+  const ENCRYPTO::AlgorithmDescription& load_argmax_circuit(std::size_t bit_size,
+                                                            std::size_t num_inputs, bool one_hot,
+                                                            bool depth_optimized = false);
 
  private:
   std::vector<std::filesystem::path> circuit_search_path_;
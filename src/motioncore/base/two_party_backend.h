@@ -84,6 +84,8 @@ class TwoPartyBackend : public CircuitBuilder {
   GateFactory& get_gate_factory(MPCProtocol proto) override;
 
   const Statistics::RunTimeStats& get_run_time_stats() const noexcept;
+  // allows to carry base OTs over to later sessions
+  BaseOTProvider& get_base_ot_provider() noexcept { return *base_ot_provider_; }
 
  private:
   Communication::CommunicationLayer& comm_layer_;
@@ -104,14 +104,36 @@ TwoPartyTensorBackend::TwoPartyTensorBackend(Communication::CommunicationLayer&
 
 TwoPartyTensorBackend::~TwoPartyTensorBackend() = default;
 
+void TwoPartyTensorBackend::set_linalg_triple_provider(
+    std::shared_ptr<LinAlgTripleProvider> linalg_triple_provider) {
+  linalg_triple_provider_ = linalg_triple_provider;
+  gmw_provider_->set_linalg_triple_provider(linalg_triple_provider_);
+  beavy_provider_->set_linalg_triple_provider(linalg_triple_provider_);
+}
+
 void TwoPartyTensorBackend::run_preprocessing() {
   run_time_stats_.back().record_start<Statistics::RunTimeStats::StatID::preprocessing>();
 
   motion_base_provider_->setup();
+  base_ot_provider_->VerifyBaseOTState();
   base_ot_provider_->ComputeBaseOTs();
   mt_provider_->PreSetup();
   sp_provider_->PreSetup();
   sb_provider_->PreSetup();
+  if (!base_ot_state_file_.empty()) {
+    // write-ahead: store the offsets after the OT extension before running it
+    const auto num_parties = comm_layer_.get_num_parties();
+    std::vector<std::pair<std::size_t, std::size_t>> reserved_blocks(num_parties);
+    for (std::size_t party_id = 0; party_id < num_parties; ++party_id) {
+      if (party_id == my_id_) {
+        continue;
+      }
+      auto& ot_provider = ot_manager_->get_provider(party_id);
+      reserved_blocks.at(party_id) = {ot_provider.GetNumBaseOTBlocksSender(),
+                                      ot_provider.GetNumBaseOTBlocksReceiver()};
+    }
+    base_ot_provider_->SaveBaseOTs(base_ot_state_file_, reserved_blocks);
+  }
   ot_manager_->run_setup();
   linalg_triple_provider_->setup();
   mt_provider_->Setup();
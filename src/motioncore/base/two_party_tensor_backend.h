@@ -23,6 +23,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -88,6 +89,16 @@ class TwoPartyTensorBackend : public tensor::NetworkBuilder {
   std::optional<MPCProtocol> convert_via(MPCProtocol src_proto, MPCProtocol dst_proto) override;
 
   const Statistics::RunTimeStats& get_run_time_stats() const noexcept;
+  // allows to carry base OTs over to later sessions
+  BaseOTProvider& get_base_ot_provider() noexcept { return *base_ot_provider_; }
+  // the base OTs are stored in this file before the OT extension of the
+  // preprocessing consumes them (empty = do not store them)
+  void set_base_ot_state_file(std::string path) { base_ot_state_file_ = std::move(path); }
+  // replaces the provider of GEMM, convolution, and ReLU triples, e.g., by a
+  // DealerLinAlgTripleProvider; must be called before the network is built.
+  // The BEAVY GEMM uses it only if set here, otherwise it runs its own
+  // OT-based multiplications
+  void set_linalg_triple_provider(std::shared_ptr<LinAlgTripleProvider>);
 
  protected:
   Communication::CommunicationLayer& comm_layer_;
@@ -99,6 +110,7 @@ class TwoPartyTensorBackend : public tensor::NetworkBuilder {
   std::unordered_map<MPCProtocol, std::reference_wrapper<tensor::TensorOpFactory>>
       tensor_op_factories_;
   std::vector<Statistics::RunTimeStats> run_time_stats_;
+  std::string base_ot_state_file_;
 
   std::unique_ptr<Crypto::MotionBaseProvider> motion_base_provider_;
   std::unique_ptr<BaseOTProvider> base_ot_provider_;
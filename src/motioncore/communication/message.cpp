@@ -76,6 +76,10 @@ std::string to_string(MessageType message_type) {
       return "MessageType::SharedBitsMask"s;
     case MessageType::SharedBitsReconstruct:
       return "MessageType::SharedBitsReconstruct"s;
+    case MessageType::BaseOTState:
+      return "MessageType::BaseOTState"s;
+    case MessageType::ApplicationMessage:
+      return "MessageType::ApplicationMessage"s;
     default:
       return "Unknown MessageType => update to_string function"s;
   }
@@ -1,6 +1,9 @@
 #include "compute_server.h"
 #include <boost/asio.hpp>
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include "crypto/random/aes128_ctr_rng.h"
 
 using namespace boost::asio;
 using ip::tcp;
@@ -78,52 +81,61 @@ std::vector<std::pair<uint64_t, uint64_t>> get_provider_data(int port_number) {
 // }
 
 std::vector<Shares> read_struct(tcp::socket& socket, int num_elements) {
-  cout << "Before reading of data\n";
-  std::vector<Shares> data;
-  for (int i = 0; i < num_elements; i++) {
-    boost::system::error_code ec;
-    uint64_t arr[2];
-    read(socket, boost::asio::buffer(&arr, sizeof(arr)), ec);
-    Shares temp;
-    temp.Delta = arr[0];
-    // std::cout << temp.Delta << " ";
-    temp.delta = arr[1];
-    // std::cout << temp.delta << "\n";
-    data.push_back(temp);
-  }
-
+  std::vector<Shares> data = read_struct_vector(socket, num_elements);
   socket.close();
   return data;
 }
 
+// Reads the shares in chunks of at most shares_per_chunk shares straight into the result, so that
+// a chunk is available as soon as it has arrived and no copy of the full payload is staged.
 std::vector<Shares> read_struct_vector(tcp::socket& socket, int num_elements) {
+  static_assert(sizeof(Shares) == 2 * sizeof(uint64_t));
+  constexpr int shares_per_chunk = 1 << 14;
   std::cout << "Before reading of data\n";
-  std::vector<Shares> data;
+  std::vector<Shares> data(num_elements);
   boost::system::error_code ec;
-  uint64_t arr[2 * num_elements];
-  read(socket, boost::asio::buffer(&arr, sizeof(arr)), ec);
-  if (ec) {
-    std::cout << "Error:" << ec.message() << "\n";
-  } else {
-    cout << "Received successfully \n";
+  for (int offset = 0; offset < num_elements && !ec; offset += shares_per_chunk) {
+    int chunk_size = std::min(shares_per_chunk, num_elements - offset);
+    read(socket, boost::asio::buffer(data.data() + offset, chunk_size * sizeof(Shares)), ec);
   }
-  int j = 0;
-  cout << "Num element\n";
-  for (int i = 0; i < num_elements; i++) {
-    Shares temp;
-    temp.Delta = arr[j];
-    // std::cout << temp.Delta << " ";
-    j++;
-    temp.delta = arr[j];
-    j++;
-    // std::cout << temp.delta << "\n";
-    data.push_back(temp);
+  if (ec) {
+    // a partially received payload must not be handed out as zero-filled shares
+    throw boost::system::system_error(ec);
   }
+  cout << "Received successfully \n";
 
   // socket.close();
   return data;
 }
 
+std::vector<Shares> read_seed_compressed(tcp::socket& socket, int num_elements) {
+  std::cout << "Before reading of seed-compressed data\n";
+  boost::system::error_code ec;
+  std::array<std::byte, AES128_CTR_RNG::block_size> seed;
+  std::vector<uint64_t> Deltas(num_elements);
+  std::array<boost::asio::mutable_buffer, 2> buffers = {
+      boost::asio::buffer(seed), boost::asio::buffer(Deltas)};
+  read(socket, buffers, ec);
+  if (ec) {
+    // a partially received seed must not be expanded into shares
+    throw boost::system::system_error(ec);
+  }
+  cout << "Received successfully \n";
+
+  // expand the seed to this server's delta values
+  std::vector<uint64_t> deltas(num_elements);
+  AES128_CTR_RNG rng;
+  rng.set_key(seed.data());
+  rng.random_bytes(reinterpret_cast<std::byte*>(deltas.data()), num_elements * sizeof(uint64_t));
+
+  std::vector<Shares> data(num_elements);
+  for (int i = 0; i < num_elements; i++) {
+    data[i].Delta = Deltas[i];
+    data[i].delta = deltas[i];
+  }
+  return data;
+}
+
 std::pair<std::vector<Shares>, int> get_provider_dot_product_data(int port_number) {
   boost::asio::io_service io_service;
 
@@ -205,19 +217,8 @@ int get_actual_answer(int port_number) {
 
 //////////////// New function end ///////////////////////////////////
 
-std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> get_provider_mat_mul_data(
-    int port_number) {
-  boost::asio::io_service io_service;
-
-  // listen for new connection
-  tcp::acceptor acceptor_(io_service, tcp::endpoint(tcp::v4(), port_number));
-
-  // socket creation
-  tcp::socket socket_(io_service);
-
-  // waiting for the connection
-  acceptor_.accept(socket_);
-
+std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> receive_mat_mul_data(
+    tcp::socket& socket_, bool seed_compressed) {
   // Read and write the number of fractional bits
   boost::system::error_code ec;
   size_t fractional_bits;
@@ -254,13 +255,35 @@ std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> get_pro
   cout << "server sent message to Client!" << endl;
 
   // Read the data in the reuired format
-  std::vector<Shares> data = read_struct(socket_, num_elements);
+  std::vector<Shares> data;
+  if (seed_compressed) {
+    data = read_seed_compressed(socket_, num_elements);
+    socket_.close();
+  } else {
+    data = read_struct(socket_, num_elements);
+  }
 
   std::cout << "Finished reading input \n\n";
 
   return std::make_pair(fractional_bits, std::make_pair(data, dims));
 }
 
+std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> get_provider_mat_mul_data(
+    int port_number, bool seed_compressed) {
+  boost::asio::io_service io_service;
+
+  // listen for new connection
+  tcp::acceptor acceptor_(io_service, tcp::endpoint(tcp::v4(), port_number));
+
+  // socket creation
+  tcp::socket socket_(io_service);
+
+  // waiting for the connection
+  acceptor_.accept(socket_);
+
+  return receive_mat_mul_data(socket_, seed_compressed);
+}
+
 // std::tuple<int, std::size_t, std::pair<std::vector<Shares>, std::vector<int>>>
 // get_provider_mat_mul_data_new(int port_number) {
 //   boost::asio::io_service io_service;
@@ -565,18 +588,7 @@ get_provider_mat_mul_const_data(int port_number) {
 //////////////////Function to receive all vectors one shot, Ramya may 3,2023
 std::tuple<int, std::size_t,
            std::pair<std::vector<std::vector<Shares>>, std::vector<std::pair<int, int>>>>
-get_provider_total_data_genr(int port_number) {
-  // cout << "Inside new function \n";
-  boost::asio::io_service io_service;
-
-  // listen for new connection
-  tcp::acceptor acceptor_(io_service, tcp::endpoint(tcp::v4(), port_number));
-
-  // socket creation
-  tcp::socket socket_(io_service);
-
-  // waiting for the connection
-  acceptor_.accept(socket_);
+receive_total_data_genr(tcp::socket& socket_, bool seed_compressed) {
   boost::system::error_code ec;
   size_t fractional_bits;
   int numberOfLayers;
@@ -634,7 +646,11 @@ get_provider_total_data_genr(int port_number) {
 
     // Read the data in the required format
     cout << "Before read struct vector " << endl;
-    data.push_back(read_struct_vector(socket_, num_elements1));
+    if (seed_compressed) {
+      data.push_back(read_seed_compressed(socket_, num_elements1));
+    } else {
+      data.push_back(read_struct_vector(socket_, num_elements1));
+    }
     boost::asio::write(socket_, boost::asio::buffer(msg_data));
     // cout << "Servent sent w1 to Client!" << endl;
     std::cout << "Finished reading input W1\n";
@@ -648,4 +664,21 @@ get_provider_total_data_genr(int port_number) {
   return {numberOfLayers, fractional_bits, std::make_pair(data, dims_of_all_shares)};
 }
 
+std::tuple<int, std::size_t,
+           std::pair<std::vector<std::vector<Shares>>, std::vector<std::pair<int, int>>>>
+get_provider_total_data_genr(int port_number, bool seed_compressed) {
+  boost::asio::io_service io_service;
+
+  // listen for new connection
+  tcp::acceptor acceptor_(io_service, tcp::endpoint(tcp::v4(), port_number));
+
+  // socket creation
+  tcp::socket socket_(io_service);
+
+  // waiting for the connection
+  acceptor_.accept(socket_);
+
+  return receive_total_data_genr(socket_, seed_compressed);
+}
+
 }  // namespace COMPUTE_SERVER
@@ -14,10 +14,17 @@ string read_(tcp::socket& socket);
 void send_(tcp::socket& socket, const string& message);
 std::vector<Shares> read_struct(tcp::socket& socket, int num_elements);
 std::vector<Shares> read_struct_vector(tcp::socket& socket, int num_elements);
+// Reads a seed-compressed share: a PRG seed followed by the public Delta values.
+// delta is obtained by expanding the seed with AES128_CTR_RNG. Throws
+// boost::system::system_error if the connection fails before all data arrived.
+std::vector<Shares> read_seed_compressed(tcp::socket& socket, int num_elements);
 std::vector<std::pair<uint64_t, uint64_t>> get_provider_data(int port_number);
 std::pair<std::vector<Shares>, int> get_provider_dot_product_data(int port_number);
+// receive_* run the provider protocols on an accepted connection, get_provider_* accept it first
+std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> receive_mat_mul_data(
+    tcp::socket& socket, bool seed_compressed = false);
 std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>> get_provider_mat_mul_data(
-    int port_number);
+    int port_number, bool seed_compressed = false);
 std::tuple<int, std::size_t, std::pair<std::vector<Shares>, std::vector<int>>>
     get_provider_mat_mul_data_new(int port_number);
 std::tuple<int, std::size_t,
@@ -27,5 +34,8 @@ std::pair<std::size_t, std::pair<std::vector<Shares>, std::vector<int>>>
     get_provider_mat_mul_const_data(int port_number);
 std::tuple<int, std::size_t,
            std::pair<std::vector<std::vector<Shares>>, std::vector<std::pair<int, int>>>>
-    get_provider_total_data_genr(int port_number);
+    receive_total_data_genr(tcp::socket& socket, bool seed_compressed = false);
+std::tuple<int, std::size_t,
+           std::pair<std::vector<std::vector<Shares>>, std::vector<std::pair<int, int>>>>
+    get_provider_total_data_genr(int port_number, bool seed_compressed = false);
 }  // namespace COMPUTE_SERVER
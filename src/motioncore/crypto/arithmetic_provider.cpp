@@ -22,6 +22,7 @@
 
 #include "arithmetic_provider.h"
 
+#include <numeric>
 #include <stdexcept>
 #include <vector>
 
@@ -33,6 +34,33 @@
 
 namespace MOTION {
 
+namespace {
+
+// output[i, k] = sum_j products[i, j, k] for the (l x m x n) tensor of products of a matrix
+// multiplication with dimensions dims = {l, m, n}
+template <typename T>
+void sum_matrix_products(const std::array<std::size_t, 3>& dims, std::vector<T>& products,
+                         std::vector<T>& output) {
+  assert(products.size() == dims[0] * dims[1] * dims[2]);
+  output.resize(dims[0] * dims[2]);
+  if (dims[2] == 1) {
+    // matrix times vector: the products of each output are contiguous
+    for (std::size_t i = 0; i < dims[0]; ++i) {
+      const auto row = std::begin(products) + i * dims[1];
+      output[i] = std::accumulate(row, row + dims[1], T(0));
+    }
+    return;
+  }
+  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
+  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
+  Eigen::TensorMap<TensorType3> input_tensor(products.data(), dims[0], dims[1], dims[2]);
+  Eigen::TensorMap<TensorType2> output_tensor(output.data(), dims[0], dims[2]);
+  Eigen::array<Eigen::Index, 1> reduction_dimensions = {1};
+  output_tensor = input_tensor.sum(reduction_dimensions);
+}
+
+}  // namespace
+
 // ---------- BitIntegerMultiplicationIntSide ----------
 
 template <typename T>
@@ -346,13 +374,7 @@ template <typename T>
 void MatrixMultiplicationRHS<T>::compute_output() {
   mult_sender_->compute_outputs();
   auto mult_output = mult_sender_->get_outputs();
-  output_.resize(dims_[0] * dims_[2]);
-  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
-  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  Eigen::TensorMap<TensorType3> input_tensor(mult_output.data(), dims_[0], dims_[1], dims_[2]);
-  Eigen::TensorMap<TensorType2> output_tensor(output_.data(), dims_[0], dims_[2]);
-  Eigen::array<Eigen::Index, 1> reduction_dimensions = {1};
-  output_tensor = input_tensor.sum(reduction_dimensions);
+  sum_matrix_products(dims_, mult_output, output_);
   is_output_ready_ = true;
 }
 
@@ -408,13 +430,7 @@ void MatrixMultiplicationLHS<T>::compute_output() {
   mult_receiver_->compute_outputs();
   auto mult_output = mult_receiver_->get_outputs();
   assert(mult_output.size() == dims_[0] * dims_[1] * dims_[2]);
-  output_.resize(dims_[0] * dims_[2]);
-  using TensorType2 = Eigen::Tensor<T, 2, Eigen::RowMajor>;
-  using TensorType3 = Eigen::Tensor<T, 3, Eigen::RowMajor>;
-  Eigen::TensorMap<TensorType3> input_tensor(mult_output.data(), dims_[0], dims_[1], dims_[2]);
-  Eigen::TensorMap<TensorType2> output_tensor(output_.data(), dims_[0], dims_[2]);
-  Eigen::array<Eigen::Index, 1> reduction_dimensions = {1};
-  output_tensor = input_tensor.sum(reduction_dimensions);
+  sum_matrix_products(dims_, mult_output, output_);
   is_output_ready_ = true;
 }
 
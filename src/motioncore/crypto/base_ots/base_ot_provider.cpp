@@ -22,12 +22,21 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "base/configuration.h"
 #include "base/register.h"
 #include "base_ot_provider.h"
 #include "communication/communication_layer.h"
 #include "communication/fbs_headers/base_ot_generated.h"
 #include "communication/fbs_headers/message_generated.h"
+#include "communication/message.h"
 #include "communication/message_handler.h"
 #include "crypto/base_ots/ot_hl17.h"
 #include "data_storage/base_ot_data.h"
@@ -72,6 +81,48 @@ void BaseOTMessageHandler::received_message(std::size_t, std::vector<std::uint8_
   }
 }
 
+// number of values in a BaseOTState message: receiver ready, receiver offset, sender ready, sender
+// offset
+static constexpr std::size_t base_ot_state_size = 4;
+
+// Handler for messages of type BaseOTState
+class BaseOTStateMessageHandler : public Communication::MessageHandler {
+ public:
+  BaseOTStateMessageHandler(std::shared_ptr<Logger> logger,
+                            std::promise<std::vector<std::uint64_t>> &state_promise)
+      : logger_(logger), state_promise_(state_promise) {}
+
+  void received_message(std::size_t, std::vector<std::uint8_t> &&message) override;
+
+ private:
+  std::shared_ptr<Logger> logger_;
+  std::promise<std::vector<std::uint64_t>> &state_promise_;
+};
+
+void BaseOTStateMessageHandler::received_message(std::size_t party_id,
+                                                 std::vector<std::uint8_t> &&raw_message) {
+  assert(!raw_message.empty());
+  auto message = Communication::GetMessage(raw_message.data());
+  auto payload = message->payload();
+  // a malformed message yields an empty state, which never matches ours
+  std::vector<std::uint64_t> state;
+  if (payload->size() == base_ot_state_size * sizeof(std::uint64_t)) {
+    state.resize(base_ot_state_size);
+    std::memcpy(state.data(), payload->data(), payload->size());
+  } else if (logger_) {
+    logger_->LogError(fmt::format("received BaseOTState message from party {} with invalid size {}",
+                                  party_id, payload->size()));
+  }
+  try {
+    state_promise_.set_value(std::move(state));
+  } catch (std::future_error &) {
+    if (logger_) {
+      logger_->LogError(
+          fmt::format("received more than one BaseOTState message from party {}", party_id));
+    }
+  }
+}
+
 // Implementation of BaseOTProvider: -------------------------------------------
 
 BaseOTProvider::BaseOTProvider(Communication::CommunicationLayer &communication_layer,
@@ -83,19 +134,65 @@ BaseOTProvider::BaseOTProvider(Communication::CommunicationLayer &communication_
       data_(num_parties_),
       stats_(stats),
       logger_(logger),
-      finished_(false) {
+      finished_(false),
+      state_promises_(num_parties_) {
   communication_layer_.register_message_handler(
       [this, &logger](auto party_id) {
         return std::make_shared<BaseOTMessageHandler>(party_id, logger, data_.at(party_id));
       },
       {Communication::MessageType::BaseROTMessageSender,
        Communication::MessageType::BaseROTMessageReceiver});
+  communication_layer_.register_message_handler(
+      [this, &logger](auto party_id) {
+        return std::make_shared<BaseOTStateMessageHandler>(logger, state_promises_.at(party_id));
+      },
+      {Communication::MessageType::BaseOTState});
 }
 
 BaseOTProvider::~BaseOTProvider() {
   communication_layer_.deregister_message_handler(
       {Communication::MessageType::BaseROTMessageSender,
-       Communication::MessageType::BaseROTMessageReceiver});
+       Communication::MessageType::BaseROTMessageReceiver,
+       Communication::MessageType::BaseOTState});
+}
+
+void BaseOTProvider::VerifyBaseOTState() {
+  const auto get_state = [this](std::size_t party_id) {
+    const auto &base_ots_data = data_.at(party_id);
+    const auto &rcv_data = base_ots_data.GetReceiverData();
+    const auto &snd_data = base_ots_data.GetSenderData();
+    return std::vector<std::uint64_t>{rcv_data.is_ready_, rcv_data.consumed_offset_,
+                                      snd_data.is_ready_, snd_data.consumed_offset_};
+  };
+
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    const auto state = get_state(party_id);
+    communication_layer_.send_message(
+        party_id,
+        Communication::BuildMessage(Communication::MessageType::BaseOTState,
+                                    reinterpret_cast<const std::uint8_t *>(state.data()),
+                                    state.size() * sizeof(std::uint64_t)));
+  }
+
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    const auto state = get_state(party_id);
+    const auto other_state = state_promises_.at(party_id).get_future().get();
+    // our receiver data pairs with the sender data of the other party and vice versa
+    const std::vector<std::uint64_t> expected_state{state.at(2), state.at(3), state.at(0),
+                                                    state.at(1)};
+    if (other_state != expected_state) {
+      throw std::runtime_error(fmt::format(
+          "Base OT state does not match the one of party {}: both parties need to start from "
+          "base OTs of the same session (or none), delete the state files to recompute them",
+          party_id));
+    }
+  }
 }
 
 void BaseOTProvider::ComputeBaseOTs() {
@@ -184,6 +281,7 @@ void BaseOTProvider::ImportBaseOTs(std::size_t party_id, const ReceiverMsgs &msg
 
   rcv_data.c_ = msgs.c_;
   rcv_data.messages_c_ = msgs.messages_c_;
+  rcv_data.consumed_offset_ = msgs.consumed_offset_;
 
   {
     std::scoped_lock lock(rcv_data.is_ready_condition_->GetMutex());
@@ -200,6 +298,7 @@ void BaseOTProvider::ImportBaseOTs(std::size_t party_id, const SenderMsgs &msgs)
 
   snd_data.messages_0_ = msgs.messages_0_;
   snd_data.messages_1_ = msgs.messages_1_;
+  snd_data.consumed_offset_ = msgs.consumed_offset_;
 
   {
     std::scoped_lock lock(snd_data.is_ready_condition_->GetMutex());
@@ -228,11 +327,153 @@ std::pair<ReceiverMsgs, SenderMsgs> BaseOTProvider::ExportBaseOTs(std::size_t pa
 
   std::get<0>(base_ots).c_ = rcv_data.c_;
   std::get<0>(base_ots).messages_c_ = rcv_data.messages_c_;
+  std::get<0>(base_ots).consumed_offset_ = rcv_data.consumed_offset_;
 
   std::get<1>(base_ots).messages_0_ = snd_data.messages_0_;
   std::get<1>(base_ots).messages_1_ = snd_data.messages_1_;
+  std::get<1>(base_ots).consumed_offset_ = snd_data.consumed_offset_;
 
   return base_ots;
 }
 
+// layout of the state file:
+//   magic | my_id | num_parties | for each other party:
+//   choice bits | messages_c | receiver offset | messages_0 | messages_1 | sender offset
+static constexpr std::array<char, 8> base_ot_state_magic = {'M', 'O', 'T', 'B', 'O', 'T', '0', '1'};
+
+// flush a file or directory to the disk
+static void sync_path(const std::string &path, int flags) {
+  const int fd = ::open(path.c_str(), flags);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("Could not open {} for syncing", path));
+  }
+  const int result = ::fsync(fd);
+  ::close(fd);
+  if (result != 0) {
+    throw std::runtime_error(fmt::format("Could not sync {} to the disk", path));
+  }
+}
+
+void BaseOTProvider::SaveBaseOTs(
+    const std::string &path, const std::vector<std::pair<std::size_t, std::size_t>> &reserved_blocks) {
+  namespace fs = std::filesystem;
+  // write to a temporary file that replaces the state only once it is completely on the disk, so
+  // that a crash never leaves a truncated state or one with smaller offsets behind
+  const auto tmp_path = path + ".tmp";
+  {
+    // create the file with owner-only permissions before writing any secrets to it
+    std::ofstream touch(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!touch) {
+      throw std::runtime_error(fmt::format("Could not open base OT state file {}", tmp_path));
+    }
+  }
+  fs::permissions(tmp_path, fs::perms::owner_read | fs::perms::owner_write,
+                  fs::perm_options::replace);
+
+  std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+  const auto write_value = [&file](std::uint64_t value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  const auto write_msgs = [&file](const base_ot_msgs_t &msgs) {
+    for (const auto &msg : msgs) {
+      file.write(reinterpret_cast<const char *>(msg.data()), msg.size());
+    }
+  };
+  file.write(base_ot_state_magic.data(), base_ot_state_magic.size());
+  write_value(my_id_);
+  write_value(num_parties_);
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    const auto [rcv_msgs, snd_msgs] = ExportBaseOTs(party_id);
+    const auto [reserved_rcv_blocks, reserved_snd_blocks] =
+        reserved_blocks.empty() ? std::pair<std::size_t, std::size_t>{0, 0}
+                                : reserved_blocks.at(party_id);
+    file.write(reinterpret_cast<const char *>(rcv_msgs.c_.GetData().data()),
+               rcv_msgs.c_.GetData().size());
+    write_msgs(rcv_msgs.messages_c_);
+    write_value(rcv_msgs.consumed_offset_ + reserved_rcv_blocks);
+    write_msgs(snd_msgs.messages_0_);
+    write_msgs(snd_msgs.messages_1_);
+    write_value(snd_msgs.consumed_offset_ + reserved_snd_blocks);
+  }
+  file.close();
+  if (!file) {
+    throw std::runtime_error(fmt::format("Failed to write base OT state file {}", tmp_path));
+  }
+  sync_path(tmp_path, O_RDONLY);
+  fs::rename(tmp_path, path);
+  const auto directory = fs::absolute(path).parent_path();
+  sync_path(directory.string(), O_RDONLY | O_DIRECTORY);
+
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug(fmt::format("Stored base OTs in {}", path));
+    }
+  }
+}
+
+void BaseOTProvider::LoadBaseOTs(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error(fmt::format("Could not open base OT state file {}", path));
+  }
+  const auto read_value = [&file] {
+    std::uint64_t value = 0;
+    file.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+  };
+  const auto read_msgs = [&file](base_ot_msgs_t &msgs) {
+    for (auto &msg : msgs) {
+      file.read(reinterpret_cast<char *>(msg.data()), msg.size());
+    }
+  };
+  std::array<char, 8> magic;
+  file.read(magic.data(), magic.size());
+  if (!file || magic != base_ot_state_magic) {
+    throw std::runtime_error(fmt::format("{} is not a base OT state file", path));
+  }
+  const auto my_id = read_value();
+  const auto num_parties = read_value();
+  if (my_id != my_id_ || num_parties != num_parties_) {
+    throw std::runtime_error(fmt::format(
+        "Base OT state file {} was written by party {} of {}, but this is party {} of {}", path,
+        my_id, num_parties, my_id_, num_parties_));
+  }
+
+  std::vector<std::pair<ReceiverMsgs, SenderMsgs>> base_ots(num_parties_);
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    auto &[rcv_msgs, snd_msgs] = base_ots.at(party_id);
+    std::array<std::byte, kappa / 8> choices;
+    file.read(reinterpret_cast<char *>(choices.data()), choices.size());
+    rcv_msgs.c_ = ENCRYPTO::BitVector<>(choices.data(), kappa);
+    read_msgs(rcv_msgs.messages_c_);
+    rcv_msgs.consumed_offset_ = read_value();
+    read_msgs(snd_msgs.messages_0_);
+    read_msgs(snd_msgs.messages_1_);
+    snd_msgs.consumed_offset_ = read_value();
+  }
+  if (!file) {
+    throw std::runtime_error(fmt::format("Base OT state file {} is truncated", path));
+  }
+
+  for (std::size_t party_id = 0; party_id < num_parties_; ++party_id) {
+    if (party_id == my_id_) {
+      continue;
+    }
+    ImportBaseOTs(party_id, base_ots.at(party_id).first);
+    ImportBaseOTs(party_id, base_ots.at(party_id).second);
+  }
+
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug(fmt::format("Loaded base OTs from {}", path));
+    }
+  }
+}
+
 }  // namespace MOTION
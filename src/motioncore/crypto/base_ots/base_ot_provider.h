@@ -26,6 +26,11 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "data_storage/base_ot_data.h"
 #include "utility/bit_vector.h"
@@ -51,11 +56,15 @@ using base_ot_msgs_t = std::array<std::array<std::byte, 16>, kappa>;
 struct SenderMsgs {
   base_ot_msgs_t messages_0_;
   base_ot_msgs_t messages_1_;
+  // number of PRG blocks already used by OT extension
+  std::size_t consumed_offset_ = 0;
 };
 
 struct ReceiverMsgs {
   base_ot_msgs_t messages_c_;
   ENCRYPTO::BitVector<> c_;
+  // number of PRG blocks already used by OT extension
+  std::size_t consumed_offset_ = 0;
 };
 
 class BaseOTProvider : public ENCRYPTO::enable_wait_setup {
@@ -67,6 +76,23 @@ class BaseOTProvider : public ENCRYPTO::enable_wait_setup {
   void ImportBaseOTs(std::size_t party_id, const ReceiverMsgs& msgs);
   void ImportBaseOTs(std::size_t party_id, const SenderMsgs& msgs);
   std::pair<ReceiverMsgs, SenderMsgs> ExportBaseOTs(std::size_t party_id);
+  // Store the base OTs of all other parties together with the consumed PRG
+  // offsets, so that a later session can continue with OT extension directly.
+  // reserved_blocks[party_id] = (receiver blocks, sender blocks) is added to the
+  // stored offsets: saving the offsets of an OT extension before running it
+  // ensures that no PRG block is used twice even if the process crashes.  The
+  // file is created with owner-only permissions and replaced atomically after
+  // it has been synced to the disk.  Both parties need to load the state
+  // written by the same previous session.
+  void SaveBaseOTs(const std::string& path,
+                   const std::vector<std::pair<std::size_t, std::size_t>>& reserved_blocks = {});
+  // Import the base OTs from a file written by SaveBaseOTs, throws if it
+  // cannot be read.
+  void LoadBaseOTs(const std::string& path);
+  // Exchange the readiness and consumed offsets of the base OTs with all other
+  // parties and throw if they do not match, e.g., if only one party loaded a
+  // state file.  All parties need to call this before ComputeBaseOTs.
+  void VerifyBaseOTState();
   BaseOTsData& get_base_ots_data(std::size_t party_id) { return data_.at(party_id); }
   const BaseOTsData& get_base_ots_data(std::size_t party_id) const { return data_.at(party_id); }
 
@@ -78,6 +104,7 @@ class BaseOTProvider : public ENCRYPTO::enable_wait_setup {
   Statistics::RunTimeStats* stats_;
   std::shared_ptr<Logger> logger_;
   bool finished_;
+  std::vector<std::promise<std::vector<std::uint64_t>>> state_promises_;
 
   Logger& GetLogger();
 };
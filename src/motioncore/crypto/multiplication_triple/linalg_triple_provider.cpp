@@ -24,14 +24,17 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <type_traits>
 
 #include <fmt/format.h>
 
+#include "communication/transport.h"
 #include "crypto/arithmetic_provider.h"
 #include "crypto/oblivious_transfer/ot_flavors.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
+#include "crypto/random/aes128_ctr_rng.h"
 #include "statistics/run_time_stats.h"
 #include "tensor/tensor_op.h"
 #include "utility/bit_vector.h"
@@ -565,4 +568,481 @@ void FakeLinAlgTripleProvider::registration_hook(const tensor::Conv2DOp&, std::s
 
 void FakeLinAlgTripleProvider::registration_hook_boolean(std::size_t, std::size_t) {}
 
+// ---------- DealerLinAlgTripleProvider ----------
+
+namespace {
+
+enum class DealerTripleKind : std::uint64_t { gemm, conv2d, relu };
+
+// Registered triples of one kind, bit size, and operation, described as
+// [kind][bit size][count][operation ...]. The parties sort their requests such that they and the
+// dealer expand the triples in the same order.
+using DealerRequestEntry = std::vector<std::uint64_t>;
+
+DealerRequestEntry make_dealer_entry(const tensor::GemmOp& gemm_op, std::size_t bit_size,
+                                     std::size_t count) {
+  return {static_cast<std::uint64_t>(DealerTripleKind::gemm),
+          bit_size,
+          count,
+          gemm_op.input_A_shape_[0],
+          gemm_op.input_A_shape_[1],
+          gemm_op.input_B_shape_[0],
+          gemm_op.input_B_shape_[1],
+          gemm_op.output_shape_[0],
+          gemm_op.output_shape_[1],
+          gemm_op.tile_rows_,
+          gemm_op.transA_,
+          gemm_op.transB_};
+}
+
+DealerRequestEntry make_dealer_entry(const tensor::Conv2DOp& conv_op, std::size_t bit_size,
+                                     std::size_t count) {
+  DealerRequestEntry entry = {static_cast<std::uint64_t>(DealerTripleKind::conv2d), bit_size,
+                              count};
+  const auto append = [&entry](const auto& array) {
+    entry.insert(std::end(entry), std::begin(array), std::end(array));
+  };
+  append(conv_op.kernel_shape_);
+  append(conv_op.input_shape_);
+  append(conv_op.output_shape_);
+  append(conv_op.dilations_);
+  append(conv_op.pads_);
+  append(conv_op.strides_);
+  return entry;
+}
+
+tensor::GemmOp parse_gemm_entry(const DealerRequestEntry& entry) {
+  // the triples are registered under the full GemmOp, so it must round-trip exactly
+  if (entry.size() != 12 || entry[10] > 1 || entry[11] > 1) {
+    throw std::runtime_error("malformed gemm entry in request to the dealer");
+  }
+  tensor::GemmOp gemm_op;
+  gemm_op.input_A_shape_ = {entry[3], entry[4]};
+  gemm_op.input_B_shape_ = {entry[5], entry[6]};
+  gemm_op.output_shape_ = {entry[7], entry[8]};
+  gemm_op.tile_rows_ = entry[9];
+  gemm_op.transA_ = entry[10];
+  gemm_op.transB_ = entry[11];
+  if (!gemm_op.verify()) {
+    throw std::runtime_error("invalid gemm entry in request to the dealer");
+  }
+  return gemm_op;
+}
+
+tensor::Conv2DOp parse_conv2d_entry(const DealerRequestEntry& entry) {
+  if (entry.size() != 21) {
+    throw std::runtime_error("malformed conv2d entry in request to the dealer");
+  }
+  tensor::Conv2DOp conv_op;
+  auto it = std::begin(entry) + 3;
+  const auto read = [&it](auto& array) {
+    std::copy_n(it, array.size(), std::begin(array));
+    it += array.size();
+  };
+  read(conv_op.kernel_shape_);
+  read(conv_op.input_shape_);
+  read(conv_op.output_shape_);
+  read(conv_op.dilations_);
+  read(conv_op.pads_);
+  read(conv_op.strides_);
+  if (!conv_op.verify()) {
+    throw std::runtime_error("invalid conv2d entry in request to the dealer");
+  }
+  return conv_op;
+}
+
+// [number of entries] followed by [entry size][entry ...] for each entry
+std::vector<std::uint8_t> serialize_dealer_request(const std::vector<DealerRequestEntry>& request) {
+  std::vector<std::uint64_t> values = {request.size()};
+  for (const auto& entry : request) {
+    values.push_back(entry.size());
+    values.insert(std::end(values), std::begin(entry), std::end(entry));
+  }
+  std::vector<std::uint8_t> message(values.size() * sizeof(std::uint64_t));
+  std::memcpy(message.data(), values.data(), message.size());
+  return message;
+}
+
+std::vector<DealerRequestEntry> deserialize_dealer_request(const std::vector<std::uint8_t>& message) {
+  if (message.size() % sizeof(std::uint64_t) != 0) {
+    throw std::runtime_error("malformed request to the dealer");
+  }
+  std::vector<std::uint64_t> values(message.size() / sizeof(std::uint64_t));
+  std::memcpy(values.data(), message.data(), message.size());
+  std::vector<DealerRequestEntry> request;
+  std::size_t pos = 0;
+  const auto next = [&values, &pos] {
+    if (pos >= values.size()) {
+      throw std::runtime_error("malformed request to the dealer");
+    }
+    return values[pos++];
+  };
+  const auto num_entries = next();
+  for (std::size_t i = 0; i < num_entries; ++i) {
+    const auto entry_size = next();
+    if (entry_size < 3 || entry_size > values.size() - pos) {
+      throw std::runtime_error("malformed request to the dealer");
+    }
+    request.emplace_back(std::begin(values) + pos, std::begin(values) + pos + entry_size);
+    pos += entry_size;
+  }
+  return request;
+}
+
+// call f with a value of the unsigned integer type of the given size
+template <typename F>
+void visit_bit_size(std::size_t bit_size, F&& f) {
+  switch (bit_size) {
+    case 8:
+      return f(std::uint8_t{});
+    case 16:
+      return f(std::uint16_t{});
+    case 32:
+      return f(std::uint32_t{});
+    case 64:
+      return f(std::uint64_t{});
+    case 128:
+      return f(__uint128_t{});
+    default:
+      throw std::logic_error("invalid bit size");
+  }
+}
+
+template <typename T>
+std::vector<T> expand_vector(AES128_CTR_RNG& rng, std::size_t size) {
+  std::vector<T> output(size);
+  rng.random_bytes(reinterpret_cast<std::byte*>(output.data()), size * sizeof(T));
+  return output;
+}
+
+ENCRYPTO::BitVector<> expand_bit_vector(AES128_CTR_RNG& rng, std::size_t num_bits) {
+  std::vector<std::byte> buffer(Helpers::Convert::BitsToBytes(num_bits));
+  rng.random_bytes(buffer.data(), buffer.size());
+  return ENCRYPTO::BitVector<>(buffer.data(), num_bits);
+}
+
+// Expands the shares of a triple from a party's stream. The share of c is only part of the stream
+// of party 0; party 1 receives it as correction from the dealer.
+template <typename T>
+LinAlgTripleProvider::LinAlgTriple<T> expand_triple(AES128_CTR_RNG& rng, std::size_t size_a,
+                                                    std::size_t size_b, std::size_t size_c,
+                                                    bool expand_c) {
+  LinAlgTripleProvider::LinAlgTriple<T> triple;
+  triple.a_ = expand_vector<T>(rng, size_a);
+  triple.b_ = expand_vector<T>(rng, size_b);
+  if (expand_c) {
+    triple.c_ = expand_vector<T>(rng, size_c);
+  }
+  return triple;
+}
+
+LinAlgTripleProvider::BooleanTriple expand_boolean_triple(AES128_CTR_RNG& rng,
+                                                          std::size_t num_triples,
+                                                          std::size_t bit_size, bool expand_c) {
+  LinAlgTripleProvider::BooleanTriple triple;
+  triple.a_ = expand_bit_vector(rng, num_triples);
+  triple.b_.resize(bit_size - 1);
+  std::generate(std::begin(triple.b_), std::end(triple.b_),
+                [&rng, num_triples] { return expand_bit_vector(rng, num_triples); });
+  if (expand_c) {
+    triple.c_.resize(bit_size - 1);
+    std::generate(std::begin(triple.c_), std::end(triple.c_),
+                  [&rng, num_triples] { return expand_bit_vector(rng, num_triples); });
+  }
+  return triple;
+}
+
+// Reads the corrections of party 1 from the reply of the dealer.
+class DealerReplyReader {
+ public:
+  DealerReplyReader(const std::vector<std::uint8_t>& reply, std::size_t offset)
+      : reply_(reply), offset_(offset) {}
+
+  template <typename T>
+  std::vector<T> read_vector(std::size_t size) {
+    std::vector<T> output(size);
+    read(reinterpret_cast<std::uint8_t*>(output.data()), size * sizeof(T));
+    return output;
+  }
+
+  ENCRYPTO::BitVector<> read_bit_vector(std::size_t num_bits) {
+    std::vector<std::byte> buffer(Helpers::Convert::BitsToBytes(num_bits));
+    read(reinterpret_cast<std::uint8_t*>(buffer.data()), buffer.size());
+    return ENCRYPTO::BitVector<>(buffer.data(), num_bits);
+  }
+
+  bool done() const noexcept { return offset_ == reply_.size(); }
+
+ private:
+  void read(std::uint8_t* output, std::size_t num_bytes) {
+    if (num_bytes > reply_.size() - offset_) {
+      throw std::runtime_error("reply of the dealer is too short");
+    }
+    std::copy_n(reply_.data() + offset_, num_bytes, output);
+    offset_ += num_bytes;
+  }
+
+  const std::vector<std::uint8_t>& reply_;
+  std::size_t offset_;
+};
+
+template <typename T>
+void append_bytes(std::vector<std::uint8_t>& message, const std::vector<T>& values) {
+  const auto* begin = reinterpret_cast<const std::uint8_t*>(values.data());
+  message.insert(std::end(message), begin, begin + values.size() * sizeof(T));
+}
+
+void append_bytes(std::vector<std::uint8_t>& message, const ENCRYPTO::BitVector<>& bv) {
+  const auto* begin = reinterpret_cast<const std::uint8_t*>(bv.GetData().data());
+  message.insert(std::end(message), begin, begin + Helpers::Convert::BitsToBytes(bv.GetSize()));
+}
+
+}  // namespace
+
+DealerLinAlgTripleProvider::DealerLinAlgTripleProvider(std::size_t my_id,
+                                                       Communication::Transport& dealer_transport,
+                                                       Statistics::RunTimeStats& run_time_stats,
+                                                       std::shared_ptr<Logger> logger)
+    : my_id_(my_id),
+      dealer_transport_(dealer_transport),
+      run_time_stats_(run_time_stats),
+      logger_(logger) {
+  if (my_id_ > 1) {
+    throw std::invalid_argument(
+        fmt::format("DealerLinAlgTripleProvider: invalid party id {}", my_id_));
+  }
+}
+
+void DealerLinAlgTripleProvider::setup() {
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug("DealerLinAlgTripleProvider::setup start");
+    }
+  }
+  run_time_stats_.record_start<Statistics::RunTimeStats::StatID::linalgtriple_setup>();
+
+  std::vector<DealerRequestEntry> request;
+  const auto add_entries = [&request](const auto& count_map, std::size_t bit_size) {
+    for (const auto& [op, count] : count_map) {
+      request.push_back(make_dealer_entry(op, bit_size, count));
+    }
+  };
+  add_entries(gemm_counts_8_, 8);
+  add_entries(gemm_counts_16_, 16);
+  add_entries(gemm_counts_32_, 32);
+  add_entries(gemm_counts_64_, 64);
+  add_entries(gemm_counts_128_, 128);
+  add_entries(conv2d_counts_8_, 8);
+  add_entries(conv2d_counts_16_, 16);
+  add_entries(conv2d_counts_32_, 32);
+  add_entries(conv2d_counts_64_, 64);
+  add_entries(conv2d_counts_128_, 128);
+  for (const auto& [key, count] : relu_counts_) {
+    request.push_back(
+        {static_cast<std::uint64_t>(DealerTripleKind::relu), key.second, count, key.first});
+  }
+  std::sort(std::begin(request), std::end(request));
+
+  dealer_transport_.send_message(serialize_dealer_request(request));
+  auto reply = dealer_transport_.receive_message();
+  if (!reply.has_value() || reply->size() < AES128_CTR_RNG::block_size) {
+    throw std::runtime_error("DealerLinAlgTripleProvider: did not receive the seed of the dealer");
+  }
+  AES128_CTR_RNG rng;
+  rng.set_key(reinterpret_cast<const std::byte*>(reply->data()));
+  DealerReplyReader corrections(*reply, AES128_CTR_RNG::block_size);
+  const bool expand_c = my_id_ == 0;
+
+  const auto gemm_triples = [this](auto dummy_arg) -> auto& {
+    using T = decltype(dummy_arg);
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return gemm_triples_8_;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return gemm_triples_16_;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return gemm_triples_32_;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return gemm_triples_64_;
+    } else if constexpr (std::is_same_v<T, __uint128_t>) {
+      return gemm_triples_128_;
+    }
+  };
+  const auto conv2d_triples = [this](auto dummy_arg) -> auto& {
+    using T = decltype(dummy_arg);
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return conv2d_triples_8_;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return conv2d_triples_16_;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return conv2d_triples_32_;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return conv2d_triples_64_;
+    } else if constexpr (std::is_same_v<T, __uint128_t>) {
+      return conv2d_triples_128_;
+    }
+  };
+
+  for (const auto& entry : request) {
+    const auto kind = static_cast<DealerTripleKind>(entry[0]);
+    const auto bit_size = entry[1];
+    const auto count = entry[2];
+    if (kind == DealerTripleKind::relu) {
+      const auto num_triples = entry[3];
+      auto& triple_vec = relu_triples_.at({num_triples, bit_size});
+      triple_vec.reserve(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        auto& triple = triple_vec.emplace_back(
+            expand_boolean_triple(rng, num_triples, bit_size, expand_c));
+        if (!expand_c) {
+          triple.c_.resize(bit_size - 1);
+          std::generate(std::begin(triple.c_), std::end(triple.c_), [&corrections, num_triples] {
+            return corrections.read_bit_vector(num_triples);
+          });
+        }
+      }
+      continue;
+    }
+    visit_bit_size(bit_size, [&](auto dummy_arg) {
+      using T = decltype(dummy_arg);
+      const auto add_triples = [&](auto& triple_vec, std::size_t size_a, std::size_t size_b,
+                                   std::size_t size_c) {
+        triple_vec.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+          auto& triple =
+              triple_vec.emplace_back(expand_triple<T>(rng, size_a, size_b, size_c, expand_c));
+          if (!expand_c) {
+            triple.c_ = corrections.read_vector<T>(size_c);
+          }
+        }
+      };
+      if (kind == DealerTripleKind::gemm) {
+        const auto gemm_op = parse_gemm_entry(entry);
+        add_triples(gemm_triples(dummy_arg).at(gemm_op), gemm_op.compute_input_A_size(),
+                    gemm_op.compute_input_B_size(), gemm_op.compute_output_size());
+      } else {
+        const auto conv_op = parse_conv2d_entry(entry);
+        add_triples(conv2d_triples(dummy_arg).at(conv_op), conv_op.compute_input_size(),
+                    conv_op.compute_kernel_size(), conv_op.compute_output_size());
+      }
+    });
+  }
+  if (!corrections.done()) {
+    throw std::runtime_error("DealerLinAlgTripleProvider: reply of the dealer is too long");
+  }
+
+  set_setup_ready();
+
+  run_time_stats_.record_end<Statistics::RunTimeStats::StatID::linalgtriple_setup>();
+  if constexpr (MOTION_DEBUG) {
+    if (logger_) {
+      logger_->LogDebug("DealerLinAlgTripleProvider::setup end");
+    }
+  }
+}
+
+void DealerLinAlgTripleProvider::registration_hook(const tensor::GemmOp&, std::size_t) {}
+
+void DealerLinAlgTripleProvider::registration_hook(const tensor::Conv2DOp&, std::size_t) {}
+
+void DealerLinAlgTripleProvider::registration_hook_boolean(std::size_t, std::size_t) {}
+
+// ---------- LinAlgTripleDealer ----------
+
+LinAlgTripleDealer::LinAlgTripleDealer(Communication::Transport& transport_0,
+                                       Communication::Transport& transport_1,
+                                       std::shared_ptr<Logger> logger)
+    : transport_0_(transport_0), transport_1_(transport_1), logger_(logger) {}
+
+bool LinAlgTripleDealer::deal() {
+  auto request_0 = transport_0_.receive_message();
+  auto request_1 = transport_1_.receive_message();
+  if (!request_0.has_value() && !request_1.has_value()) {
+    return false;
+  }
+  if (!request_0.has_value() || !request_1.has_value()) {
+    throw std::runtime_error("LinAlgTripleDealer: did not receive the requests of both parties");
+  }
+  if (*request_0 != *request_1) {
+    throw std::runtime_error("LinAlgTripleDealer: parties requested different triples");
+  }
+  const auto request = deserialize_dealer_request(*request_0);
+  if (logger_) {
+    logger_->LogDebug(fmt::format("LinAlgTripleDealer: dealing {} kinds of triples", request.size()));
+  }
+
+  std::array<std::vector<std::uint8_t>, 2> replies;
+  std::array<AES128_CTR_RNG, 2> rngs;
+  for (std::size_t party_id = 0; party_id < 2; ++party_id) {
+    replies[party_id].resize(AES128_CTR_RNG::block_size);
+    AES128_CTR_RNG::get_thread_instance().random_blocks(
+        reinterpret_cast<std::byte*>(replies[party_id].data()), 1);
+    rngs[party_id].set_key(reinterpret_cast<const std::byte*>(replies[party_id].data()));
+  }
+  auto& corrections = replies[1];
+
+  for (const auto& entry : request) {
+    const auto kind = static_cast<DealerTripleKind>(entry[0]);
+    const auto bit_size = entry[1];
+    const auto count = entry[2];
+    if (kind == DealerTripleKind::relu) {
+      if (entry.size() != 4 || bit_size < 2) {
+        throw std::runtime_error("malformed relu entry in request to the dealer");
+      }
+      const auto num_triples = entry[3];
+      for (std::size_t i = 0; i < count; ++i) {
+        const auto triple_0 = expand_boolean_triple(rngs[0], num_triples, bit_size, true);
+        const auto triple_1 = expand_boolean_triple(rngs[1], num_triples, bit_size, false);
+        const auto a = triple_0.a_ ^ triple_1.a_;
+        for (std::size_t bit_j = 0; bit_j < bit_size - 1; ++bit_j) {
+          auto c_1 = a & (triple_0.b_[bit_j] ^ triple_1.b_[bit_j]);
+          c_1 ^= triple_0.c_[bit_j];
+          append_bytes(corrections, c_1);
+        }
+      }
+      continue;
+    }
+    visit_bit_size(bit_size, [&](auto dummy_arg) {
+      using T = decltype(dummy_arg);
+      // c_1 = f(a_0 + a_1, b_0 + b_1) - c_0
+      const auto deal_triples = [&](std::size_t size_a, std::size_t size_b, std::size_t size_c,
+                                    const auto& f) {
+        for (std::size_t i = 0; i < count; ++i) {
+          auto triple_0 = expand_triple<T>(rngs[0], size_a, size_b, size_c, true);
+          const auto triple_1 = expand_triple<T>(rngs[1], size_a, size_b, size_c, false);
+          std::transform(std::begin(triple_0.a_), std::end(triple_0.a_), std::begin(triple_1.a_),
+                         std::begin(triple_0.a_), std::plus{});
+          std::transform(std::begin(triple_0.b_), std::end(triple_0.b_), std::begin(triple_1.b_),
+                         std::begin(triple_0.b_), std::plus{});
+          auto c_1 = f(triple_0.a_, triple_0.b_);
+          assert(c_1.size() == size_c);
+          std::transform(std::begin(c_1), std::end(c_1), std::begin(triple_0.c_), std::begin(c_1),
+                         std::minus{});
+          append_bytes(corrections, c_1);
+        }
+      };
+      if (kind == DealerTripleKind::gemm) {
+        const auto gemm_op = parse_gemm_entry(entry);
+        deal_triples(gemm_op.compute_input_A_size(), gemm_op.compute_input_B_size(),
+                     gemm_op.compute_output_size(), [&gemm_op](const auto& a, const auto& b) {
+                       std::vector<T> c(gemm_op.compute_output_size());
+                       matrix_multiply(gemm_op, a.data(), b.data(), c.data());
+                       return c;
+                     });
+      } else if (kind == DealerTripleKind::conv2d) {
+        const auto conv_op = parse_conv2d_entry(entry);
+        deal_triples(conv_op.compute_input_size(), conv_op.compute_kernel_size(),
+                     conv_op.compute_output_size(), [&conv_op](const auto& a, const auto& b) {
+                       return convolution(conv_op, a, b);
+                     });
+      } else {
+        throw std::runtime_error("unknown kind of triple in request to the dealer");
+      }
+    });
+  }
+
+  transport_0_.send_message(std::move(replies[0]));
+  transport_1_.send_message(std::move(replies[1]));
+  return true;
+}
+
 }  // namespace MOTION
@@ -42,6 +42,10 @@ class ROTSender;
 
 namespace MOTION {
 
+namespace Communication {
+class Transport;
+}
+
 namespace Statistics {
 struct RunTimeStats;
 }
@@ -183,4 +187,45 @@ class FakeLinAlgTripleProvider : public LinAlgTripleProvider {
   void registration_hook_boolean(std::size_t num_triples, std::size_t bit_size) override;
 };
 
+// Triples dealt by a semi-trusted third party, e.g., the helper node, which runs a
+// LinAlgTripleDealer. Both parties send the list of registered triples to the dealer in setup().
+// Party 0 then only receives a seed from which it expands its shares of a, b, and c. Party 1
+// expands its shares of a and b from another seed and receives its shares of c as correction
+// terms, i.e., one message from the dealer replaces the OT-based preprocessing.
+class DealerLinAlgTripleProvider : public LinAlgTripleProvider {
+ public:
+  DealerLinAlgTripleProvider(std::size_t my_id, Communication::Transport& dealer_transport,
+                             Statistics::RunTimeStats&, std::shared_ptr<Logger>);
+
+  void setup() override;
+
+ protected:
+  void registration_hook(const tensor::GemmOp&, std::size_t bit_size) override;
+  void registration_hook(const tensor::Conv2DOp&, std::size_t bit_size) override;
+  void registration_hook_boolean(std::size_t num_triples, std::size_t bit_size) override;
+
+ private:
+  std::size_t my_id_;
+  Communication::Transport& dealer_transport_;
+  Statistics::RunTimeStats& run_time_stats_;
+  std::shared_ptr<Logger> logger_;
+};
+
+// Dealer side of DealerLinAlgTripleProvider. It learns all triples it deals.
+class LinAlgTripleDealer {
+ public:
+  // transport_i is the connection to party i
+  LinAlgTripleDealer(Communication::Transport& transport_0, Communication::Transport& transport_1,
+                     std::shared_ptr<Logger> logger = nullptr);
+
+  // receive the requests of both parties and send them their triples, returns false if both
+  // parties have closed their connections instead of sending a request
+  bool deal();
+
+ private:
+  Communication::Transport& transport_0_;
+  Communication::Transport& transport_1_;
+  std::shared_ptr<Logger> logger_;
+};
+
 }  // namespace MOTION
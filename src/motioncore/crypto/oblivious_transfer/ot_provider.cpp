@@ -140,9 +140,26 @@ template std::unique_ptr<ACOTReceiver<__uint128_t>> OTProvider::RegisterReceiveA
   return receiver_provider_.RegisterROT(num_ots, vector_size, random_choice, Send_);
 }
 
+// the OT extension expands the base OTs to the number of OTs rounded up to the next full block
+static std::size_t num_base_ot_blocks(std::size_t num_ots) {
+  constexpr std::size_t kappa = 128;
+  if (num_ots == 0) {
+    return 0;
+  }
+  return (num_ots + kappa - (num_ots % kappa)) / kappa;
+}
+
+std::size_t OTProvider::GetNumBaseOTBlocksReceiver() const {
+  return num_base_ot_blocks(receiver_provider_.GetNumOTs());
+}
+
+std::size_t OTProvider::GetNumBaseOTBlocksSender() const {
+  return num_base_ot_blocks(sender_provider_.GetNumOTs());
+}
+
 OTProviderFromOTExtension::OTProviderFromOTExtension(
     std::function<void(flatbuffers::FlatBufferBuilder &&)> Send, MOTION::OTExtensionData &data,
-    const MOTION::BaseOTsData &base_ot_data,
+    MOTION::BaseOTsData &base_ot_data,
     MOTION::Crypto::MotionBaseProvider &motion_base_provider, std::size_t party_id,
     std::shared_ptr<MOTION::Logger> logger)
     : OTProvider(Send, data, party_id, logger),
@@ -163,7 +180,7 @@ void OTProviderFromOTExtension::SendSetup() {
   constexpr std::size_t kappa = 128;
 
   // storage for sender and base OT receiver data
-  const auto &base_ots_rcv = base_ot_data_.GetReceiverData();
+  auto &base_ots_rcv = base_ot_data_.GetReceiverData();
   auto &ot_ext_snd = data_.GetSenderData();
 
   // number of OTs after extension
@@ -207,6 +224,9 @@ void OTProviderFromOTExtension::SendSetup() {
     v[i] = AlignedBitVector(std::move(row), bit_size_padded);
   }
   ot_ext_snd.consumed_offset_base_ots_ += bit_size_padded / kappa;
+  // never expand the same part of the base OT streams twice, e.g., when the
+  // base OTs are reused in a later session
+  base_ots_rcv.consumed_offset_ += GetNumBaseOTBlocksSender();
 
   // receive the vectors u one by one from the receiver
   // and xor them to the expanded keys if the corresponding selection bit is 1
@@ -333,7 +353,7 @@ void OTProviderFromOTExtension::ReceiveSetup() {
     return;
   }
   // storage for receiver and base OT sender data
-  const auto &base_ots_snd = base_ot_data_.GetSenderData();
+  auto &base_ots_snd = base_ot_data_.GetSenderData();
   auto &ot_ext_rcv = data_.GetReceiverData();
 
   // make random choices (this is precomputation, real inputs are not known yet)
@@ -374,6 +394,7 @@ void OTProviderFromOTExtension::ReceiveSetup() {
                                                                       u.GetData().size(), i));
   }
   ot_ext_rcv.consumed_offset_base_ots_ += bit_size_padded / kappa;
+  base_ots_snd.consumed_offset_ += GetNumBaseOTBlocksReceiver();
 
   // transpose matrix T
   if (bit_size_padded != bit_size) {
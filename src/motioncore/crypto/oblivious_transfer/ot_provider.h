@@ -428,6 +428,12 @@ class OTProvider {
 
   [[nodiscard]] std::size_t GetNumOTsSender() const { return sender_provider_.GetNumOTs(); }
 
+  // number of PRG blocks of the base OTs that ReceiveSetup/SendSetup consume for the OTs registered
+  // so far, i.e., how far they advance the consumed offsets of the base OT sender/receiver data
+  [[nodiscard]] std::size_t GetNumBaseOTBlocksReceiver() const;
+
+  [[nodiscard]] std::size_t GetNumBaseOTBlocksSender() const;
+
   virtual void SendSetup() = 0;
   virtual void ReceiveSetup() = 0;
 
@@ -470,12 +476,12 @@ class OTProviderFromOTExtension final : public OTProvider {
   void ReceiveSetup() final;
 
   OTProviderFromOTExtension(std::function<void(flatbuffers::FlatBufferBuilder&&)> Send,
-                            MOTION::OTExtensionData& data, const MOTION::BaseOTsData& base_ot_data,
+                            MOTION::OTExtensionData& data, MOTION::BaseOTsData& base_ot_data,
                             MOTION::Crypto::MotionBaseProvider&, std::size_t party_id,
                             std::shared_ptr<MOTION::Logger> logger);
 
  private:
-  const MOTION::BaseOTsData& base_ot_data_;
+  MOTION::BaseOTsData& base_ot_data_;
   MOTION::Crypto::MotionBaseProvider& motion_base_provider_;
 };
 
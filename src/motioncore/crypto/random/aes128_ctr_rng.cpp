@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <fstream>
 #include "aes128_ctr_rng.h"
 #include "crypto/aes/aesni_primitives.h"
@@ -57,6 +58,16 @@ void AES128_CTR_RNG::sample_key() {
   state_->counter = 0;
 }
 
+void AES128_CTR_RNG::set_key(const std::byte* key, std::uint64_t counter) {
+  std::copy_n(key, aes_block_size, state_->round_keys.data());
+
+  // execute key schedule
+  aesni_key_expansion_128(state_->round_keys.data());
+
+  // set counter
+  state_->counter = counter;
+}
+
 void AES128_CTR_RNG::random_blocks_aligned(std::byte* output, std::size_t num_blocks) {
   std::byte* aligned_output = reinterpret_cast<std::byte*>(__builtin_assume_aligned(output, 16));
   aesni_ctr_stream_blocks_128(state_->round_keys.data(), &state_->counter, aligned_output,
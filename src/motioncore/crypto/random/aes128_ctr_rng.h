@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "rng.h"
 
@@ -42,6 +43,12 @@ class AES128_CTR_RNG : public RNG {
   // (re)initialize the PRG with a randomly chosen key
   virtual void sample_key();
 
+  // (re)initialize the PRG with the given key of size block_size, e.g., a seed
+  // received from another party, such that both produce the same stream;
+  // the stream starts at block `counter`, which allows to derive disjoint
+  // streams from the same key
+  void set_key(const std::byte* key, std::uint64_t counter = 0);
+
   // fill the output buffer with num_bytes random bytes
   virtual void random_bytes(std::byte* output, std::size_t num_bytes);
 
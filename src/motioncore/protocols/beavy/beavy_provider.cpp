@@ -927,48 +927,94 @@ BEAVYProvider::make_arithmetic_64_tensor_input_shares(const tensor::TensorDimens
   return basic_make_arithmetic_tensor_input_shares<std::uint64_t>(dims);
 }
 
+// Output tensor to give out the shares directly
+
 template <typename T>
-ENCRYPTO::ReusableFiberFuture<IntegerValues<T>>
-BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP& in) {
+std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>>>
+BEAVYProvider::basic_make_arithmetic_tensor_output_shares(const tensor::TensorCP& in) {
   auto input = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in);
   if (input == nullptr) {
     throw std::logic_error("wrong tensor type");
   }
   auto gate_id = gate_register_.get_next_gate_id();
   auto tensor_op =
-      std::make_unique<ArithmeticBEAVYTensorOutput<T>>(gate_id, *this, std::move(input), my_id_);
+      std::make_unique<ArithmeticBEAVYTensorOutputShares<T>>(gate_id, *this, std::move(input));
+  auto output_futures = tensor_op->get_output_futures();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output_futures;
+}
+
+std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<uint32_t>>>
+BEAVYProvider::make_arithmetic_32_tensor_output_shares(const tensor::TensorCP& in) {
+  return basic_make_arithmetic_tensor_output_shares<std::uint32_t>(in);
+}
+
+std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<uint64_t>>>
+BEAVYProvider::make_arithmetic_64_tensor_output_shares(const tensor::TensorCP& in) {
+  return basic_make_arithmetic_tensor_output_shares<std::uint64_t>(in);
+}
+
+std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+BEAVYProvider::make_boolean_tensor_output_shares(const tensor::TensorCP& in) {
+  auto input = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
+  if (input == nullptr) {
+    throw std::logic_error("wrong tensor type");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op =
+      std::make_unique<BooleanBEAVYTensorOutputShares>(gate_id, *this, std::move(input));
+  auto output_futures = tensor_op->get_output_futures();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output_futures;
+}
+
+template <typename T>
+ENCRYPTO::ReusableFiberFuture<IntegerValues<T>>
+BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP& in,
+                                                     tensor::OutputSinkP output_sink) {
+  auto input = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in);
+  if (input == nullptr) {
+    throw std::logic_error("wrong tensor type");
+  }
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op = std::make_unique<ArithmeticBEAVYTensorOutput<T>>(
+      gate_id, *this, std::move(input), my_id_, std::move(output_sink));
   auto future = tensor_op->get_output_future();
   gate_register_.register_gate(std::move(tensor_op));
   return future;
 }
 
 template ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&);
+BEAVYProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&,
+                                                     tensor::OutputSinkP);
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-BEAVYProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in);
+BEAVYProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in,
+                                                   tensor::OutputSinkP output_sink) {
+  return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in, std::move(output_sink));
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-BEAVYProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in) {
-  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in);
+BEAVYProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in,
+                                                   tensor::OutputSinkP output_sink) {
+  return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in, std::move(output_sink));
 }
 
-void BEAVYProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in) {
+void BEAVYProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in,
+                                                        tensor::OutputSinkP output_sink) {
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   switch (in->get_bit_size()) {
     case 32: {
       gate = std::make_unique<ArithmeticBEAVYTensorOutput<std::uint32_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<std::uint32_t>>(in),
-          1 - my_id_);
+          1 - my_id_, std::move(output_sink));
       break;
     }
     case 64: {
       gate = std::make_unique<ArithmeticBEAVYTensorOutput<std::uint64_t>>(
           gate_id, *this, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<std::uint64_t>>(in),
-          1 - my_id_);
+          1 - my_id_, std::move(output_sink));
       break;
     }
     default: {
@@ -1080,6 +1126,14 @@ tensor::TensorCP BEAVYProvider::make_tensor_gemm_op(const tensor::GemmOp& gemm_o
                                                     const tensor::TensorCP input_A,
                                                     const tensor::TensorCP input_B,
                                                     std::size_t fractional_bits) {
+  return make_tensor_gemm_op(gemm_op, input_A, input_B, nullptr, fractional_bits);
+}
+
+tensor::TensorCP BEAVYProvider::make_tensor_gemm_op(const tensor::GemmOp& gemm_op,
+                                                    const tensor::TensorCP input_A,
+                                                    const tensor::TensorCP input_B,
+                                                    const tensor::TensorCP bias,
+                                                    std::size_t fractional_bits) {
   if (!gemm_op.verify()) {
     throw std::invalid_argument("invalid GemmOp");
   }
@@ -1089,19 +1143,24 @@ tensor::TensorCP BEAVYProvider::make_tensor_gemm_op(const tensor::GemmOp& gemm_o
   if (input_B->get_dimensions() != gemm_op.get_input_B_tensor_dims()) {
     throw std::invalid_argument("invalid input_B dimensions");
   }
+  if (bias != nullptr && bias->get_dimensions() != gemm_op.get_output_tensor_dims()) {
+    throw std::invalid_argument("invalid bias dimensions");
+  }
   auto bit_size = input_A->get_bit_size();
-  if (bit_size != input_B->get_bit_size()) {
+  if (bit_size != input_B->get_bit_size() ||
+      (bias != nullptr && bit_size != bias->get_bit_size())) {
     throw std::invalid_argument("bit size mismatch");
   }
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   tensor::TensorCP output;
-  const auto make_op = [this, input_A, gemm_op, input_B, fractional_bits, gate_id,
+  const auto make_op = [this, input_A, gemm_op, input_B, bias, fractional_bits, gate_id,
                         &output](auto dummy_arg) {
     using T = decltype(dummy_arg);
     auto tensor_op = std::make_unique<ArithmeticBEAVYTensorGemm<T>>(
         gate_id, *this, gemm_op, std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input_A),
-        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input_B), fractional_bits);
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input_B),
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(bias), fractional_bits);
     output = tensor_op->get_output_tensor();
     return tensor_op;
   };
@@ -1177,7 +1236,31 @@ tensor::TensorCP BEAVYProvider::make_tensor_avgpool_op(const tensor::AveragePool
   return output;
 }
 
+template <typename T>
+tensor::TensorCP BEAVYProvider::basic_make_arithmetic_tensor_relu_op(const tensor::TensorCP in) {
+  const auto input_tensor = std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(in);
+  assert(input_tensor != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto sign_op = std::make_unique<ArithmeticBEAVYTensorSign<T>>(gate_id, *this, input_tensor);
+  auto sign = sign_op->get_output_tensor();
+  gate_register_.register_gate(std::move(sign_op));
+  return basic_make_tensor_relu_op<T>(sign, in);
+}
+
 tensor::TensorCP BEAVYProvider::make_tensor_relu_op(const tensor::TensorCP in) {
+  // arithmetic inputs: extract the sign bit in Boolean BEAVY and multiply the input with its
+  // negation, so that the output is arithmetic again without any conversion of the whole tensor
+  if (in->get_protocol() == MPCProtocol::ArithmeticBEAVY) {
+    const auto bit_size = in->get_bit_size();
+    switch (bit_size) {
+      case 32:
+        return basic_make_arithmetic_tensor_relu_op<std::uint32_t>(in);
+      case 64:
+        return basic_make_arithmetic_tensor_relu_op<std::uint64_t>(in);
+      default:
+        throw std::invalid_argument(fmt::format("unexpected bit size {}", bit_size));
+    }
+  }
   const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
   assert(input_tensor != nullptr);
   auto gate_id = gate_register_.get_next_gate_id();
@@ -1237,6 +1320,17 @@ tensor::TensorCP BEAVYProvider::make_tensor_maxpool_op(const tensor::MaxPoolOp&
   return output;
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_argmax_op(const tensor::TensorCP in, bool one_hot) {
+  const auto input_tensor = std::dynamic_pointer_cast<const BooleanBEAVYTensor>(in);
+  assert(input_tensor != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  auto tensor_op =
+      std::make_unique<BooleanBEAVYTensorArgmax>(gate_id, *this, input_tensor, one_hot);
+  auto output = tensor_op->get_output_tensor();
+  gate_register_.register_gate(std::move(tensor_op));
+  return output;
+}
+
 // Functions defined to perform constant operations (addnl)
 tensor::TensorCP BEAVYProvider::make_tensor_negate(const tensor::TensorCP in) {
   auto bit_size = in->get_bit_size();
@@ -1295,6 +1389,48 @@ tensor::TensorCP BEAVYProvider::make_tensor_constMul_op(const tensor::TensorCP i
 
 }
 
+tensor::TensorCP BEAVYProvider::make_tensor_constMatMul_op(
+    const tensor::GemmOp& gemm_op, const std::vector<std::uint64_t>& public_matrix,
+    const tensor::TensorCP input, std::size_t fractional_bits) {
+  if (!gemm_op.verify()) {
+    throw std::invalid_argument("invalid GemmOp");
+  }
+  if (public_matrix.size() != gemm_op.compute_input_A_size()) {
+    throw std::invalid_argument(fmt::format("public matrix has {} elements, expected {}",
+                                            public_matrix.size(), gemm_op.compute_input_A_size()));
+  }
+  if (input->get_dimensions() != gemm_op.get_input_B_tensor_dims()) {
+    throw std::invalid_argument("invalid input dimensions");
+  }
+  auto bit_size = input->get_bit_size();
+  std::unique_ptr<NewGate> gate;
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  const auto make_op = [this, &public_matrix, gemm_op, input, fractional_bits, gate_id,
+                        &output](auto dummy_arg) {
+    using T = decltype(dummy_arg);
+    // reduce the encoded matrix into the ring of the input
+    std::vector<T> matrix(std::begin(public_matrix), std::end(public_matrix));
+    auto tensor_op = std::make_unique<ArithmeticBEAVYTensorConstMatMul<T>>(
+        gate_id, *this, gemm_op, std::move(matrix),
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<T>>(input), fractional_bits);
+    output = tensor_op->get_output_tensor();
+    return tensor_op;
+  };
+  switch (bit_size) {
+    case 32:
+      gate = make_op(std::uint32_t{});
+      break;
+    case 64:
+      gate = make_op(std::uint64_t{});
+      break;
+    default:
+      throw std::logic_error(fmt::format("unexpected bit size {}", bit_size));
+  }
+  gate_register_.register_gate(std::move(gate));
+  return output;
+}
+
 //(addnl)
 tensor::TensorCP BEAVYProvider::make_tensor_add_op(const tensor::TensorCP inputA,const tensor::TensorCP inputB) {
   auto bit_size = inputA->get_bit_size();
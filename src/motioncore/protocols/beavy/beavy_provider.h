@@ -42,6 +42,7 @@ namespace MOTION {
 class CircuitLoader;
 class ArithmeticProviderManager;
 class GateRegister;
+class LinAlgTripleProvider;
 class Logger;
 class NewGate;
 using NewGateP = std::unique_ptr<NewGate>;
@@ -102,6 +103,15 @@ class BEAVYProvider : public GateFactory,
   std::size_t get_next_input_id(std::size_t num_inputs) noexcept;
 
   bool get_fake_setup() const noexcept { return fake_setup_; }
+  // if set, the tensor multiplications take their triples from this provider instead of running
+  // OT-based multiplications in their setup phase
+  void set_linalg_triple_provider(std::shared_ptr<LinAlgTripleProvider> ltp) noexcept {
+    linalg_triple_provider_ = ltp;
+  }
+  // nullptr if no provider is set
+  LinAlgTripleProvider* get_linalg_triple_provider() noexcept {
+    return linalg_triple_provider_.get();
+  }
 
   // Implementation of GateFactors interface
 
@@ -195,16 +205,26 @@ class BEAVYProvider : public GateFactory,
   std::pair<std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<uint64_t>>>, tensor::TensorCP >
   make_arithmetic_64_tensor_input_shares(const tensor::TensorDimensions& dims) override;
 
+  std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<uint32_t>>>
+  make_arithmetic_32_tensor_output_shares(const tensor::TensorCP&) override;
+
+  std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<uint64_t>>>
+  make_arithmetic_64_tensor_output_shares(const tensor::TensorCP&) override;
+
+  std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+  make_boolean_tensor_output_shares(const tensor::TensorCP&) override;
+
   // arithmetic outputs
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>> make_arithmetic_32_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, tensor::OutputSinkP output_sink = nullptr) override;
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>> make_arithmetic_64_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, tensor::OutputSinkP output_sink = nullptr) override;
 
   // conversions
   tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input) override;
 
-  void make_arithmetic_tensor_output_other(const tensor::TensorCP&) override;
+  void make_arithmetic_tensor_output_other(const tensor::TensorCP&,
+                                           tensor::OutputSinkP output_sink = nullptr) override;
 
   tensor::TensorCP make_tensor_flatten_op(const tensor::TensorCP input, std::size_t axis) override;
   tensor::TensorCP make_tensor_conv2d_op(const tensor::Conv2DOp& conv_op,
@@ -216,19 +236,30 @@ class BEAVYProvider : public GateFactory,
                                        const tensor::TensorCP input_A,
                                        const tensor::TensorCP input_B,
                                        std::size_t fractional_bits = 0) override;
+  tensor::TensorCP make_tensor_gemm_op(const tensor::GemmOp& gemm_op,
+                                       const tensor::TensorCP input_A,
+                                       const tensor::TensorCP input_B, const tensor::TensorCP bias,
+                                       std::size_t fractional_bits = 0) override;
   tensor::TensorCP make_tensor_sqr_op(const tensor::TensorCP input,
                                       std::size_t fractional_bits = 0) override;
+  template <typename T>
+  tensor::TensorCP basic_make_arithmetic_tensor_relu_op(const tensor::TensorCP);
   tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP) override;
   template <typename T>
   tensor::TensorCP basic_make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP);
   tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP, const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_maxpool_op(const tensor::MaxPoolOp&,
                                           const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_argmax_op(const tensor::TensorCP, bool one_hot = true) override;
   tensor::TensorCP make_tensor_avgpool_op(const tensor::AveragePoolOp&, const tensor::TensorCP,
                                           std::size_t fractional_bits = 0) override;
   //Functions defined to perform constant operations (addnl)
   tensor::TensorCP make_tensor_negate(const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k) override;
+  tensor::TensorCP make_tensor_constMatMul_op(const tensor::GemmOp& gemm_op,
+                                              const std::vector<std::uint64_t>& public_matrix,
+                                              const tensor::TensorCP input,
+                                              std::size_t fractional_bits = 0) override;
   tensor::TensorCP make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP) override;
   std::vector<tensor::TensorCP> make_tensor_split_op(const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_join_op(const tensor::JoinOp& join_op,
@@ -317,10 +348,15 @@ class BEAVYProvider : public GateFactory,
   template <typename T>
   std::pair<std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<T>>>, tensor::TensorCP >
   basic_make_arithmetic_tensor_input_shares(const tensor::TensorDimensions& dims);
+
+  // output tensor to give out the shares directly
+  template <typename T>
+  std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>>>
+  basic_make_arithmetic_tensor_output_shares(const tensor::TensorCP&);
   
   template <typename T>
   ENCRYPTO::ReusableFiberFuture<IntegerValues<T>> basic_make_arithmetic_tensor_output_my(
-      const tensor::TensorCP&);
+      const tensor::TensorCP&, tensor::OutputSinkP);
 
  private:
   Communication::CommunicationLayer& communication_layer_;
@@ -334,6 +370,7 @@ class BEAVYProvider : public GateFactory,
   std::size_t next_input_id_;
   std::shared_ptr<Logger> logger_;
   bool fake_setup_;
+  std::shared_ptr<LinAlgTripleProvider> linalg_triple_provider_;
 };
 
 }  // namespace proto::beavy
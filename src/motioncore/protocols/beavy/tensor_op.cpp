@@ -22,11 +22,9 @@
 
 #include "tensor_op.h"
 
-#include <stdlib.h>
-#include <fstream>
-#include <iostream>
 #include <parallel/algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 #include "algorithm/circuit_loader.h"
 #include "algorithm/make_circuit.h"
@@ -324,11 +322,13 @@ template <typename T>
 ArithmeticBEAVYTensorOutput<T>::ArithmeticBEAVYTensorOutput(std::size_t gate_id,
                                                             BEAVYProvider& beavy_provider,
                                                             ArithmeticBEAVYTensorCP<T> input,
-                                                            std::size_t output_owner)
+                                                            std::size_t output_owner,
+                                                            tensor::OutputSinkP output_sink)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
       output_owner_(output_owner),
-      input_(input) {
+      input_(input),
+      output_sink_(std::move(output_sink)) {
   auto my_id = beavy_provider_.get_my_id();
   if (output_owner_ == my_id) {
     secret_share_future_ = beavy_provider_.register_for_ints_message<T>(
@@ -385,148 +385,181 @@ void ArithmeticBEAVYTensorOutput<T>::evaluate_online() {
     }
   }
 
-  // std::string filename = std::filesystem::current_path();
-  // std::string filename_config = std::filesystem::current_path();
-  std::string homedir = getenv("BASE_DIR");
-  std::cout << homedir << std::endl;
-  std::string filename = homedir + "/build_debwithrelinfo_gcc";
-  std::string filename_config = homedir + "/build_debwithrelinfo_gcc";
-  // std::cout << filename << "\n";
-  std::ofstream file, file_config;
-
   auto my_id = beavy_provider_.get_my_id();
+  input_->wait_online();
+  const auto& public_share = input_->get_public_share();
+  if (output_sink_) {
+    const auto& secret_share = input_->get_secret_share();
+    if constexpr (std::is_same_v<T, std::uint64_t>) {
+      output_sink_->write(input_->get_dimensions(), public_share, secret_share);
+    } else {
+      output_sink_->write(
+          input_->get_dimensions(),
+          std::vector<std::uint64_t>(std::begin(public_share), std::end(public_share)),
+          std::vector<std::uint64_t>(std::begin(secret_share), std::end(secret_share)));
+    }
+  }
   if (output_owner_ == my_id) {
-    std::cout << "my_id is:" << my_id << "\n";
-    input_->wait_online();
-    const auto& public_share = input_->get_public_share();
-    const auto& new_secret_share = input_->get_secret_share();
     assert(public_share.size() == input_->get_dimensions().get_data_size());
     assert(secret_shares_.size() == input_->get_dimensions().get_data_size());
     __gnu_parallel::transform(std::begin(public_share), std::end(public_share),
                               std::begin(secret_shares_), std::begin(secret_shares_), std::minus{});
-
     output_promise_.set_value(std::move(secret_shares_));
+  }
 
-    std::vector<std::uint64_t> publicshare1;
-
-    for (auto i = public_share.begin(); i != public_share.end(); i++) {
-      publicshare1.push_back(*i);
-    }
-    std::vector<std::uint64_t> secretshare1;
-
-    for (auto i = new_secret_share.begin(); i != new_secret_share.end(); i++) {
-      secretshare1.push_back(*i);
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorOutput<T>::evaluate_online end", gate_id_));
     }
+  }
+}
 
-    // plugging output shares into a file for calculation for argmax for server 0
-
-    // creation of target file path
-    std::string file_ = filename + "/server1/outputshare_1";
-    // std::cout << file_ << "\n";
-
-    filename_config += "/file_config_input1";
-
-    file_config.open(filename_config, std::ios_base::out);
-    // assert(file_config);
-
-    file_config << file_;
+template <typename T>
+ENCRYPTO::ReusableFiberFuture<std::vector<T>> ArithmeticBEAVYTensorOutput<T>::get_output_future() {
+  std::size_t my_id = beavy_provider_.get_my_id();
+  if (output_owner_ == ALL_PARTIES || output_owner_ == my_id) {
+    return output_promise_.get_future();
+  } else {
+    throw std::logic_error("not this parties output");
+  }
+}
 
-    file.open(file_, std::ios_base::out);
-    // assert(file);
+template class ArithmeticBEAVYTensorOutput<std::uint32_t>;
+template class ArithmeticBEAVYTensorOutput<std::uint64_t>;
 
-    if (!file) {
-      std::cerr << " Error in reading file\n";
+template <typename T>
+ArithmeticBEAVYTensorOutputShares<T>::ArithmeticBEAVYTensorOutputShares(
+    std::size_t gate_id, BEAVYProvider& beavy_provider, ArithmeticBEAVYTensorCP<T> input)
+    : NewGate(gate_id), beavy_provider_(beavy_provider), input_(input) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorOutputShares<T> created", gate_id_));
     }
+  }
+}
 
-    file << publicshare1.size() << " ";
-    file << "1"
-         << "\n";
-
-    for (auto i = 0; i < publicshare1.size(); i++) {
-      file << publicshare1[i];
-
-      file << " ";
-
-      file << secretshare1[i];
-      file << "\n";
+template <typename T>
+void ArithmeticBEAVYTensorOutputShares<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorOutputShares<T>::evaluate_setup start", gate_id_));
     }
-
-    file.close();
-
   }
 
-  else {
-    // plugging output shares into a file for calculation for argmax for server 1
-    std::cout << "my_id is:" << my_id << "\n";
-    // creation of target file path
-
-    std::string file_ = filename + "/server0/outputshare_0";
-    // std::cout << file_ << "\n";
-
-    filename_config += "/file_config_input0";
+  input_->wait_setup();
+  secret_share_promise_.set_value(input_->get_secret_share());
 
-    file_config.open(filename_config, std::ios_base::out);
-    // assert(file_config);
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorOutputShares<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
 
-    file_config << file_;
+template <typename T>
+void ArithmeticBEAVYTensorOutputShares<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorOutputShares<T>::evaluate_online start", gate_id_));
+    }
+  }
 
-    file.open(file_, std::ios_base::out);
+  input_->wait_online();
+  public_share_promise_.set_value(input_->get_public_share());
 
-    if (!file) {
-      std::cerr << " Error in reading file\n";
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorOutputShares<T>::evaluate_online end", gate_id_));
     }
+  }
+}
 
-    input_->wait_online();
-    const auto& public_share0 = input_->get_public_share();
-    const auto& new_secret_share0 = input_->get_secret_share();
-    std::vector<std::uint64_t> publicshare2;
+template <typename T>
+std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>>
+ArithmeticBEAVYTensorOutputShares<T>::get_output_futures() {
+  std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>> output_futures;
+  output_futures.push_back(public_share_promise_.get_future());
+  output_futures.push_back(secret_share_promise_.get_future());
+  return output_futures;
+}
 
-    for (auto i = public_share0.begin(); i != public_share0.end(); i++) {
-      publicshare2.push_back(*i);
-    }
-    std::vector<std::uint64_t> secretshare2;
+template class ArithmeticBEAVYTensorOutputShares<std::uint32_t>;
+template class ArithmeticBEAVYTensorOutputShares<std::uint64_t>;
 
-    for (auto i = new_secret_share0.begin(); i != new_secret_share0.end(); i++) {
-      secretshare2.push_back(*i);
+BooleanBEAVYTensorOutputShares::BooleanBEAVYTensorOutputShares(std::size_t gate_id,
+                                                               BEAVYProvider& beavy_provider,
+                                                               BooleanBEAVYTensorCP input)
+    : NewGate(gate_id), beavy_provider_(beavy_provider), input_(input) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanBEAVYTensorOutputShares created", gate_id_));
     }
+  }
+}
 
-    file << publicshare2.size() << " ";
-    file << "1"
-         << "\n";
+void BooleanBEAVYTensorOutputShares::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorOutputShares::evaluate_setup start", gate_id_));
+    }
+  }
 
-    for (auto i = 0; i < publicshare2.size(); i++) {
-      file << publicshare2[i];
-      file << " ";
+  input_->wait_setup();
+  secret_share_promise_.set_value(input_->get_secret_share());
 
-      file << secretshare2[i];
-      file << "\n";
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorOutputShares::evaluate_setup end", gate_id_));
     }
+  }
+}
 
-    file.close();
+void BooleanBEAVYTensorOutputShares::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorOutputShares::evaluate_online start", gate_id_));
+    }
   }
 
+  input_->wait_online();
+  public_share_promise_.set_value(input_->get_public_share());
+
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
       logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorOutput<T>::evaluate_online end", gate_id_));
+          fmt::format("Gate {}: BooleanBEAVYTensorOutputShares::evaluate_online end", gate_id_));
     }
   }
 }
 
-template <typename T>
-ENCRYPTO::ReusableFiberFuture<std::vector<T>> ArithmeticBEAVYTensorOutput<T>::get_output_future() {
-  std::size_t my_id = beavy_provider_.get_my_id();
-  if (output_owner_ == ALL_PARTIES || output_owner_ == my_id) {
-    return output_promise_.get_future();
-  } else {
-    throw std::logic_error("not this parties output");
-  }
+std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+BooleanBEAVYTensorOutputShares::get_output_futures() {
+  std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>> output_futures;
+  output_futures.push_back(public_share_promise_.get_future());
+  output_futures.push_back(secret_share_promise_.get_future());
+  return output_futures;
 }
 
-template class ArithmeticBEAVYTensorOutput<std::uint32_t>;
-template class ArithmeticBEAVYTensorOutput<std::uint64_t>;
-
 template <typename T>
 ArithmeticBEAVYTensorFlatten<T>::ArithmeticBEAVYTensorFlatten(
     std::size_t gate_id, BEAVYProvider& beavy_provider, std::size_t axis,
@@ -769,6 +802,7 @@ ArithmeticBEAVYTensorGemm<T>::ArithmeticBEAVYTensorGemm(std::size_t gate_id,
                                                         tensor::GemmOp gemm_op,
                                                         const ArithmeticBEAVYTensorCP<T> input_A,
                                                         const ArithmeticBEAVYTensorCP<T> input_B,
+                                                        const ArithmeticBEAVYTensorCP<T> bias,
                                                         std::size_t fractional_bits)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
@@ -776,24 +810,38 @@ ArithmeticBEAVYTensorGemm<T>::ArithmeticBEAVYTensorGemm(std::size_t gate_id,
       fractional_bits_(fractional_bits),
       input_A_(input_A),
       input_B_(input_B),
-      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(gemm_op.get_output_tensor_dims())) {
+      bias_(bias),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(gemm_op.get_output_tensor_dims())),
+      row_tiles_(gemm_op.compute_row_tiles()) {
   const auto my_id = beavy_provider_.get_my_id();
   const auto output_size = gemm_op_.compute_output_size();
   share_future_ = beavy_provider_.register_for_ints_message<T>(1 - my_id, gate_id_, output_size);
   auto& ap = beavy_provider_.get_arith_manager().get_provider(1 - my_id);
-  const auto dim_l = gemm_op_.input_A_shape_[0];
-  const auto dim_m = gemm_op_.input_A_shape_[1];
-  const auto dim_n = gemm_op_.input_B_shape_[1];
-  if (!beavy_provider_.get_fake_setup()) {
-    mm_lhs_side_ = ap.template register_matrix_multiplication_lhs<T>(dim_l, dim_m, dim_n);
-    mm_rhs_side_ = ap.template register_matrix_multiplication_rhs<T>(dim_l, dim_m, dim_n);
+  if (!beavy_provider_.get_fake_setup() && beavy_provider_.get_linalg_triple_provider() != nullptr) {
+    linalg_triple_provider_ = beavy_provider_.get_linalg_triple_provider();
+    triple_index_ = linalg_triple_provider_->register_for_gemm_triple<T>(gemm_op_);
+    // message 0 is [Delta_y]_i in the online phase
+    masked_deltas_future_ = beavy_provider_.register_for_ints_message<T>(
+        1 - my_id, gate_id_, gemm_op_.compute_input_A_size() + gemm_op_.compute_input_B_size(),
+        1);
+  } else if (!beavy_provider_.get_fake_setup()) {
+    mm_lhs_sides_.reserve(row_tiles_.size());
+    mm_rhs_sides_.reserve(row_tiles_.size());
+    for (const auto& tile : row_tiles_) {
+      const auto dim_l = tile.input_A_shape_[0];
+      const auto dim_m = tile.input_A_shape_[1];
+      const auto dim_n = tile.input_B_shape_[1];
+      mm_lhs_sides_.push_back(ap.template register_matrix_multiplication_lhs<T>(dim_l, dim_m, dim_n));
+      mm_rhs_sides_.push_back(ap.template register_matrix_multiplication_rhs<T>(dim_l, dim_m, dim_n));
+    }
   }
   Delta_y_share_.resize(output_size);
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T> created", gate_id_));
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorGemm<T> created with {} row tiles",
+                                   gate_id_, row_tiles_.size()));
     }
   }
 }
@@ -818,48 +866,26 @@ void ArithmeticBEAVYTensorGemm<T>::evaluate_setup() {
 
   input_A_->wait_setup();
   input_B_->wait_setup();
+  if (bias_ != nullptr) {
+    bias_->wait_setup();
+  }
 
   const auto& delta_a_share = input_A_->get_secret_share();
   const auto& delta_b_share = input_B_->get_secret_share();
-  const auto& delta_y_share = output_->get_secret_share();
 
-  if (!beavy_provider_.get_fake_setup()) {
-    mm_lhs_side_->set_input(delta_a_share);
-    mm_rhs_side_->set_input(delta_b_share);
+  // [Delta_y]_i = [delta_a * delta_b]_i
+  if (linalg_triple_provider_ != nullptr) {
+    compute_delta_ab_share_from_triple(delta_a_share, delta_b_share);
+  } else {
+    compute_delta_ab_share_from_ots(delta_a_share, delta_b_share);
   }
 
-  // [Delta_y]_i = [delta_a]_i * [delta_b]_i
-  matrix_multiply(gemm_op_, delta_a_share.data(), delta_b_share.data(), Delta_y_share_.data());
-
   if (fractional_bits_ == 0) {
     // [Delta_y]_i += [delta_y]_i
-    __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
-                              std::begin(delta_y_share), std::begin(Delta_y_share_), std::plus{});
+    add_delta_y_share(Delta_y_share_);
     // NB: happens after truncation if that is requested
   }
 
-  if (!beavy_provider_.get_fake_setup()) {
-    mm_lhs_side_->compute_output();
-    mm_rhs_side_->compute_output();
-  }
-  std::vector<T> delta_ab_share1;
-  std::vector<T> delta_ab_share2;
-  if (beavy_provider_.get_fake_setup()) {
-    delta_ab_share1 = Helpers::RandomVector<T>(gemm_op_.compute_output_size());
-    delta_ab_share2 = Helpers::RandomVector<T>(gemm_op_.compute_output_size());
-  } else {
-    // [[delta_a]_i * [delta_b]_(1-i)]_i
-    delta_ab_share1 = mm_lhs_side_->get_output();
-    // [[delta_b]_i * [delta_a]_(1-i)]_i
-    delta_ab_share2 = mm_rhs_side_->get_output();
-  }
-  // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
-  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
-                            std::begin(delta_ab_share1), std::begin(Delta_y_share_), std::plus{});
-  // [Delta_y]_i += [[delta_b]_i * [delta_a]_(1-i)]_i
-  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
-                            std::begin(delta_ab_share2), std::begin(Delta_y_share_), std::plus{});
-
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
@@ -869,6 +895,100 @@ void ArithmeticBEAVYTensorGemm<T>::evaluate_setup() {
   }
 }
 
+template <typename T>
+void ArithmeticBEAVYTensorGemm<T>::compute_delta_ab_share_from_ots(
+    const std::vector<T>& delta_a_share, const std::vector<T>& delta_b_share) {
+  // [Delta_y]_i = [delta_a]_i * [delta_b]_i
+  matrix_multiply(gemm_op_, delta_a_share.data(), delta_b_share.data(), Delta_y_share_.data());
+
+  // the cross terms are computed tile by tile, so that only the triples of one tile are alive
+  std::size_t row_offset = 0;
+  for (std::size_t tile_i = 0; tile_i < row_tiles_.size(); ++tile_i) {
+    const auto& tile = row_tiles_[tile_i];
+    const auto tile_output_size = tile.compute_output_size();
+    const auto output_offset = row_offset * tile.output_shape_[1];
+    std::vector<T> delta_ab_share1;
+    std::vector<T> delta_ab_share2;
+    if (beavy_provider_.get_fake_setup()) {
+      delta_ab_share1 = Helpers::RandomVector<T>(tile_output_size);
+      delta_ab_share2 = Helpers::RandomVector<T>(tile_output_size);
+    } else {
+      auto& mm_lhs_side = mm_lhs_sides_[tile_i];
+      auto& mm_rhs_side = mm_rhs_sides_[tile_i];
+      mm_lhs_side->set_input(delta_a_share.data() + row_offset * tile.input_A_shape_[1]);
+      mm_rhs_side->set_input(delta_b_share);
+      mm_lhs_side->compute_output();
+      mm_rhs_side->compute_output();
+      // [[delta_a]_i * [delta_b]_(1-i)]_i
+      delta_ab_share1 = mm_lhs_side->get_output();
+      // [[delta_b]_i * [delta_a]_(1-i)]_i
+      delta_ab_share2 = mm_rhs_side->get_output();
+      mm_lhs_side.reset();
+      mm_rhs_side.reset();
+    }
+    auto Delta_y_tile = std::begin(Delta_y_share_) + output_offset;
+    // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
+    __gnu_parallel::transform(Delta_y_tile, Delta_y_tile + tile_output_size,
+                              std::begin(delta_ab_share1), Delta_y_tile, std::plus{});
+    // [Delta_y]_i += [[delta_b]_i * [delta_a]_(1-i)]_i
+    __gnu_parallel::transform(Delta_y_tile, Delta_y_tile + tile_output_size,
+                              std::begin(delta_ab_share2), Delta_y_tile, std::plus{});
+    row_offset += tile.output_shape_[0];
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorGemm<T>::compute_delta_ab_share_from_triple(
+    const std::vector<T>& delta_a_share, const std::vector<T>& delta_b_share) {
+  auto triple = linalg_triple_provider_->get_gemm_triple<T>(gemm_op_, triple_index_);
+  const auto input_A_size = gemm_op_.compute_input_A_size();
+
+  // mask the secret shares: d = delta_a - a, e = delta_b - b
+  std::vector<T> de(input_A_size + gemm_op_.compute_input_B_size());
+  auto it = __gnu_parallel::transform(std::begin(delta_a_share), std::end(delta_a_share),
+                                      std::begin(triple.a_), std::begin(de), std::minus{});
+  __gnu_parallel::transform(std::begin(delta_b_share), std::end(delta_b_share),
+                            std::begin(triple.b_), it, std::minus{});
+  beavy_provider_.send_ints_message(1 - beavy_provider_.get_my_id(), gate_id_, de, 1);
+  const auto de_other = masked_deltas_future_.get();
+  __gnu_parallel::transform(std::begin(de), std::end(de), std::begin(de_other), std::begin(de),
+                            std::plus{});
+
+  // [delta_a * delta_b]_i = [c]_i - d * e + [delta_a]_i * e + d * [delta_b]_i, where d * e is
+  // subtracted by one party
+  Delta_y_share_ = std::move(triple.c_);
+  std::vector<T> tmp(Delta_y_share_.size());
+  if (beavy_provider_.is_my_job(gate_id_)) {
+    matrix_multiply(gemm_op_, de.data(), de.data() + input_A_size, tmp.data());
+    __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
+                              std::begin(tmp), std::begin(Delta_y_share_), std::minus{});
+  }
+  matrix_multiply(gemm_op_, delta_a_share.data(), de.data() + input_A_size, tmp.data());
+  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_), std::begin(tmp),
+                            std::begin(Delta_y_share_), std::plus{});
+  matrix_multiply(gemm_op_, de.data(), delta_b_share.data(), tmp.data());
+  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_), std::begin(tmp),
+                            std::begin(Delta_y_share_), std::plus{});
+}
+
+// with a bias, the output mask is delta_z = delta_y + delta_bias, so [delta_y]_i = [delta_z]_i -
+// [delta_bias]_i
+template <typename T>
+void ArithmeticBEAVYTensorGemm<T>::add_delta_y_share(std::vector<T>& Delta_y_share) const {
+  const auto& delta_z_share = output_->get_secret_share();
+  if (bias_ == nullptr) {
+    __gnu_parallel::transform(std::begin(Delta_y_share), std::end(Delta_y_share),
+                              std::begin(delta_z_share), std::begin(Delta_y_share), std::plus{});
+    return;
+  }
+  const auto& delta_bias_share = bias_->get_secret_share();
+  const auto size = Delta_y_share.size();
+#pragma omp parallel for
+  for (std::size_t i = 0; i < size; ++i) {
+    Delta_y_share[i] += delta_z_share[i] - delta_bias_share[i];
+  }
+}
+
 template <typename T>
 void ArithmeticBEAVYTensorGemm<T>::evaluate_online() {
   if constexpr (MOTION_VERBOSE_DEBUG) {
@@ -879,50 +999,77 @@ void ArithmeticBEAVYTensorGemm<T>::evaluate_online() {
     }
   }
 
-  const auto output_size = gemm_op_.compute_output_size();
   input_A_->wait_online();
   input_B_->wait_online();
   const auto& Delta_a = input_A_->get_public_share();
   const auto& Delta_b = input_B_->get_public_share();
   const auto& delta_a_share = input_A_->get_secret_share();
   const auto& delta_b_share = input_B_->get_secret_share();
-  std::vector<T> tmp(output_size);
+  const bool my_job = beavy_provider_.is_my_job(gate_id_);
 
   // after setup phase, `Delta_y_share_` contains [delta_y]_i + [delta_ab]_i
 
-  // [Delta_y]_i -= Delta_a * [delta_b]_i
-  matrix_multiply(gemm_op_, Delta_a.data(), delta_b_share.data(), tmp.data());
-  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_), std::begin(tmp),
-                            std::begin(Delta_y_share_), std::minus{});
-
-  // [Delta_y]_i -= Delta_b * [delta_a]_i
-  matrix_multiply(gemm_op_, delta_a_share.data(), Delta_b.data(), tmp.data());
-  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_), std::begin(tmp),
-                            std::begin(Delta_y_share_), std::minus{});
+  // Delta_a * Delta_b - Delta_a * [delta_b]_i - [delta_a]_i * Delta_b needs only two products:
+  // [Delta_y]_i += Delta_a * (c * Delta_b - [delta_b]_i) - [delta_a]_i * Delta_b, where c = 1 for
+  // the party that adds Delta_ab and c = 0 for the other one
+  std::vector<T> Delta_b_minus_delta_b(Delta_b.size());
+#pragma omp parallel for
+  for (std::size_t i = 0; i < Delta_b.size(); ++i) {
+    Delta_b_minus_delta_b[i] = (my_job ? Delta_b[i] : T(0)) - delta_b_share[i];
+  }
 
-  // [Delta_y]_i += Delta_ab (== Delta_a * Delta_b)
-  if (beavy_provider_.is_my_job(gate_id_)) {
-    matrix_multiply(gemm_op_, Delta_a.data(), Delta_b.data(), tmp.data());
-    __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_), std::begin(tmp),
-                              std::begin(Delta_y_share_), std::plus{});
+  std::size_t row_offset = 0;
+  for (const auto& tile : row_tiles_) {
+    const auto input_offset = row_offset * tile.input_A_shape_[1];
+    matrix_multiply_accumulate(tile, Delta_a.data() + input_offset, Delta_b_minus_delta_b.data(),
+                               delta_a_share.data() + input_offset, Delta_b.data(),
+                               Delta_y_share_.data() + row_offset * tile.output_shape_[1]);
+    row_offset += tile.output_shape_[0];
   }
+  Delta_b_minus_delta_b = {};
 
   if (fractional_bits_ > 0) {
-    fixed_point::truncate_shared<T>(Delta_y_share_.data(), fractional_bits_, Delta_y_share_.size(),
-                                    beavy_provider_.is_my_job(gate_id_));
-    // [Delta_y]_i += [delta_y]_i
-    __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
-                              std::begin(output_->get_secret_share()), std::begin(Delta_y_share_),
-                              std::plus{});
+    // truncate and add [delta_y]_i in a single pass
+    const auto& delta_z_share = output_->get_secret_share();
+    const auto size = Delta_y_share_.size();
+    const auto fractional_bits = fractional_bits_;
+    if (bias_ == nullptr) {
+#pragma omp parallel for
+      for (std::size_t i = 0; i < size; ++i) {
+        Delta_y_share_[i] =
+            fixed_point::truncate_share(Delta_y_share_[i], fractional_bits, my_job) +
+            delta_z_share[i];
+      }
+    } else {
+      const auto& delta_bias_share = bias_->get_secret_share();
+#pragma omp parallel for
+      for (std::size_t i = 0; i < size; ++i) {
+        Delta_y_share_[i] =
+            fixed_point::truncate_share(Delta_y_share_[i], fractional_bits, my_job) +
+            delta_z_share[i] - delta_bias_share[i];
+      }
+    }
     // NB: happens in setup phase if no truncation is requested
   }
 
   // broadcast [Delta_y]_i
   beavy_provider_.broadcast_ints_message(gate_id_, Delta_y_share_);
-  // Delta_y = [Delta_y]_i + [Delta_y]_(1-i)
-  __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
-                            std::begin(share_future_.get()), std::begin(Delta_y_share_),
-                            std::plus{});
+  const auto Delta_y_share_other = share_future_.get();
+  if (bias_ == nullptr) {
+    // Delta_y = [Delta_y]_i + [Delta_y]_(1-i)
+    __gnu_parallel::transform(std::begin(Delta_y_share_), std::end(Delta_y_share_),
+                              std::begin(Delta_y_share_other), std::begin(Delta_y_share_),
+                              std::plus{});
+  } else {
+    // Delta_z = [Delta_y]_i + [Delta_y]_(1-i) + Delta_bias
+    bias_->wait_online();
+    const auto& Delta_bias = bias_->get_public_share();
+    const auto size = Delta_y_share_.size();
+#pragma omp parallel for
+    for (std::size_t i = 0; i < size; ++i) {
+      Delta_y_share_[i] += Delta_y_share_other[i] + Delta_bias[i];
+    }
+  }
   output_->get_public_share() = std::move(Delta_y_share_);
   output_->set_online_ready();
 
@@ -1599,65 +1746,184 @@ void ArithmeticBEAVYTensorConstMul<T>::evaluate_online() {
 template class ArithmeticBEAVYTensorConstMul<std::uint32_t>;
 template class ArithmeticBEAVYTensorConstMul<std::uint64_t>;
 
-// Implementation of Addition with Tensor (addnl)
 template <typename T>
-ArithmeticBEAVYTensorAdd<T>::ArithmeticBEAVYTensorAdd(std::size_t gate_id,
-                                                      BEAVYProvider& beavy_provider,
-                                                      const ArithmeticBEAVYTensorCP<T> inputA,
-                                                      const ArithmeticBEAVYTensorCP<T> inputB)
+ArithmeticBEAVYTensorConstMatMul<T>::ArithmeticBEAVYTensorConstMatMul(
+    std::size_t gate_id, BEAVYProvider& beavy_provider, tensor::GemmOp gemm_op,
+    std::vector<T> public_matrix, const ArithmeticBEAVYTensorCP<T> input,
+    std::size_t fractional_bits)
     : NewGate(gate_id),
       beavy_provider_(beavy_provider),
-      input_A_(inputA),
-      input_B_(inputB),
-      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(inputA->get_dimensions())) {
-  const auto my_id = beavy_provider_.get_my_id();
-  const auto output_size = input_A_->get_dimensions().get_data_size();
-  Delta_y_.resize(output_size);
+      gemm_op_(gemm_op),
+      fractional_bits_(fractional_bits),
+      public_matrix_(std::move(public_matrix)),
+      input_(input),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(gemm_op.get_output_tensor_dims())) {
+  assert(public_matrix_.size() == gemm_op_.compute_input_A_size());
+  if (fractional_bits_ > 0) {
+    const auto my_id = beavy_provider_.get_my_id();
+    share_future_ = beavy_provider_.register_for_ints_message<T>(
+        1 - my_id, gate_id_, gemm_op_.compute_output_size());
+  }
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T> created", gate_id_));
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorConstMatMul<T> created", gate_id_));
     }
   }
 }
 
 template <typename T>
-ArithmeticBEAVYTensorAdd<T>::~ArithmeticBEAVYTensorAdd() = default;
+ArithmeticBEAVYTensorConstMatMul<T>::~ArithmeticBEAVYTensorConstMatMul() = default;
 
 template <typename T>
-void ArithmeticBEAVYTensorAdd<T>::evaluate_setup() {
+void ArithmeticBEAVYTensorConstMatMul<T>::evaluate_setup() {
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T>::evaluate_setup start", gate_id_));
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorConstMatMul<T>::evaluate_setup start", gate_id_));
     }
   }
 
-  const auto output_size = input_A_->get_dimensions().get_data_size();
-
-  input_A_->wait_setup();
-  input_B_->wait_setup();
-
-  const auto& delta_a_share_ = input_A_->get_secret_share();
-  const auto& delta_b_share_ = input_B_->get_secret_share();
-
-  std::vector<T> constant_vector(output_size, 0);
-  auto& delta_y_share_ = constant_vector;
-
-  // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
-  __gnu_parallel::transform(std::begin(delta_a_share_), std::end(delta_a_share_),
-                            std::begin(delta_b_share_), std::begin(delta_y_share_), std::plus{});
-
-  output_->get_secret_share() = std::move(delta_y_share_);
+  if (fractional_bits_ > 0) {
+    // fresh mask for the truncated output
+    output_->get_secret_share() = Helpers::RandomVector<T>(gemm_op_.compute_output_size());
+  } else {
+    // [delta_y]_i = W * [delta_x]_i
+    input_->wait_setup();
+    std::vector<T> delta_y_share(gemm_op_.compute_output_size());
+    matrix_multiply(gemm_op_, public_matrix_.data(), input_->get_secret_share().data(),
+                    delta_y_share.data());
+    output_->get_secret_share() = std::move(delta_y_share);
+  }
   output_->set_setup_ready();
 
   if constexpr (MOTION_VERBOSE_DEBUG) {
     auto logger = beavy_provider_.get_logger();
     if (logger) {
-      logger->LogTrace(
-          fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T>::evaluate_setup end", gate_id_));
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorConstMatMul<T>::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorConstMatMul<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorConstMatMul<T>::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+  const auto& Delta_x = input_->get_public_share();
+  std::vector<T> Delta_y(gemm_op_.compute_output_size());
+
+  if (fractional_bits_ == 0) {
+    // Delta_y = W * Delta_x
+    matrix_multiply(gemm_op_, public_matrix_.data(), Delta_x.data(), Delta_y.data());
+  } else {
+    // [y]_i = W * (c * Delta_x - [delta_x]_i), where c = 1 for the party that adds Delta_x
+    const auto& delta_x_share = input_->get_secret_share();
+    const bool my_job = beavy_provider_.is_my_job(gate_id_);
+    std::vector<T> x_share(Delta_x.size());
+#pragma omp parallel for
+    for (std::size_t i = 0; i < x_share.size(); ++i) {
+      x_share[i] = (my_job ? Delta_x[i] : T(0)) - delta_x_share[i];
+    }
+    matrix_multiply(gemm_op_, public_matrix_.data(), x_share.data(), Delta_y.data());
+
+    // [Delta_y]_i = trunc([y]_i) + [delta_y]_i
+    const auto& delta_y_share = output_->get_secret_share();
+    const auto fractional_bits = fractional_bits_;
+#pragma omp parallel for
+    for (std::size_t i = 0; i < Delta_y.size(); ++i) {
+      Delta_y[i] = fixed_point::truncate_share(Delta_y[i], fractional_bits, my_job) +
+                   delta_y_share[i];
+    }
+    beavy_provider_.broadcast_ints_message(gate_id_, Delta_y);
+    const auto Delta_y_share_other = share_future_.get();
+    __gnu_parallel::transform(std::begin(Delta_y), std::end(Delta_y),
+                              std::begin(Delta_y_share_other), std::begin(Delta_y), std::plus{});
+  }
+  output_->get_public_share() = std::move(Delta_y);
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorConstMatMul<T>::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorConstMatMul<std::uint32_t>;
+template class ArithmeticBEAVYTensorConstMatMul<std::uint64_t>;
+
+// Implementation of Addition with Tensor (addnl)
+template <typename T>
+ArithmeticBEAVYTensorAdd<T>::ArithmeticBEAVYTensorAdd(std::size_t gate_id,
+                                                      BEAVYProvider& beavy_provider,
+                                                      const ArithmeticBEAVYTensorCP<T> inputA,
+                                                      const ArithmeticBEAVYTensorCP<T> inputB)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      input_A_(inputA),
+      input_B_(inputB),
+      output_(std::make_shared<ArithmeticBEAVYTensor<T>>(inputA->get_dimensions())) {
+  const auto my_id = beavy_provider_.get_my_id();
+  const auto output_size = input_A_->get_dimensions().get_data_size();
+  Delta_y_.resize(output_size);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T> created", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+ArithmeticBEAVYTensorAdd<T>::~ArithmeticBEAVYTensorAdd() = default;
+
+template <typename T>
+void ArithmeticBEAVYTensorAdd<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T>::evaluate_setup start", gate_id_));
+    }
+  }
+
+  const auto output_size = input_A_->get_dimensions().get_data_size();
+
+  input_A_->wait_setup();
+  input_B_->wait_setup();
+
+  const auto& delta_a_share_ = input_A_->get_secret_share();
+  const auto& delta_b_share_ = input_B_->get_secret_share();
+
+  std::vector<T> constant_vector(output_size, 0);
+  auto& delta_y_share_ = constant_vector;
+
+  // [Delta_y]_i += [[delta_a]_i * [delta_b]_(1-i)]_i
+  __gnu_parallel::transform(std::begin(delta_a_share_), std::end(delta_a_share_),
+                            std::begin(delta_b_share_), std::begin(delta_y_share_), std::plus{});
+
+  output_->get_secret_share() = std::move(delta_y_share_);
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorAdd<T>::evaluate_setup end", gate_id_));
     }
   }
 }
@@ -2188,7 +2454,9 @@ BooleanXArithmeticBEAVYTensorRelu<T>::BooleanXArithmeticBEAVYTensorRelu(
   if (input_bool_->get_dimensions() != input_arith_->get_dimensions()) {
     throw std::invalid_argument("dimension mismatch");
   }
-  if (input_bool_->get_bit_size() != input_arith_->get_bit_size()) {
+  // either the full Boolean sharing of the input or only its sign bit
+  if (input_bool_->get_bit_size() != input_arith_->get_bit_size() &&
+      input_bool_->get_bit_size() != 1) {
     throw std::invalid_argument("bit size mismatch");
   }
   const auto my_id = beavy_provider_.get_my_id();
@@ -2232,7 +2500,7 @@ void BooleanXArithmeticBEAVYTensorRelu<T>::evaluate_setup() {
   input_arith_->wait_setup();
   const auto& int_sshare = input_arith_->get_secret_share();
   assert(int_sshare.size() == data_size_);
-  const auto& msb_sshare = input_bool_->get_secret_share()[bit_size_ - 1];
+  const auto& msb_sshare = input_bool_->get_secret_share().back();
   assert(msb_sshare.GetSize() == data_size_);
 
   std::vector<T> msb_sshare_as_ints(data_size_);
@@ -2301,7 +2569,7 @@ void BooleanXArithmeticBEAVYTensorRelu<T>::evaluate_online() {
   const auto& int_sshare = input_arith_->get_secret_share();
   const auto& int_pshare = input_arith_->get_public_share();
   assert(int_pshare.size() == data_size_);
-  const auto& msb_pshare = input_bool_->get_public_share()[bit_size_ - 1];
+  const auto& msb_pshare = input_bool_->get_public_share().back();
   assert(msb_pshare.GetSize() == data_size_);
 
   const auto& sshare = output_->get_secret_share();
@@ -2339,6 +2607,228 @@ void BooleanXArithmeticBEAVYTensorRelu<T>::evaluate_online() {
 template class BooleanXArithmeticBEAVYTensorRelu<std::uint32_t>;
 template class BooleanXArithmeticBEAVYTensorRelu<std::uint64_t>;
 
+template <typename T>
+ArithmeticBEAVYTensorSign<T>::ArithmeticBEAVYTensorSign(std::size_t gate_id,
+                                                        BEAVYProvider& beavy_provider,
+                                                        const ArithmeticBEAVYTensorCP<T> input)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      data_size_(input->get_dimensions().get_data_size()),
+      input_(std::move(input)),
+      output_(std::make_shared<BooleanBEAVYTensor>(input_->get_dimensions(), 1)),
+      sign_algo_(beavy_provider_.get_circuit_loader().load_add_msb_circuit(bit_size_)) {
+  // wires 0 to bit_size_ - 1 hold the summand of the party doing the job, the remaining ones the
+  // summand of the other party
+  input_wires_.resize(2 * bit_size_);
+  std::generate(std::begin(input_wires_), std::end(input_wires_), [this] {
+    auto w = std::make_shared<BooleanBEAVYWire>(data_size_);
+    w->get_secret_share().Resize(data_size_);
+    w->get_public_share().Resize(data_size_);
+    return w;
+  });
+  {
+    WireVector in(2 * bit_size_);
+    std::transform(std::begin(input_wires_), std::end(input_wires_), std::begin(in),
+                   [](auto w) { return std::dynamic_pointer_cast<BooleanBEAVYWire>(w); });
+    auto [gates, out] = construct_circuit(beavy_provider_, sign_algo_, in);
+    gates_ = std::move(gates);
+    assert(out.size() == 1);
+    output_wire_ = std::dynamic_pointer_cast<BooleanBEAVYWire>(out.front());
+  }
+  if (!beavy_provider_.is_my_job(gate_id_)) {
+    const auto my_id = beavy_provider_.get_my_id();
+    share_future_ =
+        beavy_provider_.register_for_bits_message(1 - my_id, gate_id_, bit_size_ * data_size_);
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: ArithmeticBEAVYTensorSign created", gate_id_));
+    }
+  }
+}
+
+// x = (Delta - delta_i) + (-delta_(1-i)) where party i does the job: party i shares its summand
+// with random masks and reveals it in the online phase, the summand of the other party is already
+// known in the setup phase and is used as its secret share directly (with public share 0)
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::prepare_setup() {
+  if (beavy_provider_.is_my_job(gate_id_)) {
+    summand_sshares_.resize(bit_size_);
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      summand_sshares_[bit_j] = ENCRYPTO::BitVector<>::Random(data_size_);
+      input_wires_[bit_j]->get_secret_share() = summand_sshares_[bit_j];
+      input_wires_[bit_size_ + bit_j]->get_secret_share() =
+          ENCRYPTO::BitVector<>(data_size_, false);
+    }
+  } else {
+    input_->wait_setup();
+    const auto& sshare = input_->get_secret_share();
+    std::vector<T> summand(data_size_);
+    std::transform(std::begin(sshare), std::end(sshare), std::begin(summand), std::negate{});
+    auto summand_bits = ENCRYPTO::ToInput(summand);
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      input_wires_[bit_j]->get_secret_share() = ENCRYPTO::BitVector<>(data_size_, false);
+      input_wires_[bit_size_ + bit_j]->get_secret_share() = std::move(summand_bits[bit_j]);
+    }
+  }
+  for (auto& wire : input_wires_) {
+    wire->set_setup_ready();
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::finish_setup() {
+  output_wire_->wait_setup();
+  output_->get_secret_share()[0] = output_wire_->get_secret_share();
+  output_->set_setup_ready();
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::prepare_online() {
+  if (beavy_provider_.is_my_job(gate_id_)) {
+    input_->wait_online();
+    const auto& pshare = input_->get_public_share();
+    const auto& sshare = input_->get_secret_share();
+    std::vector<T> summand(data_size_);
+    std::transform(std::begin(pshare), std::end(pshare), std::begin(sshare), std::begin(summand),
+                   std::minus{});
+    auto summand_bits = ENCRYPTO::ToInput(summand);
+    ENCRYPTO::BitVector<> message;
+    message.Reserve(Helpers::Convert::BitsToBytes(bit_size_ * data_size_));
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      summand_bits[bit_j] ^= summand_sshares_[bit_j];
+      message.Append(summand_bits[bit_j]);
+      input_wires_[bit_j]->get_public_share() = std::move(summand_bits[bit_j]);
+    }
+    const auto my_id = beavy_provider_.get_my_id();
+    beavy_provider_.send_bits_message(1 - my_id, gate_id_, message);
+  } else {
+    const auto message = share_future_.get();
+    for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+      input_wires_[bit_j]->get_public_share() =
+          message.Subset(bit_j * data_size_, (bit_j + 1) * data_size_);
+    }
+  }
+  for (std::size_t bit_j = 0; bit_j < bit_size_; ++bit_j) {
+    input_wires_[bit_size_ + bit_j]->get_public_share() = ENCRYPTO::BitVector<>(data_size_, false);
+  }
+  for (auto& wire : input_wires_) {
+    wire->set_online_ready();
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::finish_online() {
+  output_wire_->wait_online();
+  output_->get_public_share()[0] = output_wire_->get_public_share();
+  output_->set_online_ready();
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSign::evaluate_setup start", gate_id_));
+    }
+  }
+
+  prepare_setup();
+  for (auto& gate : gates_) {
+    gate->evaluate_setup();
+  }
+  finish_setup();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSign::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::evaluate_setup_with_context(ExecutionContext& exec_ctx) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorSign::evaluate_setup_with_context start", gate_id_));
+    }
+  }
+
+  prepare_setup();
+  for (auto& gate : gates_) {
+    exec_ctx.fpool_->post([&] { gate->evaluate_setup(); });
+  }
+  finish_setup();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorSign::evaluate_setup_with_context end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSign::evaluate_online start", gate_id_));
+    }
+  }
+
+  prepare_online();
+  for (auto& gate : gates_) {
+    gate->evaluate_online();
+  }
+  finish_online();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: ArithmeticBEAVYTensorSign::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+template <typename T>
+void ArithmeticBEAVYTensorSign<T>::evaluate_online_with_context(ExecutionContext& exec_ctx) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorSign::evaluate_online_with_context start", gate_id_));
+    }
+  }
+
+  prepare_online();
+  for (auto& gate : gates_) {
+    exec_ctx.fpool_->post([&] { gate->evaluate_online(); });
+  }
+  finish_online();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: ArithmeticBEAVYTensorSign::evaluate_online_with_context end", gate_id_));
+    }
+  }
+}
+
+template class ArithmeticBEAVYTensorSign<std::uint32_t>;
+template class ArithmeticBEAVYTensorSign<std::uint64_t>;
+
 BooleanBEAVYTensorMaxPool::BooleanBEAVYTensorMaxPool(std::size_t gate_id,
                                                      BEAVYProvider& beavy_provider,
                                                      tensor::MaxPoolOp maxpool_op,
@@ -2593,4 +3083,210 @@ void BooleanBEAVYTensorMaxPool::evaluate_online_with_context(ExecutionContext& e
   }
 }
 
+
+BooleanBEAVYTensorArgmax::BooleanBEAVYTensorArgmax(std::size_t gate_id,
+                                                   BEAVYProvider& beavy_provider,
+                                                   const BooleanBEAVYTensorCP input, bool one_hot)
+    : NewGate(gate_id),
+      beavy_provider_(beavy_provider),
+      bit_size_(input->get_bit_size()),
+      num_inputs_(input->get_dimensions().get_data_size() / input->get_dimensions().width_),
+      num_simd_(input->get_dimensions().width_),
+      input_(input),
+      output_(std::make_shared<BooleanBEAVYTensor>(
+          tensor::argmax_output_dims(input->get_dimensions(), one_hot), bit_size_)),
+      argmax_algo_(beavy_provider_.get_circuit_loader().load_argmax_circuit(bit_size_, num_inputs_,
+                                                                            one_hot, true)) {
+  // every column of the tensor is a separate SIMD value of the circuit wires, the gates of
+  // independent matches of the tournament can run concurrently
+  input_wires_.resize(bit_size_ * num_inputs_);
+  std::generate(std::begin(input_wires_), std::end(input_wires_), [this] {
+    auto w = std::make_shared<BooleanBEAVYWire>(num_simd_);
+    w->get_secret_share().Resize(num_simd_);
+    w->get_public_share().Resize(num_simd_);
+    return w;
+  });
+  {
+    WireVector in(bit_size_ * num_inputs_);
+    std::transform(std::begin(input_wires_), std::end(input_wires_), std::begin(in),
+                   [](auto w) { return std::dynamic_pointer_cast<BooleanBEAVYWire>(w); });
+    auto [gates, out] = construct_circuit(beavy_provider_, argmax_algo_, in);
+    gates_ = std::move(gates);
+    assert(out.size() * num_simd_ == bit_size_ * output_->get_dimensions().get_data_size());
+    output_wires_.resize(out.size());
+    std::transform(std::begin(out), std::end(out), std::begin(output_wires_),
+                   [](auto w) { return std::dynamic_pointer_cast<BooleanBEAVYWire>(w); });
+  }
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: BooleanBEAVYTensorArgmax created", gate_id_));
+    }
+  }
+}
+
+// the circuit wires are ordered like the rows of the tensor shares: wire bit_j * num_inputs + int_i
+// holds row int_i of bit_j, with one SIMD value per column
+template <bool setup>
+static void argmax_prepare_wires(std::size_t bit_size, std::size_t num_inputs,
+                                 std::size_t num_simd, BooleanBEAVYWireVector& circuit_wires,
+                                 const std::vector<ENCRYPTO::BitVector<>>& input_shares) {
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    for (std::size_t int_i = 0; int_i < num_inputs; ++int_i) {
+      auto& wire = circuit_wires[bit_j * num_inputs + int_i];
+      auto share = input_shares[bit_j].Subset(int_i * num_simd, (int_i + 1) * num_simd);
+      if constexpr (setup) {
+        wire->get_secret_share() = std::move(share);
+        wire->set_setup_ready();
+      } else {
+        wire->get_public_share() = std::move(share);
+        wire->set_online_ready();
+      }
+    }
+  }
+}
+
+template <bool setup>
+static void argmax_collect_outputs(std::size_t bit_size, BooleanBEAVYWireVector& circuit_wires,
+                                   std::vector<ENCRYPTO::BitVector<>>& output_shares) {
+  const auto output_rows = circuit_wires.size() / bit_size;
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    ENCRYPTO::BitVector<> share;
+    for (std::size_t int_i = 0; int_i < output_rows; ++int_i) {
+      auto& wire = circuit_wires[bit_j * output_rows + int_i];
+      if constexpr (setup) {
+        wire->wait_setup();
+        share.Append(wire->get_secret_share());
+      } else {
+        wire->wait_online();
+        share.Append(wire->get_public_share());
+      }
+    }
+    output_shares[bit_j] = std::move(share);
+  }
+}
+
+void BooleanBEAVYTensorArgmax::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorArgmax::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  argmax_prepare_wires<true>(bit_size_, num_inputs_, num_simd_, input_wires_,
+                             input_->get_secret_share());
+
+  for (auto& gate : gates_) {
+    // should work since its a Boolean circuit consisting of AND, XOR, INV gates
+    gate->evaluate_setup();
+  }
+
+  argmax_collect_outputs<true>(bit_size_, output_wires_, output_->get_secret_share());
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorArgmax::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorArgmax::evaluate_setup_with_context(ExecutionContext& exec_ctx) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorArgmax::evaluate_setup_with_context start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  argmax_prepare_wires<true>(bit_size_, num_inputs_, num_simd_, input_wires_,
+                             input_->get_secret_share());
+
+  for (auto& gate : gates_) {
+    exec_ctx.fpool_->post([&] { gate->evaluate_setup(); });
+  }
+
+  argmax_collect_outputs<true>(bit_size_, output_wires_, output_->get_secret_share());
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorArgmax::evaluate_setup_with_context end", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorArgmax::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorArgmax::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  argmax_prepare_wires<false>(bit_size_, num_inputs_, num_simd_, input_wires_,
+                              input_->get_public_share());
+
+  for (auto& gate : gates_) {
+    // should work since its a Boolean circuit consisting of AND, XOR, INV gates
+    gate->evaluate_online();
+  }
+
+  argmax_collect_outputs<false>(bit_size_, output_wires_, output_->get_public_share());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: BooleanBEAVYTensorArgmax::evaluate_online end", gate_id_));
+    }
+  }
+}
+
+void BooleanBEAVYTensorArgmax::evaluate_online_with_context(ExecutionContext& exec_ctx) {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorArgmax::evaluate_online_with_context start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  argmax_prepare_wires<false>(bit_size_, num_inputs_, num_simd_, input_wires_,
+                              input_->get_public_share());
+
+  for (auto& gate : gates_) {
+    exec_ctx.fpool_->post([&] { gate->evaluate_online(); });
+  }
+
+  argmax_collect_outputs<false>(bit_size_, output_wires_, output_->get_public_share());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = beavy_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format(
+          "Gate {}: BooleanBEAVYTensorArgmax::evaluate_online_with_context end", gate_id_));
+    }
+  }
+}
+
 }  // namespace MOTION::proto::beavy
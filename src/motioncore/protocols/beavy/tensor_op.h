@@ -27,6 +27,7 @@
 #include "tensor/tensor_op.h"
 #include "utility/reusable_future.h"
 
+#include "tensor/output_sink.h"
 #include "tensor/tensor.h"
 
 namespace ENCRYPTO {
@@ -57,6 +58,7 @@ template <typename T>
 class IntegerMultiplicationSender;
 template <typename T>
 class IntegerMultiplicationReceiver;
+class LinAlgTripleProvider;
 template <typename T>
 class MatrixMultiplicationLHS;
 template <typename T>
@@ -140,11 +142,13 @@ class ArithmeticBEAVYTensorInputShares : public NewGate {
   constexpr static std::size_t bit_size_ = ENCRYPTO::bit_size_v<T>;
 };
 
+// Reconstructs a tensor for the output owner. If an output sink is given, both parties also pass
+// their shares to it in the online phase.
 template <typename T>
 class ArithmeticBEAVYTensorOutput : public NewGate {
  public:
   ArithmeticBEAVYTensorOutput(std::size_t gate_id, BEAVYProvider&, ArithmeticBEAVYTensorCP<T>,
-                            std::size_t output_owner);
+                              std::size_t output_owner, tensor::OutputSinkP output_sink = nullptr);
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
   void evaluate_setup() override;
@@ -158,6 +162,48 @@ class ArithmeticBEAVYTensorOutput : public NewGate {
   std::vector<T> secret_shares_;
   std::size_t output_owner_;
   const ArithmeticBEAVYTensorCP<T> input_;
+  const tensor::OutputSinkP output_sink_;
+};
+
+// Makes the public and the secret share of a tensor available to the caller without
+// reconstructing it, e.g. to feed them into the input of another circuit.
+template <typename T>
+class ArithmeticBEAVYTensorOutputShares : public NewGate {
+ public:
+  ArithmeticBEAVYTensorOutputShares(std::size_t gate_id, BEAVYProvider&,
+                                    ArithmeticBEAVYTensorCP<T>);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  // {public share future, secret share future}
+  std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<T>>> get_output_futures();
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  ENCRYPTO::ReusableFiberPromise<std::vector<T>> public_share_promise_;
+  ENCRYPTO::ReusableFiberPromise<std::vector<T>> secret_share_promise_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+};
+
+// Boolean counterpart of ArithmeticBEAVYTensorOutputShares: hands over the shares of a whole tensor
+// in memory, with one BitVector per bit of the elements.
+class BooleanBEAVYTensorOutputShares : public NewGate {
+ public:
+  BooleanBEAVYTensorOutputShares(std::size_t gate_id, BEAVYProvider&, BooleanBEAVYTensorCP);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  // {public share future, secret share future}
+  std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+  get_output_futures();
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  ENCRYPTO::ReusableFiberPromise<std::vector<ENCRYPTO::BitVector<>>> public_share_promise_;
+  ENCRYPTO::ReusableFiberPromise<std::vector<ENCRYPTO::BitVector<>>> secret_share_promise_;
+  const BooleanBEAVYTensorCP input_;
 };
 
 template <typename T>
@@ -208,9 +254,12 @@ class ArithmeticBEAVYTensorConv2D : public NewGate {
 template <typename T>
 class ArithmeticBEAVYTensorGemm : public NewGate {
  public:
+  // the optional bias (of the output dimensions) is added after the truncation, so that a dense
+  // layer needs a single gate
   ArithmeticBEAVYTensorGemm(std::size_t gate_id, BEAVYProvider&, tensor::GemmOp,
                             const ArithmeticBEAVYTensorCP<T> input_A,
-                            const ArithmeticBEAVYTensorCP<T> input_B, std::size_t fractional_bits);
+                            const ArithmeticBEAVYTensorCP<T> input_B,
+                            const ArithmeticBEAVYTensorCP<T> bias, std::size_t fractional_bits);
   ~ArithmeticBEAVYTensorGemm();
   bool need_setup() const noexcept override { return true; }
   bool need_online() const noexcept override { return true; }
@@ -219,16 +268,33 @@ class ArithmeticBEAVYTensorGemm : public NewGate {
   const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
 
  private:
+  void add_delta_y_share(std::vector<T>& Delta_y_share) const;
+  // [delta_a * delta_b]_i from OT-based multiplications of the cross terms, tile by tile
+  void compute_delta_ab_share_from_ots(const std::vector<T>& delta_a_share,
+                                       const std::vector<T>& delta_b_share);
+  // [delta_a * delta_b]_i from a GEMM triple of the LinAlgTripleProvider
+  void compute_delta_ab_share_from_triple(const std::vector<T>& delta_a_share,
+                                          const std::vector<T>& delta_b_share);
+
   BEAVYProvider& beavy_provider_;
   tensor::GemmOp gemm_op_;
   std::size_t fractional_bits_;
   const ArithmeticBEAVYTensorCP<T> input_A_;
   const ArithmeticBEAVYTensorCP<T> input_B_;
+  const ArithmeticBEAVYTensorCP<T> bias_;
   std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
   std::vector<T> Delta_y_share_;
-  std::unique_ptr<MOTION::MatrixMultiplicationRHS<T>> mm_rhs_side_;
-  std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>> mm_lhs_side_;
+  // blocks of output rows, see tensor::GemmOp::tile_rows_
+  std::vector<tensor::GemmOp> row_tiles_;
+  // one pair of triple sides per row tile, all of them are registered (and their OTs extended)
+  // up front, the multiplication buffers of a tile only exist while it is processed
+  std::vector<std::unique_ptr<MOTION::MatrixMultiplicationRHS<T>>> mm_rhs_sides_;
+  std::vector<std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>>> mm_lhs_sides_;
+  // alternatively, delta_a * delta_b is computed from a triple of this provider (not tiled)
+  LinAlgTripleProvider* linalg_triple_provider_ = nullptr;
+  std::size_t triple_index_;
+  ENCRYPTO::ReusableFiberFuture<std::vector<T>> masked_deltas_future_;
 };
 
 //Implementation of Tensor Join (addnl)
@@ -356,6 +422,34 @@ class ArithmeticBEAVYTensorConstMul : public NewGate {
   std::unique_ptr<MOTION::MatrixMultiplicationLHS<T>> mm_lhs_side_;
 };
 
+// Multiplication of a public matrix, e.g., the weights of a public model, with a secret tensor.
+// The product is linear in the shares of the input, so no multiplication triples are needed:
+// without truncation the gate is evaluated locally, with truncation the output is reshared in a
+// single round of the online phase.
+template <typename T>
+class ArithmeticBEAVYTensorConstMatMul : public NewGate {
+ public:
+  ArithmeticBEAVYTensorConstMatMul(std::size_t gate_id, BEAVYProvider&, tensor::GemmOp,
+                                   std::vector<T> public_matrix,
+                                   const ArithmeticBEAVYTensorCP<T> input,
+                                   std::size_t fractional_bits);
+  ~ArithmeticBEAVYTensorConstMatMul();
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_online() override;
+  const ArithmeticBEAVYTensorP<T>& get_output_tensor() const { return output_; }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  tensor::GemmOp gemm_op_;
+  std::size_t fractional_bits_;
+  const std::vector<T> public_matrix_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+  std::shared_ptr<ArithmeticBEAVYTensor<T>> output_;
+  ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
+};
+
 //Implementation of Tensor Addition (addnl)
 template <typename T>
 class ArithmeticBEAVYTensorAdd : public NewGate {
@@ -501,6 +595,40 @@ class BooleanXArithmeticBEAVYTensorRelu : public NewGate {
   ENCRYPTO::ReusableFiberFuture<std::vector<T>> share_future_;
 };
 
+// sign bit of an arithmetic tensor as a Boolean tensor of bit size 1, i.e., the msb of the sum of
+// the two values (Delta - delta_i) and -delta_(1-i) that are locally known to the parties
+template <typename T>
+class ArithmeticBEAVYTensorSign : public NewGate {
+ public:
+  ArithmeticBEAVYTensorSign(std::size_t gate_id, BEAVYProvider&,
+                            const ArithmeticBEAVYTensorCP<T> input);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_setup_with_context(ExecutionContext&) override;
+  void evaluate_online() override;
+  void evaluate_online_with_context(ExecutionContext&) override;
+  const BooleanBEAVYTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  void prepare_setup();
+  void finish_setup();
+  void prepare_online();
+  void finish_online();
+
+  BEAVYProvider& beavy_provider_;
+  static constexpr auto bit_size_ = ENCRYPTO::bit_size_v<T>;
+  const std::size_t data_size_;
+  const ArithmeticBEAVYTensorCP<T> input_;
+  const BooleanBEAVYTensorP output_;
+  const ENCRYPTO::AlgorithmDescription& sign_algo_;
+  BooleanBEAVYWireVector input_wires_;
+  std::shared_ptr<BooleanBEAVYWire> output_wire_;
+  std::vector<std::unique_ptr<NewGate>> gates_;
+  std::vector<ENCRYPTO::BitVector<>> summand_sshares_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::BitVector<>> share_future_;
+};
+
 class BooleanBEAVYTensorMaxPool : public NewGate {
  public:
   BooleanBEAVYTensorMaxPool(std::size_t gate_id, BEAVYProvider&, tensor::MaxPoolOp maxpool_op,
@@ -526,4 +654,29 @@ class BooleanBEAVYTensorMaxPool : public NewGate {
   std::vector<std::unique_ptr<NewGate>> gates_;
 };
 
+class BooleanBEAVYTensorArgmax : public NewGate {
+ public:
+  BooleanBEAVYTensorArgmax(std::size_t gate_id, BEAVYProvider&, const BooleanBEAVYTensorCP input,
+                           bool one_hot);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override;
+  void evaluate_setup_with_context(ExecutionContext&) override;
+  void evaluate_online() override;
+  void evaluate_online_with_context(ExecutionContext&) override;
+  const BooleanBEAVYTensorP& get_output_tensor() const { return output_; }
+
+ private:
+  BEAVYProvider& beavy_provider_;
+  const std::size_t bit_size_;
+  const std::size_t num_inputs_;  // values per column
+  const std::size_t num_simd_;    // columns
+  const BooleanBEAVYTensorCP input_;
+  const BooleanBEAVYTensorP output_;
+  const ENCRYPTO::AlgorithmDescription& argmax_algo_;
+  BooleanBEAVYWireVector input_wires_;
+  BooleanBEAVYWireVector output_wires_;
+  std::vector<std::unique_ptr<NewGate>> gates_;
+};
+
 }  // namespace MOTION::proto::beavy
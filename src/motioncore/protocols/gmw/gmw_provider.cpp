@@ -751,16 +751,28 @@ template ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
 GMWProvider::basic_make_arithmetic_tensor_output_my(const tensor::TensorCP&);
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-GMWProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in) {
+GMWProvider::make_arithmetic_32_tensor_output_my(const tensor::TensorCP& in,
+                                                 tensor::OutputSinkP output_sink) {
+  if (output_sink) {
+    throw std::logic_error("GMW tensor outputs do not support output sinks");
+  }
   return basic_make_arithmetic_tensor_output_my<std::uint32_t>(in);
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-GMWProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in) {
+GMWProvider::make_arithmetic_64_tensor_output_my(const tensor::TensorCP& in,
+                                                 tensor::OutputSinkP output_sink) {
+  if (output_sink) {
+    throw std::logic_error("GMW tensor outputs do not support output sinks");
+  }
   return basic_make_arithmetic_tensor_output_my<std::uint64_t>(in);
 }
 
-void GMWProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in) {
+void GMWProvider::make_arithmetic_tensor_output_other(const tensor::TensorCP& in,
+                                                      tensor::OutputSinkP output_sink) {
+  if (output_sink) {
+    throw std::logic_error("GMW tensor outputs do not support output sinks");
+  }
   std::unique_ptr<NewGate> gate;
   auto gate_id = gate_register_.get_next_gate_id();
   switch (in->get_bit_size()) {
@@ -194,11 +194,12 @@ class GMWProvider : public GateFactory,
 
   // arithmetic outputs
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>> make_arithmetic_32_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, tensor::OutputSinkP output_sink = nullptr) override;
   ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>> make_arithmetic_64_tensor_output_my(
-      const tensor::TensorCP&) override;
+      const tensor::TensorCP&, tensor::OutputSinkP output_sink = nullptr) override;
 
-  void make_arithmetic_tensor_output_other(const tensor::TensorCP&) override;
+  void make_arithmetic_tensor_output_other(const tensor::TensorCP&,
+                                           tensor::OutputSinkP output_sink = nullptr) override;
 
   // conversions
   tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input) override;
@@ -214,6 +215,7 @@ class GMWProvider : public GateFactory,
                                        const tensor::TensorCP input_A,
                                        const tensor::TensorCP input_B,
                                        std::size_t fractional_bits = 0) override;
+  using tensor::TensorOpFactory::make_tensor_gemm_op;
   tensor::TensorCP make_tensor_sqr_op(const tensor::TensorCP input,
                                       std::size_t fractional_bits = 0) override;
   tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP) override;
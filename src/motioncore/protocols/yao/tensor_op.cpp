@@ -1561,4 +1561,109 @@ void YaoTensorGTEvaluator::evaluate_online() {
   }
 }
 
+// Argmax
+
+YaoTensorArgmaxGarbler::YaoTensorArgmaxGarbler(std::size_t gate_id, YaoProvider& yao_provider,
+                                               const YaoTensorCP input, bool one_hot)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      num_inputs_(input->get_dimensions().get_data_size() / input->get_dimensions().width_),
+      num_simd_(input->get_dimensions().width_),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(
+          tensor::argmax_output_dims(input->get_dimensions(), one_hot), bit_size_)),
+      argmax_algo_(yao_provider_.get_circuit_loader().load_argmax_circuit(bit_size_, num_inputs_,
+                                                                          one_hot)) {
+  output_->get_keys().resize(num_simd_ * argmax_algo_.n_output_wires_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorArgmaxGarbler created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorArgmaxGarbler::evaluate_setup() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorArgmaxGarbler::evaluate_setup start", gate_id_));
+    }
+  }
+
+  input_->wait_setup();
+
+  // garble Argmax circuit, its wires use the bit-major layout of the tensor keys and every column
+  // of the tensor is a separate SIMD value, i.e., key bit_j * data_size + i * num_simd + k belongs
+  // to SIMD value k of wire bit_j * num_inputs + i
+  yao_provider_.create_garbled_circuit(gate_id_, num_simd_, argmax_algo_, input_->get_keys(), {},
+                                       garbled_tables_, output_->get_keys());
+  yao_provider_.send_blocks_message(gate_id_, std::move(garbled_tables_));
+  output_->set_setup_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorArgmaxGarbler::evaluate_setup end", gate_id_));
+    }
+  }
+}
+
+YaoTensorArgmaxEvaluator::YaoTensorArgmaxEvaluator(std::size_t gate_id, YaoProvider& yao_provider,
+                                                   const YaoTensorCP input, bool one_hot)
+    : NewGate(gate_id),
+      yao_provider_(yao_provider),
+      bit_size_(input->get_bit_size()),
+      num_inputs_(input->get_dimensions().get_data_size() / input->get_dimensions().width_),
+      num_simd_(input->get_dimensions().width_),
+      input_(input),
+      output_(std::make_shared<YaoTensor>(
+          tensor::argmax_output_dims(input->get_dimensions(), one_hot), bit_size_)),
+      argmax_algo_(yao_provider_.get_circuit_loader().load_argmax_circuit(bit_size_, num_inputs_,
+                                                                          one_hot)) {
+  const std::size_t num_and_gates = std::count_if(
+      std::begin(argmax_algo_.gates_), std::end(argmax_algo_.gates_),
+      [](const auto& op) { return op.type_ == ENCRYPTO::PrimitiveOperationType::AND; });
+  garbled_tables_future_ =
+      yao_provider_.register_for_blocks_message(gate_id, 2 * num_and_gates * num_simd_);
+  output_->get_keys().resize(num_simd_ * argmax_algo_.n_output_wires_);
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(fmt::format("Gate {}: YaoTensorArgmaxEvaluator created", gate_id_));
+    }
+  }
+}
+
+void YaoTensorArgmaxEvaluator::evaluate_online() {
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorArgmaxEvaluator::evaluate_online start", gate_id_));
+    }
+  }
+
+  input_->wait_online();
+
+  // evaluate Argmax circuit
+  const auto garbled_tables = garbled_tables_future_.get();
+  yao_provider_.evaluate_garbled_circuit(gate_id_, num_simd_, argmax_algo_, input_->get_keys(), {},
+                                         garbled_tables, output_->get_keys());
+  output_->set_online_ready();
+
+  if constexpr (MOTION_VERBOSE_DEBUG) {
+    auto logger = yao_provider_.get_logger();
+    if (logger) {
+      logger->LogTrace(
+          fmt::format("Gate {}: YaoTensorArgmaxEvaluator::evaluate_online end", gate_id_));
+    }
+  }
+}
+
 }  // namespace MOTION::proto::yao
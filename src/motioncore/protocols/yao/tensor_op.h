@@ -438,4 +438,45 @@ class YaoTensorGTEvaluator : public NewGate {
   const ENCRYPTO::AlgorithmDescription& maxpool_algo_;
 };
 
+class YaoTensorArgmaxGarbler : public NewGate {
+ public:
+  YaoTensorArgmaxGarbler(std::size_t gate_id, YaoProvider&, const YaoTensorCP input, bool one_hot);
+  bool need_setup() const noexcept override { return true; }
+  bool need_online() const noexcept override { return false; }
+  void evaluate_setup() override;
+  void evaluate_online() override {}
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t num_inputs_;  // values per column
+  const std::size_t num_simd_;    // columns
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::block128_vector garbled_tables_;
+  const ENCRYPTO::AlgorithmDescription& argmax_algo_;
+};
+
+class YaoTensorArgmaxEvaluator : public NewGate {
+ public:
+  YaoTensorArgmaxEvaluator(std::size_t gate_id, YaoProvider&, const YaoTensorCP input,
+                           bool one_hot);
+  bool need_setup() const noexcept override { return false; }
+  bool need_online() const noexcept override { return true; }
+  void evaluate_setup() override {}
+  void evaluate_online() override;
+  YaoTensorCP get_output_tensor() const noexcept { return output_; }
+
+ private:
+  YaoProvider& yao_provider_;
+  const std::size_t bit_size_;
+  const std::size_t num_inputs_;  // values per column
+  const std::size_t num_simd_;    // columns
+  const YaoTensorCP input_;
+  const YaoTensorP output_;
+  ENCRYPTO::ReusableFiberFuture<ENCRYPTO::block128_vector> garbled_tables_future_;
+  const ENCRYPTO::AlgorithmDescription& argmax_algo_;
+};
+
 }  // namespace MOTION::proto::yao
@@ -1132,4 +1132,23 @@ tensor::TensorCP YaoProvider::make_tensor_gt_op(const tensor::MaxPoolOp& maxpool
   return output;
 }
 
+tensor::TensorCP YaoProvider::make_tensor_argmax_op(const tensor::TensorCP in, bool one_hot) {
+  const auto input_tensor = std::dynamic_pointer_cast<const YaoTensor>(in);
+  assert(input_tensor != nullptr);
+  auto gate_id = gate_register_.get_next_gate_id();
+  tensor::TensorCP output;
+  if (role_ == Role::garbler) {
+    auto tensor_op =
+        std::make_unique<YaoTensorArgmaxGarbler>(gate_id, *this, input_tensor, one_hot);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  } else {
+    auto tensor_op =
+        std::make_unique<YaoTensorArgmaxEvaluator>(gate_id, *this, input_tensor, one_hot);
+    output = tensor_op->get_output_tensor();
+    gate_register_.register_gate(std::move(tensor_op));
+  }
+  return output;
+}
+
 }  // namespace MOTION::proto::yao
@@ -216,6 +216,7 @@ class YaoProvider : public GateFactory,
                                           const tensor::TensorCP) override;
   tensor::TensorCP make_tensor_gt_op(const tensor::MaxPoolOp&,
                                           const tensor::TensorCP) override;
+  tensor::TensorCP make_tensor_argmax_op(const tensor::TensorCP, bool one_hot = true) override;
 
  private:
   Communication::CommunicationLayer& communication_layer_;
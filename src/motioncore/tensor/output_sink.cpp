@@ -0,0 +1,225 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "output_sink.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "utility/share_file.h"
+
+namespace MOTION::tensor {
+
+namespace {
+
+void check_share_sizes(const TensorDimensions& dims, std::span<const std::uint64_t> public_share,
+                       std::span<const std::uint64_t> secret_share) {
+  if (public_share.size() != dims.get_data_size() || secret_share.size() != dims.get_data_size()) {
+    throw std::invalid_argument(
+        fmt::format("expected {} shares for the output tensor, got {} and {}",
+                    dims.get_data_size(), public_share.size(), secret_share.size()));
+  }
+}
+
+}  // namespace
+
+void MemoryOutputSink::write(const TensorDimensions& dims,
+                             std::span<const std::uint64_t> public_share,
+                             std::span<const std::uint64_t> secret_share) {
+  check_share_sizes(dims, public_share, secret_share);
+  dimensions_ = dims;
+  public_share_.assign(std::begin(public_share), std::end(public_share));
+  secret_share_.assign(std::begin(secret_share), std::end(secret_share));
+}
+
+ShareFileOutputSink::ShareFileOutputSink(std::string path, std::size_t fractional_bits)
+    : path_(std::move(path)), fractional_bits_(fractional_bits) {}
+
+void ShareFileOutputSink::write(const TensorDimensions& dims,
+                                std::span<const std::uint64_t> public_share,
+                                std::span<const std::uint64_t> secret_share) {
+  check_share_sizes(dims, public_share, secret_share);
+  write_share_file(path_, dims.get_data_size() / dims.width_, dims.width_, fractional_bits_,
+                   public_share.data(), secret_share.data());
+}
+
+TextShareFileOutputSink::TextShareFileOutputSink(std::string path, std::string config_path)
+    : path_(std::move(path)), config_path_(std::move(config_path)) {}
+
+void TextShareFileOutputSink::write(const TensorDimensions& dims,
+                                    std::span<const std::uint64_t> public_share,
+                                    std::span<const std::uint64_t> secret_share) {
+  check_share_sizes(dims, public_share, secret_share);
+  std::ofstream file(path_);
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not write the output shares to {}", path_));
+  }
+  file << dims.get_data_size() / dims.width_ << " " << dims.width_ << "\n";
+  for (std::size_t i = 0; i < public_share.size(); ++i) {
+    file << public_share[i] << " " << secret_share[i] << "\n";
+  }
+  file.close();
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not write the output shares to {}", path_));
+  }
+  if (!config_path_.empty()) {
+    std::ofstream config(config_path_);
+    config << path_;
+    if (!config) {
+      throw std::runtime_error(fmt::format("could not write {}", config_path_));
+    }
+  }
+}
+
+struct SocketOutputSink::Connection {
+  Connection(const std::string& host, std::uint16_t port, std::size_t max_connect_attempts)
+      : host_(host), port_(port), socket_(io_context_) {
+    for (std::size_t attempt = 1;; ++attempt) {
+      try {
+        boost::asio::ip::tcp::resolver resolver(io_context_);
+        boost::asio::connect(socket_, resolver.resolve(host_, std::to_string(port_)));
+        break;
+      } catch (const boost::system::system_error& e) {
+        socket_.close();
+        if (attempt >= max_connect_attempts) {
+          throw std::runtime_error(fmt::format("could not connect to the output receiver {}:{}: {}",
+                                               host_, port_, e.what()));
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+    writer_ = std::thread([this] { run_writer(); });
+  }
+
+  ~Connection() {
+    {
+      std::scoped_lock lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    writer_.join();
+  }
+
+  void enqueue(std::vector<std::uint8_t>&& message) {
+    {
+      std::scoped_lock lock(mutex_);
+      queue_.push_back(std::move(message));
+    }
+    cv_.notify_all();
+  }
+
+  void flush() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return (queue_.empty() && !sending_) || error_; });
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+  // sends the queued messages in order until the connection is closed, pending messages are sent
+  // before that
+  void run_writer() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return !queue_.empty() || stop_; });
+      if (queue_.empty()) {
+        return;
+      }
+      auto message = std::move(queue_.front());
+      queue_.pop_front();
+      sending_ = true;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        boost::asio::write(socket_, boost::asio::buffer(message));
+      } catch (const boost::system::system_error& e) {
+        error = std::make_exception_ptr(std::runtime_error(fmt::format(
+            "could not send the output shares to {}:{}: {}", host_, port_, e.what())));
+      }
+      lock.lock();
+      sending_ = false;
+      if (error) {
+        error_ = error;
+        queue_.clear();
+      }
+      cv_.notify_all();
+    }
+  }
+
+  const std::string host_;
+  const std::uint16_t port_;
+  boost::asio::io_context io_context_;
+  boost::asio::ip::tcp::socket socket_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::vector<std::uint8_t>> queue_;
+  bool sending_ = false;
+  bool stop_ = false;
+  std::exception_ptr error_;
+  std::thread writer_;
+};
+
+SocketOutputSink::SocketOutputSink(std::string host, std::uint16_t port,
+                                   std::size_t fractional_bits, std::size_t max_connect_attempts)
+    : connection_(std::make_unique<Connection>(host, port, max_connect_attempts)),
+      fractional_bits_(fractional_bits) {}
+
+SocketOutputSink::~SocketOutputSink() = default;
+
+void SocketOutputSink::write(const TensorDimensions& dims,
+                             std::span<const std::uint64_t> public_share,
+                             std::span<const std::uint64_t> secret_share) {
+  check_share_sizes(dims, public_share, secret_share);
+  const auto header =
+      make_share_file_header(dims.get_data_size() / dims.width_, dims.width_, fractional_bits_);
+  std::vector<std::uint8_t> message(sizeof(header) + public_share.size_bytes() +
+                                    secret_share.size_bytes());
+  auto* it = message.data();
+  std::memcpy(it, &header, sizeof(header));
+  it += sizeof(header);
+  std::memcpy(it, public_share.data(), public_share.size_bytes());
+  it += public_share.size_bytes();
+  std::memcpy(it, secret_share.data(), secret_share.size_bytes());
+  connection_->enqueue(std::move(message));
+}
+
+void SocketOutputSink::flush() { connection_->flush(); }
+
+}  // namespace MOTION::tensor
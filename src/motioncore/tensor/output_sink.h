@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "tensor.h"
+
+namespace MOTION::tensor {
+
+// Receives this party's shares (Delta, delta) of an arithmetic output tensor. A sink is passed to
+// the output operation when the circuit is built and is called once in the online phase.
+class OutputSink {
+ public:
+  virtual ~OutputSink() = default;
+  virtual void write(const TensorDimensions&, std::span<const std::uint64_t> public_share,
+                     std::span<const std::uint64_t> secret_share) = 0;
+  // waits until all shares written so far are delivered (e.g. after the circuit has run), rethrows
+  // errors of the delivery
+  virtual void flush() {}
+};
+
+using OutputSinkP = std::shared_ptr<OutputSink>;
+
+// Keeps a copy of the shares, which can be read after the online phase.
+class MemoryOutputSink : public OutputSink {
+ public:
+  void write(const TensorDimensions&, std::span<const std::uint64_t> public_share,
+             std::span<const std::uint64_t> secret_share) override;
+  const TensorDimensions& get_dimensions() const noexcept { return dimensions_; }
+  const std::vector<std::uint64_t>& get_public_share() const noexcept { return public_share_; }
+  const std::vector<std::uint64_t>& get_secret_share() const noexcept { return secret_share_; }
+
+ private:
+  TensorDimensions dimensions_ = {};
+  std::vector<std::uint64_t> public_share_;
+  std::vector<std::uint64_t> secret_share_;
+};
+
+// Writes the shares to a binary share file (see utility/share_file.h), the tensor is stored as a
+// matrix with width_ columns.
+class ShareFileOutputSink : public OutputSink {
+ public:
+  ShareFileOutputSink(std::string path, std::size_t fractional_bits);
+  void write(const TensorDimensions&, std::span<const std::uint64_t> public_share,
+             std::span<const std::uint64_t> secret_share) override;
+
+ private:
+  const std::string path_;
+  const std::size_t fractional_bits_;
+};
+
+// Writes the shares to a text share file: a line "rows cols" followed by one line "Delta delta" per
+// element, the tensor is stored as a matrix with width_ columns. If config_path is not empty, the
+// path of the share file is written to it, which is where the next step of a pipeline of programs
+// reads its input.
+class TextShareFileOutputSink : public OutputSink {
+ public:
+  TextShareFileOutputSink(std::string path, std::string config_path = {});
+  void write(const TensorDimensions&, std::span<const std::uint64_t> public_share,
+             std::span<const std::uint64_t> secret_share) override;
+
+ private:
+  const std::string path_;
+  const std::string config_path_;
+};
+
+// Connects to host:port on construction, making up to max_connect_attempts attempts 500 ms apart
+// (e.g. while the receiver starts up), and keeps the connection for all writes. Every write sends
+// the shares in the layout of a binary share file, i.e., the receiver can parse each message like a
+// share file. The shares are copied and sent by a background thread, so that write does not block
+// on the network; flush waits until they are sent.
+class SocketOutputSink : public OutputSink {
+ public:
+  SocketOutputSink(std::string host, std::uint16_t port, std::size_t fractional_bits,
+                   std::size_t max_connect_attempts = 1);
+  ~SocketOutputSink();
+  void write(const TensorDimensions&, std::span<const std::uint64_t> public_share,
+             std::span<const std::uint64_t> secret_share) override;
+  void flush() override;
+
+ private:
+  struct Connection;
+  std::unique_ptr<Connection> connection_;
+  const std::size_t fractional_bits_;
+};
+
+}  // namespace MOTION::tensor
@@ -22,6 +22,7 @@
 
 #include "tensor_op.h"
 
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <cassert>
 
@@ -141,6 +142,8 @@ bool GemmOp::verify() const noexcept {
   result = result && (k == input_B_shape_[transB_ ? 1 : 0]);
   result = result && (m == output_shape_[0]);
   result = result && (n == output_shape_[1]);
+  // row tiles are taken as contiguous row blocks of A
+  result = result && (tile_rows_ == 0 || !transA_);
   // maybe add more checks here
   return result;
 }
@@ -189,6 +192,24 @@ TensorDimensions GemmOp::get_output_tensor_dims() const noexcept {
           .width_ = output_shape_[1]};
 }
 
+std::vector<GemmOp> GemmOp::compute_row_tiles() const {
+  assert(verify());
+  const auto num_rows = output_shape_[0];
+  if (tile_rows_ == 0 || tile_rows_ >= num_rows) {
+    return {*this};
+  }
+  std::vector<GemmOp> tiles;
+  tiles.reserve((num_rows + tile_rows_ - 1) / tile_rows_);
+  for (std::size_t row = 0; row < num_rows; row += tile_rows_) {
+    GemmOp tile = *this;
+    tile.input_A_shape_[0] = std::min(tile_rows_, num_rows - row);
+    tile.output_shape_[0] = tile.input_A_shape_[0];
+    tile.tile_rows_ = 0;
+    tiles.push_back(tile);
+  }
+  return tiles;
+}
+
 bool GemmOp::operator==(const GemmOp& other) const noexcept {
   assert(verify());
   assert(other.verify());
@@ -196,6 +217,9 @@ bool GemmOp::operator==(const GemmOp& other) const noexcept {
   result = result && input_A_shape_ == other.input_A_shape_;
   result = result && input_B_shape_ == other.input_B_shape_;
   result = result && output_shape_ == other.output_shape_;
+  result = result && tile_rows_ == other.tile_rows_;
+  result = result && transA_ == other.transA_;
+  result = result && transB_ == other.transB_;
   return result;
 }
 
@@ -291,6 +315,13 @@ TensorDimensions flatten(const TensorDimensions& dims, std::size_t axis) {
   return {.batch_size_ = 1, .num_channels_ = 1, .height_ = height, .width_ = width};
 }
 
+TensorDimensions argmax_output_dims(const TensorDimensions& dims, bool one_hot) {
+  if (one_hot) {
+    return dims;
+  }
+  return {.batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = dims.width_};
+}
+
 bool MaxPoolOp::verify() const noexcept {
   bool result = true;
   result = result && (output_shape_ == compute_output_shape());
@@ -425,6 +456,9 @@ std::size_t std::hash<MOTION::tensor::GemmOp>::operator()(
       seed, boost::hash_range(std::begin(op.input_A_shape_), std::end(op.input_A_shape_)));
   boost::hash_combine(
       seed, boost::hash_range(std::begin(op.input_B_shape_), std::end(op.input_B_shape_)));
+  boost::hash_combine(seed, op.tile_rows_);
+  boost::hash_combine(seed, op.transA_);
+  boost::hash_combine(seed, op.transB_);
   return seed;
 }
 
@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include "tensor.h"
 
@@ -70,6 +71,11 @@ struct GemmOp {
   bool transA_ = false;
   bool transB_ = false;
 
+  // number of output rows processed at once (0 = all rows in one pass), this bounds the buffers of
+  // the triple computation in the setup phase, the OT extension for the triples of all tiles still
+  // runs before the first tile is processed
+  std::size_t tile_rows_ = 0;
+
   bool verify() const noexcept;
   std::array<std::size_t, 2> compute_output_shape() const noexcept;
   std::size_t compute_output_size() const noexcept;
@@ -78,6 +84,8 @@ struct GemmOp {
   TensorDimensions get_input_A_tensor_dims() const noexcept;
   TensorDimensions get_input_B_tensor_dims() const noexcept;
   TensorDimensions get_output_tensor_dims() const noexcept;
+  // split into GemmOps covering consecutive blocks of at most tile_rows_ output rows
+  std::vector<GemmOp> compute_row_tiles() const;
 
   bool operator==(const GemmOp&) const noexcept;
 };
@@ -106,6 +114,10 @@ struct JoinOp {
 
 TensorDimensions flatten(const TensorDimensions& dims, std::size_t axis);
 
+// dimensions of the result of an argmax over each column (width_) of the tensor: the input
+// dimensions for a one-hot encoding, one element per column for the index
+TensorDimensions argmax_output_dims(const TensorDimensions& dims, bool one_hot);
+
 struct MaxPoolOp {
   std::array<std::size_t, 3> input_shape_;
   std::array<std::size_t, 3> output_shape_;
@@ -65,19 +65,38 @@ TensorOpFactory::make_arithmetic_64_tensor_input_shares(const TensorDimensions&)
       fmt::format("{} does not support arithmetic 64 bit inputs"));
 }
 
+// share outputs
+std::vector<ENCRYPTO::ReusableFiberFuture<IntegerValues<uint32_t>>>
+TensorOpFactory::make_arithmetic_32_tensor_output_shares(const TensorCP&) {
+  throw std::logic_error(
+      fmt::format("{} does not support arithmetic 32 bit share outputs", get_provider_name()));
+}
+
+std::vector<ENCRYPTO::ReusableFiberFuture<IntegerValues<uint64_t>>>
+TensorOpFactory::make_arithmetic_64_tensor_output_shares(const TensorCP&) {
+  throw std::logic_error(
+      fmt::format("{} does not support arithmetic 64 bit share outputs", get_provider_name()));
+}
+
+std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+TensorOpFactory::make_boolean_tensor_output_shares(const TensorCP&) {
+  throw std::logic_error(
+      fmt::format("{} does not support Boolean share outputs", get_provider_name()));
+}
+
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-TensorOpFactory::make_arithmetic_32_tensor_output_my(const TensorCP&) {
+TensorOpFactory::make_arithmetic_32_tensor_output_my(const TensorCP&, OutputSinkP) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic 32 bit outputs", get_provider_name()));
 }
 
 ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-TensorOpFactory::make_arithmetic_64_tensor_output_my(const TensorCP&) {
+TensorOpFactory::make_arithmetic_64_tensor_output_my(const TensorCP&, OutputSinkP) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic 64 bit outputs", get_provider_name()));
 }
 
-void TensorOpFactory::make_arithmetic_tensor_output_other(const TensorCP&) {
+void TensorOpFactory::make_arithmetic_tensor_output_other(const TensorCP&, OutputSinkP) {
   throw std::logic_error(
       fmt::format("{} does not support arithmetic outputs", get_provider_name()));
 }
@@ -113,6 +132,18 @@ tensor::TensorCP TensorOpFactory::make_tensor_gemm_op(const tensor::GemmOp&, con
       fmt::format("{} does not support the Gemm operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_gemm_op(const tensor::GemmOp& gemm_op,
+                                                      const tensor::TensorCP input_A,
+                                                      const tensor::TensorCP input_B,
+                                                      const tensor::TensorCP bias,
+                                                      std::size_t truncate_bits) {
+  auto output = make_tensor_gemm_op(gemm_op, input_A, input_B, truncate_bits);
+  if (bias == nullptr) {
+    return output;
+  }
+  return make_tensor_add_op(output, bias);
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_sqr_op(const tensor::TensorCP, std::size_t) {
   throw std::logic_error(fmt::format("{} does not support the Sqr operation", get_provider_name()));
 }
@@ -134,6 +165,11 @@ tensor::TensorCP TensorOpFactory::make_tensor_maxpool_op(const tensor::MaxPoolOp
       fmt::format("{} does not support the MaxPool operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_argmax_op(const tensor::TensorCP, bool) {
+  throw std::logic_error(
+      fmt::format("{} does not support the Argmax operation", get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_avgpool_op(const tensor::AveragePoolOp&,
                                                          const tensor::TensorCP, std::size_t) {
   throw std::logic_error(
@@ -150,6 +186,13 @@ tensor::TensorCP TensorOpFactory::make_tensor_constMul_op(const tensor::TensorCP
       fmt::format("{} does not support the Const Multiplication operation", get_provider_name()));
 }
 
+tensor::TensorCP TensorOpFactory::make_tensor_constMatMul_op(const tensor::GemmOp&,
+                                                             const std::vector<std::uint64_t>&,
+                                                             const tensor::TensorCP, std::size_t) {
+  throw std::logic_error(fmt::format(
+      "{} does not support the multiplication with a public matrix", get_provider_name()));
+}
+
 tensor::TensorCP TensorOpFactory::make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP) {
   throw std::logic_error(
       fmt::format("{} does not support the Tensor addition operation", get_provider_name()));
@@ -26,7 +26,9 @@
 #include <memory>
 #include <vector>
 
+#include "output_sink.h"
 #include "tensor_op.h"
+#include "utility/bit_vector.h"
 #include "utility/reusable_future.h"
 
 namespace MOTION::tensor {
@@ -61,12 +63,22 @@ class TensorOpFactory {
   virtual std::pair<std::vector<ENCRYPTO::ReusableFiberPromise<IntegerValues<uint64_t>>>, TensorCP >
   make_arithmetic_64_tensor_input_shares(const TensorDimensions&);
 
-  // arithmetic outputs
+  // share outputs (public share, secret share), e.g. to hand a tensor over to another circuit
+  virtual std::vector<ENCRYPTO::ReusableFiberFuture<IntegerValues<uint32_t>>>
+  make_arithmetic_32_tensor_output_shares(const TensorCP&);
+  virtual std::vector<ENCRYPTO::ReusableFiberFuture<IntegerValues<uint64_t>>>
+  make_arithmetic_64_tensor_output_shares(const TensorCP&);
+  // Boolean share outputs (public shares, secret shares), one BitVector per bit of the elements
+  virtual std::vector<ENCRYPTO::ReusableFiberFuture<std::vector<ENCRYPTO::BitVector<>>>>
+  make_boolean_tensor_output_shares(const TensorCP&);
+
+  // arithmetic outputs, the optional sink receives this party's shares in the online phase
   virtual ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint32_t>>
-  make_arithmetic_32_tensor_output_my(const TensorCP&);
+  make_arithmetic_32_tensor_output_my(const TensorCP&, OutputSinkP output_sink = nullptr);
   virtual ENCRYPTO::ReusableFiberFuture<IntegerValues<std::uint64_t>>
-  make_arithmetic_64_tensor_output_my(const TensorCP&);
-  virtual void make_arithmetic_tensor_output_other(const TensorCP&);
+  make_arithmetic_64_tensor_output_my(const TensorCP&, OutputSinkP output_sink = nullptr);
+  virtual void make_arithmetic_tensor_output_other(const TensorCP&,
+                                                   OutputSinkP output_sink = nullptr);
 
   // conversions
   virtual tensor::TensorCP make_tensor_conversion(MPCProtocol, const tensor::TensorCP input);
@@ -86,8 +98,17 @@ class TensorOpFactory {
                                                const tensor::TensorCP input_A,
                                                const tensor::TensorCP input_B,
                                                std::size_t truncate_bits = 0);
+  // dense layer: input_A * input_B + bias with bias of the output dimensions, the default
+  // implementation combines the Gemm and the addition operation
+  virtual tensor::TensorCP make_tensor_gemm_op(const tensor::GemmOp& gemm_op,
+                                               const tensor::TensorCP input_A,
+                                               const tensor::TensorCP input_B,
+                                               const tensor::TensorCP bias,
+                                               std::size_t truncate_bits = 0);
   virtual tensor::TensorCP make_tensor_sqr_op(const tensor::TensorCP input,
                                               std::size_t truncate_bits = 0);
+  // max(x, 0) in the protocol of the input, which may be arithmetic if the provider can extract the
+  // sign itself (e.g. BEAVY)
   virtual tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP input);
   virtual tensor::TensorCP make_tensor_relu_op(const tensor::TensorCP input_bool,
                                                const tensor::TensorCP input_arith);
@@ -96,8 +117,18 @@ class TensorOpFactory {
   virtual tensor::TensorCP make_tensor_avgpool_op(const tensor::AveragePoolOp& avgpool_op,
                                                   const tensor::TensorCP input,
                                                   std::size_t truncate_bits);
+  // argmax over each column of the input, i.e., the tensor is read as a matrix with width_ columns
+  // (e.g. one per image of a batch) that are evaluated independently: a one-hot tensor of the
+  // input's dimensions or the indices as a tensor of dimensions {1, 1, 1, width_}
+  virtual tensor::TensorCP make_tensor_argmax_op(const tensor::TensorCP input,
+                                                 bool one_hot = true);
   virtual tensor::TensorCP make_tensor_negate(const tensor::TensorCP);   
   virtual tensor::TensorCP make_tensor_constMul_op(const tensor::TensorCP,const uint64_t k);
+  // public_matrix * input for a plaintext matrix known to all parties (e.g. the weights of a public
+  // model) with the shapes of the GemmOp, i.e., public_matrix is input A and encoded in the ring
+  virtual tensor::TensorCP make_tensor_constMatMul_op(
+      const tensor::GemmOp& gemm_op, const std::vector<std::uint64_t>& public_matrix,
+      const tensor::TensorCP input, std::size_t truncate_bits = 0);
   virtual tensor::TensorCP make_tensor_add_op(const tensor::TensorCP,const tensor::TensorCP);
   virtual std::vector<tensor::TensorCP> make_tensor_split_op(const tensor::TensorCP);
   virtual tensor::TensorCP make_tensor_gt_op(const tensor::MaxPoolOp& maxpool_op,
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "csv_matrix.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "fixed_point.h"
+
+namespace MOTION {
+
+std::vector<std::uint64_t> read_fixed_point_csv(const std::string& path, std::size_t rows,
+                                                std::size_t cols, std::size_t fractional_bits) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not open CSV file {}", path));
+  }
+  const auto num_elements = rows * cols;
+  std::vector<std::uint64_t> matrix;
+  matrix.reserve(num_elements);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::size_t pos = 0;
+    while (pos < line.size()) {
+      const auto begin = line.find_first_not_of(", \t\r", pos);
+      if (begin == std::string::npos) {
+        break;
+      }
+      const auto end = std::min(line.find_first_of(", \t\r", begin), line.size());
+      const auto cell = line.substr(begin, end - begin);
+      double value;
+      std::size_t num_parsed;
+      try {
+        value = std::stod(cell, &num_parsed);
+      } catch (const std::logic_error&) {
+        num_parsed = 0;
+      }
+      if (num_parsed != cell.size()) {
+        throw std::invalid_argument(
+            fmt::format("{} contains \"{}\", which is not a number", path, cell));
+      }
+      if (matrix.size() == num_elements) {
+        throw std::invalid_argument(
+            fmt::format("{} contains more than {} x {} values", path, rows, cols));
+      }
+      matrix.push_back(fixed_point::encode<std::uint64_t>(value, fractional_bits));
+      pos = end;
+    }
+  }
+  if (matrix.size() != num_elements) {
+    throw std::invalid_argument(fmt::format("{} contains {} values, expected {} x {}", path,
+                                            matrix.size(), rows, cols));
+  }
+  return matrix;
+}
+
+}  // namespace MOTION
@@ -97,16 +97,22 @@ void decode(F* dst, const I* src, std::size_t fractional_bits, std::size_t n) {
                  [fractional_bits](auto x) { return decode(x, fractional_bits); });
 }
 
-// Truncation protocol by Mohassel and Zhang (https://eprint.iacr.org/2017/396).
+// Truncation protocol by Mohassel and Zhang (https://eprint.iacr.org/2017/396) for a single share,
+// e.g., to truncate in the epilogue of another computation.
 template <typename T>
-void truncate_shared(T* buffer, std::size_t fractional_bits, std::size_t n, bool party_0) {
+T truncate_share(T x, std::size_t fractional_bits, bool party_0) {
   if (party_0) {
-    std::transform(buffer, buffer + n, buffer,
-                   [fractional_bits](auto x) { return x >> fractional_bits; });
-  } else {
-    std::transform(buffer, buffer + n, buffer,
-                   [fractional_bits](auto x) { return -((-x) >> fractional_bits); });
+    return x >> fractional_bits;
   }
+  return -((-x) >> fractional_bits);
+}
+
+// Truncation protocol by Mohassel and Zhang (https://eprint.iacr.org/2017/396).
+template <typename T>
+void truncate_shared(T* buffer, std::size_t fractional_bits, std::size_t n, bool party_0) {
+  std::transform(buffer, buffer + n, buffer, [fractional_bits, party_0](auto x) {
+    return truncate_share(x, fractional_bits, party_0);
+  });
 }
 
 }  // namespace MOTION::fixed_point
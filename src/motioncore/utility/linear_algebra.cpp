@@ -22,7 +22,10 @@
 
 #include "linear_algebra.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
 
 #include <Eigen/Core>
 #include <unsupported/Eigen/CXX11/Tensor>
@@ -31,14 +34,250 @@
 
 namespace MOTION {
 
+// Integer GEMM modulo 2^k. Eigen's operator* is not vectorized for 64 bit integer products on x86,
+// so the ring GEMMs use the following blocked kernel instead: B is packed into panels of
+// gemm_nr<T> columns that fit into the L1 cache, A into panels of gemm_mr rows that fit into the L2
+// cache, and a register-blocked micro kernel multiplies them. The micro kernel is written for
+// auto-vectorization (vpmullq with AVX-512DQ, vpmuludq sequences with AVX2, see MOTION_USE_AVX) and
+// the row blocks of A are distributed over the OpenMP threads.
+namespace {
+
+enum class GemmUpdate { set, add, subtract };
+
+// strided view of a matrix, which makes transposed operands free
+template <typename T>
+struct MatrixView {
+  const T* data_;
+  std::size_t row_stride_;
+  std::size_t col_stride_;
+  T operator()(std::size_t row, std::size_t col) const noexcept {
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+};
+
+// data is a row-major matrix with num_cols columns, viewed as its transpose if requested
+template <typename T>
+MatrixView<T> make_view(const T* data, std::size_t num_cols, bool transposed) {
+  if (transposed) {
+    return {data, 1, num_cols};
+  }
+  return {data, num_cols, 1};
+}
+
+constexpr std::size_t gemm_mr = 4;
+// two 512 bit vectors of results per row of the micro kernel
+template <typename T>
+constexpr std::size_t gemm_nr = std::max<std::size_t>(128 / sizeof(T), 4);
+template <typename T>
+constexpr std::size_t gemm_kc = 256;
+constexpr std::size_t gemm_mc = 64;
+constexpr std::size_t gemm_nc = 2048;
+// below this number of multiplications the threads cost more than they save
+constexpr std::size_t gemm_parallel_threshold = std::size_t(1) << 18;
+constexpr std::size_t gemv_parallel_threshold = std::size_t(1) << 16;
+
+// products of integers smaller than int would be computed in (signed) int
+template <typename T>
+using GemmProductType = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, T>;
+
+// packs rows [row_begin, row_begin + num_rows) x cols [col_begin, col_begin + num_cols) of A into
+// panels of gemm_mr rows, each stored column by column and padded with zeros
+template <typename T>
+void pack_A(const MatrixView<T>& A, std::size_t row_begin, std::size_t num_rows,
+            std::size_t col_begin, std::size_t num_cols, T* packed) {
+  for (std::size_t panel_row = 0; panel_row < num_rows; panel_row += gemm_mr) {
+    const auto panel_rows = std::min(gemm_mr, num_rows - panel_row);
+    for (std::size_t col = 0; col < num_cols; ++col) {
+      for (std::size_t r = 0; r < gemm_mr; ++r) {
+        *packed++ = r < panel_rows ? A(row_begin + panel_row + r, col_begin + col) : T(0);
+      }
+    }
+  }
+}
+
+// packs the panel of B with gemm_nr<T> columns starting at col_begin, stored row by row and padded
+// with zeros
+template <typename T>
+void pack_B_panel(const MatrixView<T>& B, std::size_t row_begin, std::size_t num_rows,
+                  std::size_t col_begin, std::size_t num_cols, T* packed) {
+  constexpr auto nr = gemm_nr<T>;
+  const auto panel_cols = std::min(nr, num_cols);
+  for (std::size_t row = 0; row < num_rows; ++row) {
+    for (std::size_t c = 0; c < nr; ++c) {
+      *packed++ = c < panel_cols ? B(row_begin + row, col_begin + c) : T(0);
+    }
+  }
+}
+
+// C[0:num_rows, 0:num_cols] (update)= A_panel * B_panel over kc columns / rows
+template <typename T>
+void gemm_micro_kernel(std::size_t kc, const T* __restrict__ A_panel, const T* __restrict__ B_panel,
+                       T* C, std::size_t ldc, std::size_t num_rows, std::size_t num_cols,
+                       GemmUpdate update) {
+  constexpr auto nr = gemm_nr<T>;
+  using P = GemmProductType<T>;
+  T acc[gemm_mr][nr] = {};
+  for (std::size_t p = 0; p < kc; ++p) {
+    const T* a = A_panel + p * gemm_mr;
+    const T* b = B_panel + p * nr;
+    for (std::size_t r = 0; r < gemm_mr; ++r) {
+      const P a_r = a[r];
+#pragma omp simd
+      for (std::size_t c = 0; c < nr; ++c) {
+        acc[r][c] += static_cast<T>(a_r * P(b[c]));
+      }
+    }
+  }
+  for (std::size_t r = 0; r < num_rows; ++r) {
+    T* C_row = C + r * ldc;
+    switch (update) {
+      case GemmUpdate::set:
+        std::copy_n(acc[r], num_cols, C_row);
+        break;
+      case GemmUpdate::add:
+        for (std::size_t c = 0; c < num_cols; ++c) {
+          C_row[c] += acc[r][c];
+        }
+        break;
+      case GemmUpdate::subtract:
+        for (std::size_t c = 0; c < num_cols; ++c) {
+          C_row[c] -= acc[r][c];
+        }
+        break;
+    }
+  }
+}
+
+// sum of a[p] * x[p], the SIMD lanes keep independent partial sums
+template <typename T>
+T dot_product(const T* __restrict__ a, const T* __restrict__ x, std::size_t size) {
+  using P = GemmProductType<T>;
+  P sum = 0;
+#pragma omp simd reduction(+ : sum)
+  for (std::size_t p = 0; p < size; ++p) {
+    sum += P(a[p]) * P(x[p]);
+  }
+  return static_cast<T>(sum);
+}
+
+// y (update)= A * x for a (dim_l x dim_m) matrix A with contiguous rows. A matrix times a single
+// column does not reuse B, so packing does not pay off and every row is one dot product.
+template <typename T>
+void ring_gemv(std::size_t dim_l, std::size_t dim_m, const MatrixView<T>& A, const T* x, T* y,
+               GemmUpdate update) {
+  assert(A.col_stride_ == 1);
+  const bool parallel = dim_l * dim_m >= gemv_parallel_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+  for (std::size_t i = 0; i < dim_l; ++i) {
+    const auto product = dot_product(A.data_ + i * A.row_stride_, x, dim_m);
+    switch (update) {
+      case GemmUpdate::set:
+        y[i] = product;
+        break;
+      case GemmUpdate::add:
+        y[i] += product;
+        break;
+      case GemmUpdate::subtract:
+        y[i] -= product;
+        break;
+    }
+  }
+}
+
+// y += A_1 * x_1 - A_2 * x_2 in a single pass over y
+template <typename T>
+void ring_gemv_accumulate(std::size_t dim_l, std::size_t dim_m, const MatrixView<T>& A_1,
+                          const T* x_1, const MatrixView<T>& A_2, const T* x_2, T* y) {
+  assert(A_1.col_stride_ == 1 && A_2.col_stride_ == 1);
+  const bool parallel = 2 * dim_l * dim_m >= gemv_parallel_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+  for (std::size_t i = 0; i < dim_l; ++i) {
+    y[i] += dot_product(A_1.data_ + i * A_1.row_stride_, x_1, dim_m) -
+            dot_product(A_2.data_ + i * A_2.row_stride_, x_2, dim_m);
+  }
+}
+
+// C (update)= A * B for the row-major (dim_l x dim_n) matrix C
+template <typename T>
+void ring_gemm(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n, const MatrixView<T>& A,
+               const MatrixView<T>& B, T* C, GemmUpdate update) {
+  constexpr auto nr = gemm_nr<T>;
+  constexpr auto kc_max = gemm_kc<T>;
+  if (dim_l == 0 || dim_n == 0) {
+    return;
+  }
+  if (dim_m == 0) {
+    if (update == GemmUpdate::set) {
+      std::fill_n(C, dim_l * dim_n, T(0));
+    }
+    return;
+  }
+  // a single output column of B is contiguous whether B is transposed or not
+  if (dim_n == 1 && A.col_stride_ == 1) {
+    ring_gemv(dim_l, dim_m, A, B.data_, C, update);
+    return;
+  }
+  const bool parallel = dim_l * dim_m * dim_n >= gemm_parallel_threshold;
+  const auto nc_max = std::min(gemm_nc, (dim_n + nr - 1) / nr * nr);
+  std::vector<T> B_packed(kc_max * nc_max);
+
+#pragma omp parallel if (parallel)
+  {
+    std::vector<T> A_packed((gemm_mc + gemm_mr - 1) / gemm_mr * gemm_mr * kc_max);
+    for (std::size_t jc = 0; jc < dim_n; jc += gemm_nc) {
+      const auto nc = std::min(gemm_nc, dim_n - jc);
+      const auto num_B_panels = (nc + nr - 1) / nr;
+      for (std::size_t pc = 0; pc < dim_m; pc += kc_max) {
+        const auto kc = std::min(kc_max, dim_m - pc);
+        // the first block of the inner dimension initializes C if requested
+        const auto block_update =
+            (pc == 0 || update != GemmUpdate::set) ? update : GemmUpdate::add;
+
+#pragma omp for schedule(static)
+        for (std::size_t panel = 0; panel < num_B_panels; ++panel) {
+          pack_B_panel(B, pc, kc, jc + panel * nr, nc - panel * nr,
+                       B_packed.data() + panel * kc * nr);
+        }
+        // implicit barrier: B is packed
+
+#pragma omp for schedule(static)
+        for (std::size_t ic = 0; ic < dim_l; ic += gemm_mc) {
+          const auto mc = std::min(gemm_mc, dim_l - ic);
+          pack_A(A, ic, mc, pc, kc, A_packed.data());
+          for (std::size_t jr = 0; jr < nc; jr += nr) {
+            for (std::size_t ir = 0; ir < mc; ir += gemm_mr) {
+              gemm_micro_kernel(kc, A_packed.data() + ir * kc, B_packed.data() + jr * kc,
+                                C + (ic + ir) * dim_n + jc + jr, dim_n,
+                                std::min(gemm_mr, mc - ir), std::min(nr, nc - jr), block_update);
+            }
+          }
+        }
+        // implicit barrier: B_packed can be overwritten
+      }
+    }
+  }
+}
+
+template <typename T>
+void ring_gemm(const tensor::GemmOp& gemm_op, const T* A, const T* B, T* output,
+               GemmUpdate update) {
+  assert(gemm_op.verify());
+  const auto dim_l = gemm_op.output_shape_[0];
+  const auto dim_n = gemm_op.output_shape_[1];
+  const auto dim_m = gemm_op.input_A_shape_[gemm_op.transA_ ? 0 : 1];
+  ring_gemm(dim_l, dim_m, dim_n,
+            make_view(A, gemm_op.input_A_shape_[1], gemm_op.transA_),
+            make_view(B, gemm_op.input_B_shape_[1], gemm_op.transB_),
+            output, update);
+}
+
+}  // namespace
+
 template <typename T>
 void matrix_multiply(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n, const T* A,
                      const T* B, T* output) {
-  using MatrixType = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
-  Eigen::Map<MatrixType> matrix_output(output, dim_l, dim_n);
-  Eigen::Map<const MatrixType> matrix_A(A, dim_l, dim_m);
-  Eigen::Map<const MatrixType> matrix_B(B, dim_m, dim_n);
-  matrix_output = matrix_A * matrix_B;
+  ring_gemm(dim_l, dim_m, dim_n, make_view(A, dim_m, false), make_view(B, dim_n, false), output,
+            GemmUpdate::set);
 }
 
 template <typename T>
@@ -53,21 +292,21 @@ std::vector<T> matrix_multiply(std::size_t dim_l, std::size_t dim_m, std::size_t
 
 template <typename T>
 void matrix_multiply(const tensor::GemmOp& gemm_op, const T* A, const T* B, T* output) {
-  using MatrixType = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  ring_gemm(gemm_op, A, B, output, GemmUpdate::set);
+}
+
+template <typename T>
+void matrix_multiply_accumulate(const tensor::GemmOp& gemm_op, const T* A_1, const T* B_1,
+                                const T* A_2, const T* B_2, T* output) {
   assert(gemm_op.verify());
-  Eigen::Map<MatrixType> matrix_output(output, gemm_op.output_shape_[0], gemm_op.output_shape_[1]);
-  Eigen::Map<const MatrixType> matrix_A(A, gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1]);
-  Eigen::Map<const MatrixType> matrix_B(B, gemm_op.input_B_shape_[0], gemm_op.input_B_shape_[1]);
-
-  if (gemm_op.transA_ && gemm_op.transB_) {
-    matrix_output = matrix_A.transpose() * matrix_B.transpose();
-  } else if (gemm_op.transA_) {
-    matrix_output = matrix_A.transpose() * matrix_B;
-  } else if (gemm_op.transB_) {
-    matrix_output = matrix_A * matrix_B.transpose();
-  } else {
-    matrix_output = matrix_A * matrix_B;
+  if (gemm_op.output_shape_[1] == 1 && !gemm_op.transA_) {
+    const auto num_cols = gemm_op.input_A_shape_[1];
+    ring_gemv_accumulate(gemm_op.output_shape_[0], num_cols, make_view(A_1, num_cols, false), B_1,
+                         make_view(A_2, num_cols, false), B_2, output);
+    return;
   }
+  ring_gemm(gemm_op, A_1, B_1, output, GemmUpdate::add);
+  ring_gemm(gemm_op, A_2, B_2, output, GemmUpdate::subtract);
 }
 
 template void matrix_multiply(std::size_t, std::size_t, std::size_t, const std::uint8_t*,
@@ -103,6 +342,12 @@ template void matrix_multiply(const tensor::GemmOp&, const std::uint64_t*, const
                               std::uint64_t*);
 template void matrix_multiply(const tensor::GemmOp&, const __uint128_t*, const __uint128_t*,
                               __uint128_t*);
+template void matrix_multiply_accumulate(const tensor::GemmOp&, const std::uint32_t*,
+                                         const std::uint32_t*, const std::uint32_t*,
+                                         const std::uint32_t*, std::uint32_t*);
+template void matrix_multiply_accumulate(const tensor::GemmOp&, const std::uint64_t*,
+                                         const std::uint64_t*, const std::uint64_t*,
+                                         const std::uint64_t*, std::uint64_t*);
 
 template <typename T>
 void join_matrices(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n, const T* A,
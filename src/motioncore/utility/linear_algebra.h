@@ -46,6 +46,12 @@ void matrix_multiply(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n, co
 template <typename T>
 void matrix_multiply(const tensor::GemmOp&, const T* A, const T* B, T* output);
 
+// output += A_1 * B_1 - A_2 * B_2, both products of the shapes given by the GemmOp are accumulated
+// directly into output
+template <typename T>
+void matrix_multiply_accumulate(const tensor::GemmOp&, const T* A_1, const T* B_1, const T* A_2,
+                                const T* B_2, T* output);
+
 template <typename T>
 std::vector<T> join_matrices(std::size_t dim_l, std::size_t dim_m, std::size_t dim_n,
                                const std::vector<T>& A, const std::vector<T>& B);
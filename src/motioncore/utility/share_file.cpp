@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "share_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace MOTION {
+
+static constexpr char share_file_magic[8] = {'M', 'O', 'T', 'S', 'H', 'A', 'R', 'E'};
+
+bool is_binary_share_file(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(share_file_magic)];
+  if (!file.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return std::equal(std::begin(magic), std::end(magic), std::begin(share_file_magic));
+}
+
+ShareFileHeader make_share_file_header(std::size_t rows, std::size_t cols,
+                                       std::size_t fractional_bits) {
+  ShareFileHeader header;
+  std::copy(std::begin(share_file_magic), std::end(share_file_magic), header.magic_);
+  header.version_ = share_file_version;
+  header.rows_ = rows;
+  header.cols_ = cols;
+  header.fractional_bits_ = fractional_bits;
+  return header;
+}
+
+bool is_valid_share_file_header(const ShareFileHeader& header) {
+  return std::memcmp(header.magic_, share_file_magic, sizeof(share_file_magic)) == 0 &&
+         header.version_ == share_file_version;
+}
+
+void write_share_file(const std::string& path, std::size_t rows, std::size_t cols,
+                      std::size_t fractional_bits, const std::uint64_t* Delta,
+                      const std::uint64_t* delta) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error(fmt::format("could not open share file {}", path));
+  }
+  const auto header = make_share_file_header(rows, cols, fractional_bits);
+  const auto num_bytes = static_cast<std::streamsize>(rows * cols * sizeof(std::uint64_t));
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(Delta), num_bytes);
+  file.write(reinterpret_cast<const char*>(delta), num_bytes);
+  if (!file) {
+    throw std::runtime_error(fmt::format("failed to write share file {}", path));
+  }
+}
+
+void write_share_file(const std::string& path, std::size_t rows, std::size_t cols,
+                      std::size_t fractional_bits, const std::vector<std::uint64_t>& Delta,
+                      const std::vector<std::uint64_t>& delta) {
+  if (Delta.size() != rows * cols || delta.size() != rows * cols) {
+    throw std::invalid_argument(
+        fmt::format("expected {} shares for a {}x{} share file, got {} and {}", rows * cols, rows,
+                    cols, Delta.size(), delta.size()));
+  }
+  write_share_file(path, rows, cols, fractional_bits, Delta.data(), delta.data());
+}
+
+MappedShareFile::MappedShareFile(const std::string& path) : data_(nullptr), size_(0) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("could not open share file {}", path));
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 ||
+      static_cast<std::size_t>(file_stat.st_size) < sizeof(ShareFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("{} is too small to be a share file", path));
+  }
+  size_ = file_stat.st_size;
+  data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data_ == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("could not map share file {}", path));
+  }
+
+  header_ = reinterpret_cast<const ShareFileHeader*>(data_);
+  const auto num_elements = header_->rows_ * header_->cols_;
+  if (!is_valid_share_file_header(*header_) ||
+      size_ != sizeof(ShareFileHeader) + 2 * num_elements * sizeof(std::uint64_t)) {
+    ::munmap(data_, size_);
+    throw std::runtime_error(fmt::format("{} is not a valid version {} share file", path,
+                                         share_file_version));
+  }
+  Delta_ = reinterpret_cast<const std::uint64_t*>(header_ + 1);
+  delta_ = Delta_ + num_elements;
+}
+
+MappedShareFile::~MappedShareFile() { ::munmap(data_, size_); }
+
+std::vector<std::uint64_t> MappedShareFile::copy_Delta(std::size_t row_begin,
+                                                       std::size_t row_end) const {
+  if (row_begin > row_end || row_end > get_rows()) {
+    throw std::out_of_range(
+        fmt::format("rows [{}, {}) out of range for {} rows", row_begin, row_end, get_rows()));
+  }
+  return std::vector<std::uint64_t>(get_Delta(row_begin), get_Delta(row_end));
+}
+
+std::vector<std::uint64_t> MappedShareFile::copy_delta(std::size_t row_begin,
+                                                       std::size_t row_end) const {
+  if (row_begin > row_end || row_end > get_rows()) {
+    throw std::out_of_range(
+        fmt::format("rows [{}, {}) out of range for {} rows", row_begin, row_end, get_rows()));
+  }
+  return std::vector<std::uint64_t>(get_delta(row_begin), get_delta(row_end));
+}
+
+}  // namespace MOTION
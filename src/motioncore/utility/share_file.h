@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MOTION {
+
+// Binary container for (Delta, delta) share matrices.
+//
+// Layout (little endian):
+//   char[8]  magic "MOTSHARE"
+//   uint64   version
+//   uint64   rows
+//   uint64   cols
+//   uint64   fractional bits
+//   uint64   Delta[rows * cols]  (row-major)
+//   uint64   delta[rows * cols]  (row-major)
+//
+// All fields are 8 byte aligned, so that a mapped file can be used in place.
+struct ShareFileHeader {
+  char magic_[8];
+  std::uint64_t version_;
+  std::uint64_t rows_;
+  std::uint64_t cols_;
+  std::uint64_t fractional_bits_;
+};
+
+constexpr std::uint64_t share_file_version = 1;
+
+// true if the file at path starts with the magic of a binary share file
+bool is_binary_share_file(const std::string& path);
+
+// header of a binary share file, e.g., to send the shares in the same layout
+ShareFileHeader make_share_file_header(std::size_t rows, std::size_t cols,
+                                       std::size_t fractional_bits);
+
+// true if the header has the magic and version written by make_share_file_header
+bool is_valid_share_file_header(const ShareFileHeader& header);
+
+void write_share_file(const std::string& path, std::size_t rows, std::size_t cols,
+                      std::size_t fractional_bits, const std::uint64_t* Delta,
+                      const std::uint64_t* delta);
+
+void write_share_file(const std::string& path, std::size_t rows, std::size_t cols,
+                      std::size_t fractional_bits, const std::vector<std::uint64_t>& Delta,
+                      const std::vector<std::uint64_t>& delta);
+
+// Read-only memory mapping of a binary share file.
+class MappedShareFile {
+ public:
+  explicit MappedShareFile(const std::string& path);
+  ~MappedShareFile();
+  MappedShareFile(const MappedShareFile&) = delete;
+  MappedShareFile& operator=(const MappedShareFile&) = delete;
+
+  std::size_t get_rows() const noexcept { return header_->rows_; }
+  std::size_t get_cols() const noexcept { return header_->cols_; }
+  std::size_t get_fractional_bits() const noexcept { return header_->fractional_bits_; }
+
+  // pointers to the first element of the given row
+  const std::uint64_t* get_Delta(std::size_t row = 0) const noexcept {
+    return Delta_ + row * header_->cols_;
+  }
+  const std::uint64_t* get_delta(std::size_t row = 0) const noexcept {
+    return delta_ + row * header_->cols_;
+  }
+
+  // copies of the rows [row_begin, row_end)
+  std::vector<std::uint64_t> copy_Delta(std::size_t row_begin, std::size_t row_end) const;
+  std::vector<std::uint64_t> copy_delta(std::size_t row_begin, std::size_t row_end) const;
+
+ private:
+  void* data_;
+  std::size_t size_;
+  const ShareFileHeader* header_;
+  const std::uint64_t* Delta_;
+  const std::uint64_t* delta_;
+};
+
+}  // namespace MOTION
@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <filesystem>
+
 #include "gtest/gtest.h"
 
 #include "test_constants.h"
@@ -115,3 +117,77 @@ TEST(ObliviousTransfer, BaseOT) {
     }
   }
 }
+
+TEST(ObliviousTransfer, BaseOTStateFile) {
+  const std::size_t num_parties = 2;
+  auto motion_parties = GetNLocalParties(num_parties, 0);
+  for (auto &p : motion_parties) {
+    p->GetLogger()->SetEnabled(DETAILED_LOGGING_ENABLED);
+  }
+
+  std::vector<std::future<void>> futs;
+  futs.reserve(num_parties);
+  for (auto i = 0u; i < num_parties; ++i) {
+    futs.emplace_back(std::async(std::launch::async, [&motion_parties, i]() {
+      motion_parties.at(i)->GetBackend()->ComputeBaseOTs();
+      motion_parties.at(i)->Finish();
+    }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto &fut) { fut.get(); });
+
+  auto &base_ot_provider = *motion_parties.at(0)->GetBackend()->GetBaseOTProvider();
+  {
+    auto &base_ots_data = base_ot_provider.get_base_ots_data(1);
+    base_ots_data.GetReceiverData().consumed_offset_ = 42;
+    base_ots_data.GetSenderData().consumed_offset_ = 23;
+  }
+  const auto path =
+      (std::filesystem::temp_directory_path() / "motion_test_base_ot_state.bin").string();
+  // reserve the blocks of an OT extension that has not run yet
+  base_ot_provider.SaveBaseOTs(path, {{0, 0}, {5, 7}});
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+  const auto [expected_rcv, expected_snd] = base_ot_provider.ExportBaseOTs(1);
+
+  auto fresh_parties = GetNLocalParties(num_parties, 0);
+  auto &fresh_base_ot_provider = *fresh_parties.at(0)->GetBackend()->GetBaseOTProvider();
+  fresh_base_ot_provider.LoadBaseOTs(path);
+  std::filesystem::remove(path);
+  EXPECT_THROW(fresh_base_ot_provider.LoadBaseOTs(path), std::runtime_error);
+
+  const auto [rcv, snd] = fresh_base_ot_provider.ExportBaseOTs(1);
+  EXPECT_EQ(rcv.c_, expected_rcv.c_);
+  EXPECT_EQ(rcv.messages_c_, expected_rcv.messages_c_);
+  EXPECT_EQ(rcv.consumed_offset_, 42 + 5);
+  EXPECT_EQ(snd.messages_0_, expected_snd.messages_0_);
+  EXPECT_EQ(snd.messages_1_, expected_snd.messages_1_);
+  EXPECT_EQ(snd.consumed_offset_, 23 + 7);
+
+  futs.clear();
+  for (auto i = 0u; i < num_parties; ++i) {
+    futs.emplace_back(
+        std::async(std::launch::async, [&fresh_parties, i]() { fresh_parties.at(i)->Finish(); }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto &fut) { fut.get(); });
+}
+
+TEST(ObliviousTransfer, BaseOTStateMismatch) {
+  const std::size_t num_parties = 2;
+  auto motion_parties = GetNLocalParties(num_parties, 0);
+  for (auto &p : motion_parties) {
+    p->GetLogger()->SetEnabled(DETAILED_LOGGING_ENABLED);
+  }
+  // e.g., party 0 loaded a state file that is newer than the one of party 1
+  motion_parties.at(0)->GetBackend()->GetBaseOTProvider()->get_base_ots_data(1)
+      .GetReceiverData().consumed_offset_ = 1;
+
+  std::vector<std::future<void>> futs;
+  futs.reserve(num_parties);
+  for (auto i = 0u; i < num_parties; ++i) {
+    futs.emplace_back(std::async(std::launch::async, [&motion_parties, i]() {
+      EXPECT_THROW(motion_parties.at(i)->GetBackend()->GetBaseOTProvider()->VerifyBaseOTState(),
+                   std::runtime_error);
+      motion_parties.at(i)->Finish();
+    }));
+  }
+  std::for_each(std::begin(futs), std::end(futs), [](auto &fut) { fut.get(); });
+}
@@ -20,23 +20,29 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
 #include "algorithm/circuit_loader.h"
 #include "base/gate_register.h"
 #include "communication/communication_layer.h"
+#include "communication/dummy_transport.h"
 #include "crypto/arithmetic_provider.h"
 #include "crypto/base_ots/base_ot_provider.h"
 #include "crypto/motion_base_provider.h"
+#include "crypto/multiplication_triple/linalg_triple_provider.h"
 #include "crypto/oblivious_transfer/ot_provider.h"
 #include "gate/new_gate.h"
 #include "protocols/beavy/beavy_provider.h"
 #include "protocols/beavy/tensor.h"
 #include "statistics/run_time_stats.h"
+#include "tensor/output_sink.h"
 #include "utility/helpers.h"
 #include "utility/linear_algebra.h"
 #include "utility/logger.h"
@@ -148,6 +154,25 @@ class ArithmeticBEAVYTensorTest : public BEAVYTensorTest {
   static std::vector<T> generate_inputs(const MOTION::tensor::TensorDimensions dims) {
     return MOTION::Helpers::RandomVector<T>(dims.get_data_size());
   }
+  // signed values in [-2^(bits - 1), 2^(bits - 1)), products of such values are small enough that
+  // the local truncation of the shares is correct up to an error of 1 with overwhelming probability
+  static std::vector<T> generate_small_inputs(const MOTION::tensor::TensorDimensions dims,
+                                              std::size_t bits) {
+    auto values = generate_inputs(dims);
+    for (auto& v : values) {
+      v = (v % (T(1) << bits)) - (T(1) << (bits - 1));
+    }
+    return values;
+  }
+  // checks that plain_output is expected_output up to an error of 1 in each element
+  static void expect_truncation_error_at_most_one(const std::vector<T>& plain_output,
+                                                  const std::vector<T>& expected_output) {
+    ASSERT_EQ(plain_output.size(), expected_output.size());
+    for (std::size_t i = 0; i < plain_output.size(); ++i) {
+      const auto error = static_cast<std::make_signed_t<T>>(plain_output[i] - expected_output[i]);
+      EXPECT_LE(std::abs(error), 1) << "at index " << i;
+    }
+  }
   std::pair<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<T>>, MOTION::tensor::TensorCP>
   make_arithmetic_T_tensor_input_my(std::size_t party_id,
                                     const MOTION::tensor::TensorDimensions& dims) {
@@ -170,13 +195,24 @@ class ArithmeticBEAVYTensorTest : public BEAVYTensorTest {
     }
   }
   ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>> make_arithmetic_T_tensor_output_my(
-      std::size_t party_id, const MOTION::tensor::TensorCP& in) {
+      std::size_t party_id, const MOTION::tensor::TensorCP& in,
+      MOTION::tensor::OutputSinkP output_sink = nullptr) {
+    auto& bp = *beavy_providers_.at(party_id);
+    if constexpr (ENCRYPTO::bit_size_v<T> == 64) {
+      return bp.make_arithmetic_64_tensor_output_my(in, std::move(output_sink));
+    } else {
+      static_assert(ENCRYPTO::bit_size_v<T> == 32);
+      return bp.make_arithmetic_32_tensor_output_my(in, std::move(output_sink));
+    }
+  }
+  std::vector<ENCRYPTO::ReusableFiberFuture<MOTION::IntegerValues<T>>>
+  make_arithmetic_T_tensor_output_shares(std::size_t party_id, const MOTION::tensor::TensorCP& in) {
     auto& bp = *beavy_providers_.at(party_id);
     if constexpr (ENCRYPTO::bit_size_v<T> == 64) {
-      return bp.make_arithmetic_64_tensor_output_my(in);
+      return bp.make_arithmetic_64_tensor_output_shares(in);
     } else {
       static_assert(ENCRYPTO::bit_size_v<T> == 32);
-      return bp.make_arithmetic_32_tensor_output_my(in);
+      return bp.make_arithmetic_32_tensor_output_shares(in);
     }
   }
 };
@@ -294,6 +330,67 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, OutputSingle) {
   ASSERT_EQ(input_a, output);
 }
 
+TYPED_TEST(ArithmeticBEAVYTensorTest, OutputShares) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
+  const auto input_a = this->generate_inputs(dims);
+
+  auto [input_a_promise, tensor_a_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_a_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto output_futures_0 = this->make_arithmetic_T_tensor_output_shares(0, tensor_a_in_0);
+  auto output_futures_1 = this->make_arithmetic_T_tensor_output_shares(1, tensor_a_in_1);
+  ASSERT_EQ(output_futures_0.size(), 2);
+  ASSERT_EQ(output_futures_1.size(), 2);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_a_promise.set_value(input_a);
+  this->run_gates_online();
+
+  const auto pshare_0 = output_futures_0[0].get();
+  const auto sshare_0 = output_futures_0[1].get();
+  const auto pshare_1 = output_futures_1[0].get();
+  const auto sshare_1 = output_futures_1[1].get();
+
+  ASSERT_EQ(pshare_0.size(), dims.get_data_size());
+  ASSERT_EQ(sshare_0.size(), dims.get_data_size());
+  ASSERT_EQ(sshare_1.size(), dims.get_data_size());
+  ASSERT_EQ(pshare_0, pshare_1);
+  for (std::size_t i = 0; i < input_a.size(); ++i) {
+    ASSERT_EQ(input_a[i], TypeParam(pshare_0[i] - sshare_0[i] - sshare_1[i]));
+  }
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, OutputSink) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
+  const auto input_a = this->generate_inputs(dims);
+  auto sink_0 = std::make_shared<MOTION::tensor::MemoryOutputSink>();
+  auto sink_1 = std::make_shared<MOTION::tensor::MemoryOutputSink>();
+
+  auto [input_a_promise, tensor_a_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_a_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(tensor_a_in_0, sink_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, tensor_a_in_1, sink_1);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_a_promise.set_value(input_a);
+  this->run_gates_online();
+
+  ASSERT_EQ(output_future.get(), input_a);
+  ASSERT_EQ(sink_0->get_dimensions(), dims);
+  ASSERT_EQ(sink_1->get_dimensions(), dims);
+  const auto& pshare_0 = sink_0->get_public_share();
+  const auto& sshare_0 = sink_0->get_secret_share();
+  const auto& sshare_1 = sink_1->get_secret_share();
+  ASSERT_EQ(pshare_0.size(), dims.get_data_size());
+  ASSERT_EQ(pshare_0, sink_1->get_public_share());
+  for (std::size_t i = 0; i < input_a.size(); ++i) {
+    ASSERT_EQ(input_a[i], TypeParam(pshare_0[i] - sshare_0[i] - sshare_1[i]));
+  }
+}
+
 TYPED_TEST(ArithmeticBEAVYTensorTest, Convolution) {
   // Convolution from CryptoNets
   const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
@@ -419,6 +516,405 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, Gemm) {
   ASSERT_EQ(plain_output, expected_output);
 }
 
+TYPED_TEST(ArithmeticBEAVYTensorTest, GemmRowTiles) {
+  const MOTION::tensor::GemmOp gemm_op = {.input_A_shape_ = {7, 100},
+                                          .input_B_shape_ = {100, 10},
+                                          .output_shape_ = {7, 10},
+                                          .tile_rows_ = 3};
+  ASSERT_TRUE(gemm_op.verify());
+  ASSERT_EQ(gemm_op.compute_row_tiles().size(), 3);
+  const auto input_A_dims = gemm_op.get_input_A_tensor_dims();
+  const auto input_B_dims = gemm_op.get_input_B_tensor_dims();
+  const auto output_dims = gemm_op.get_output_tensor_dims();
+  const auto input_A = this->generate_inputs(input_A_dims);
+  const auto input_B = this->generate_inputs(input_B_dims);
+
+  auto [input_A_promise, tensor_input_A_0] =
+      this->make_arithmetic_T_tensor_input_my(0, input_A_dims);
+  auto tensor_input_A_1 = this->make_arithmetic_T_tensor_input_other(1, input_A_dims);
+  auto tensor_input_B_0 = this->make_arithmetic_T_tensor_input_other(0, input_B_dims);
+  auto [input_B_promise, tensor_input_B_1] =
+      this->make_arithmetic_T_tensor_input_my(1, input_B_dims);
+
+  ASSERT_EQ(tensor_input_A_0->get_dimensions(), input_A_dims);
+  ASSERT_EQ(tensor_input_A_1->get_dimensions(), input_A_dims);
+  ASSERT_EQ(tensor_input_B_0->get_dimensions(), input_B_dims);
+  ASSERT_EQ(tensor_input_B_1->get_dimensions(), input_B_dims);
+
+  auto tensor_output_0 =
+      this->beavy_providers_[0]->make_tensor_gemm_op(gemm_op, tensor_input_A_0, tensor_input_B_0);
+  auto tensor_output_1 =
+      this->beavy_providers_[1]->make_tensor_gemm_op(gemm_op, tensor_input_A_1, tensor_input_B_1);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_A_promise.set_value(input_A);
+  input_B_promise.set_value(input_B);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_1.size(), output_dims.get_data_size());
+  ASSERT_EQ(secret_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(secret_output_share_1.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  const auto expected_output =
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.input_B_shape_[1], input_A, input_B);
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  ASSERT_EQ(plain_output, expected_output);
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, GemmDealerTriples) {
+  // the dealer has to deal the triples of exactly the registered GemmOps, including row tiles and
+  // transposed operands
+  const std::vector<MOTION::tensor::GemmOp> gemm_ops = {
+      {.input_A_shape_ = {7, 100}, .input_B_shape_ = {100, 3}, .output_shape_ = {7, 3}},
+      {.input_A_shape_ = {7, 100},
+       .input_B_shape_ = {100, 3},
+       .output_shape_ = {7, 3},
+       .tile_rows_ = 3},
+      {.input_A_shape_ = {100, 7},
+       .input_B_shape_ = {3, 100},
+       .output_shape_ = {7, 3},
+       .transA_ = true,
+       .transB_ = true}};
+
+  // the cross terms are computed with triples of a dealer instead of OTs
+  std::array<std::unique_ptr<MOTION::Communication::DummyTransport>, 2> party_transports;
+  std::array<std::unique_ptr<MOTION::Communication::DummyTransport>, 2> dealer_transports;
+  std::array<std::shared_ptr<MOTION::DealerLinAlgTripleProvider>, 2> linalg_triple_providers;
+  for (std::size_t i = 0; i < 2; ++i) {
+    std::tie(party_transports[i], dealer_transports[i]) =
+        MOTION::Communication::DummyTransport::make_transport_pair();
+    linalg_triple_providers[i] = std::make_shared<MOTION::DealerLinAlgTripleProvider>(
+        i, *party_transports[i], this->stats_[i], nullptr);
+    this->beavy_providers_[i]->set_linalg_triple_provider(linalg_triple_providers[i]);
+  }
+  MOTION::LinAlgTripleDealer dealer(*dealer_transports[0], *dealer_transports[1]);
+
+  std::vector<std::vector<TypeParam>> inputs_A, inputs_B;
+  std::vector<ENCRYPTO::ReusableFiberPromise<MOTION::IntegerValues<TypeParam>>> promises;
+  std::vector<std::array<MOTION::tensor::TensorCP, 2>> tensor_outputs;
+  for (const auto& gemm_op : gemm_ops) {
+    ASSERT_TRUE(gemm_op.verify());
+    const auto input_A_dims = gemm_op.get_input_A_tensor_dims();
+    const auto input_B_dims = gemm_op.get_input_B_tensor_dims();
+    inputs_A.push_back(this->generate_inputs(input_A_dims));
+    inputs_B.push_back(this->generate_inputs(input_B_dims));
+
+    auto [input_A_promise, tensor_input_A_0] =
+        this->make_arithmetic_T_tensor_input_my(0, input_A_dims);
+    auto tensor_input_A_1 = this->make_arithmetic_T_tensor_input_other(1, input_A_dims);
+    auto tensor_input_B_0 = this->make_arithmetic_T_tensor_input_other(0, input_B_dims);
+    auto [input_B_promise, tensor_input_B_1] =
+        this->make_arithmetic_T_tensor_input_my(1, input_B_dims);
+    promises.push_back(std::move(input_A_promise));
+    promises.push_back(std::move(input_B_promise));
+
+    tensor_outputs.push_back(
+        {this->beavy_providers_[0]->make_tensor_gemm_op(gemm_op, tensor_input_A_0,
+                                                         tensor_input_B_0),
+         this->beavy_providers_[1]->make_tensor_gemm_op(gemm_op, tensor_input_A_1,
+                                                         tensor_input_B_1)});
+  }
+
+  this->run_setup();
+  {
+    auto f_dealer = std::async(std::launch::async, [&dealer] { return dealer.deal(); });
+    auto f_0 = std::async(std::launch::async,
+                          [&linalg_triple_providers] { linalg_triple_providers[0]->setup(); });
+    linalg_triple_providers[1]->setup();
+    f_0.get();
+    ASSERT_TRUE(f_dealer.get());
+  }
+  this->run_gates_setup();
+  for (std::size_t op_i = 0; op_i < gemm_ops.size(); ++op_i) {
+    promises[2 * op_i].set_value(inputs_A[op_i]);
+    promises[2 * op_i + 1].set_value(inputs_B[op_i]);
+  }
+  this->run_gates_online();
+
+  for (std::size_t op_i = 0; op_i < gemm_ops.size(); ++op_i) {
+    const auto& gemm_op = gemm_ops[op_i];
+    const auto output_beavy_tensor_0 =
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_outputs[op_i][0]);
+    const auto output_beavy_tensor_1 =
+        std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_outputs[op_i][1]);
+
+    const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+    const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+    const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+    const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+    ASSERT_EQ(public_output_share_0.size(), gemm_op.compute_output_size());
+    ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+    std::vector<TypeParam> expected_output(gemm_op.compute_output_size());
+    MOTION::matrix_multiply(gemm_op, inputs_A[op_i].data(), inputs_B[op_i].data(),
+                            expected_output.data());
+    const auto plain_output = MOTION::Helpers::SubVectors(
+        public_output_share_0,
+        MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+    EXPECT_EQ(plain_output, expected_output) << "GemmOp " << op_i;
+  }
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, GemmBias) {
+  const MOTION::tensor::GemmOp gemm_op = {.input_A_shape_ = {7, 100},
+                                          .input_B_shape_ = {100, 3},
+                                          .output_shape_ = {7, 3},
+                                          .tile_rows_ = 3};
+  ASSERT_TRUE(gemm_op.verify());
+  const auto input_A_dims = gemm_op.get_input_A_tensor_dims();
+  const auto input_B_dims = gemm_op.get_input_B_tensor_dims();
+  const auto output_dims = gemm_op.get_output_tensor_dims();
+  const auto input_A = this->generate_inputs(input_A_dims);
+  const auto input_B = this->generate_inputs(input_B_dims);
+  const auto bias = this->generate_inputs(output_dims);
+
+  auto [input_A_promise, tensor_input_A_0] =
+      this->make_arithmetic_T_tensor_input_my(0, input_A_dims);
+  auto tensor_input_A_1 = this->make_arithmetic_T_tensor_input_other(1, input_A_dims);
+  auto tensor_input_B_0 = this->make_arithmetic_T_tensor_input_other(0, input_B_dims);
+  auto [input_B_promise, tensor_input_B_1] =
+      this->make_arithmetic_T_tensor_input_my(1, input_B_dims);
+  auto [bias_promise, tensor_bias_0] = this->make_arithmetic_T_tensor_input_my(0, output_dims);
+  auto tensor_bias_1 = this->make_arithmetic_T_tensor_input_other(1, output_dims);
+
+  auto tensor_output_0 = this->beavy_providers_[0]->make_tensor_gemm_op(
+      gemm_op, tensor_input_A_0, tensor_input_B_0, tensor_bias_0);
+  auto tensor_output_1 = this->beavy_providers_[1]->make_tensor_gemm_op(
+      gemm_op, tensor_input_A_1, tensor_input_B_1, tensor_bias_1);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_A_promise.set_value(input_A);
+  input_B_promise.set_value(input_B);
+  bias_promise.set_value(bias);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_1.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  const auto expected_output = MOTION::Helpers::AddVectors(
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.input_B_shape_[1], input_A, input_B),
+      bias);
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  ASSERT_EQ(plain_output, expected_output);
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, GemmBiasTruncation) {
+  const MOTION::tensor::GemmOp gemm_op = {.input_A_shape_ = {7, 16},
+                                          .input_B_shape_ = {16, 3},
+                                          .output_shape_ = {7, 3},
+                                          .tile_rows_ = 3};
+  ASSERT_TRUE(gemm_op.verify());
+  const std::size_t fractional_bits = 8;
+  const auto input_A_dims = gemm_op.get_input_A_tensor_dims();
+  const auto input_B_dims = gemm_op.get_input_B_tensor_dims();
+  const auto output_dims = gemm_op.get_output_tensor_dims();
+  const auto input_A = this->generate_small_inputs(input_A_dims, fractional_bits);
+  const auto input_B = this->generate_small_inputs(input_B_dims, fractional_bits);
+  const auto bias = this->generate_small_inputs(output_dims, fractional_bits);
+
+  auto [input_A_promise, tensor_input_A_0] =
+      this->make_arithmetic_T_tensor_input_my(0, input_A_dims);
+  auto tensor_input_A_1 = this->make_arithmetic_T_tensor_input_other(1, input_A_dims);
+  auto tensor_input_B_0 = this->make_arithmetic_T_tensor_input_other(0, input_B_dims);
+  auto [input_B_promise, tensor_input_B_1] =
+      this->make_arithmetic_T_tensor_input_my(1, input_B_dims);
+  auto [bias_promise, tensor_bias_0] = this->make_arithmetic_T_tensor_input_my(0, output_dims);
+  auto tensor_bias_1 = this->make_arithmetic_T_tensor_input_other(1, output_dims);
+
+  auto tensor_output_0 = this->beavy_providers_[0]->make_tensor_gemm_op(
+      gemm_op, tensor_input_A_0, tensor_input_B_0, tensor_bias_0, fractional_bits);
+  auto tensor_output_1 = this->beavy_providers_[1]->make_tensor_gemm_op(
+      gemm_op, tensor_input_A_1, tensor_input_B_1, tensor_bias_1, fractional_bits);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_A_promise.set_value(input_A);
+  input_B_promise.set_value(input_B);
+  bias_promise.set_value(bias);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  // plaintext reference: arithmetic shift of the signed product, then add the bias
+  using S = std::make_signed_t<TypeParam>;
+  auto expected_output =
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.input_B_shape_[1], input_A, input_B);
+  for (std::size_t i = 0; i < expected_output.size(); ++i) {
+    expected_output[i] =
+        TypeParam(static_cast<S>(expected_output[i]) >> fractional_bits) + bias[i];
+  }
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  this->expect_truncation_error_at_most_one(plain_output, expected_output);
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, ConstMatMul) {
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {7, 100}, .input_B_shape_ = {100, 3}, .output_shape_ = {7, 3}};
+  ASSERT_TRUE(gemm_op.verify());
+  const auto input_dims = gemm_op.get_input_B_tensor_dims();
+  const auto output_dims = gemm_op.get_output_tensor_dims();
+  const auto public_matrix =
+      MOTION::Helpers::RandomVector<std::uint64_t>(gemm_op.compute_input_A_size());
+  const auto input = this->generate_inputs(input_dims);
+
+  auto tensor_input_0 = this->make_arithmetic_T_tensor_input_other(0, input_dims);
+  auto [input_promise, tensor_input_1] = this->make_arithmetic_T_tensor_input_my(1, input_dims);
+
+  auto tensor_output_0 =
+      this->beavy_providers_[0]->make_tensor_constMatMul_op(gemm_op, public_matrix, tensor_input_0);
+  auto tensor_output_1 =
+      this->beavy_providers_[1]->make_tensor_constMatMul_op(gemm_op, public_matrix, tensor_input_1);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  const std::vector<TypeParam> matrix(std::begin(public_matrix), std::end(public_matrix));
+  const auto expected_output =
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.input_B_shape_[1], matrix, input);
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  ASSERT_EQ(plain_output, expected_output);
+}
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, ConstMatMulTruncation) {
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {7, 16}, .input_B_shape_ = {16, 3}, .output_shape_ = {7, 3}};
+  ASSERT_TRUE(gemm_op.verify());
+  const std::size_t fractional_bits = 8;
+  const auto input_dims = gemm_op.get_input_B_tensor_dims();
+  const auto output_dims = gemm_op.get_output_tensor_dims();
+  const auto matrix =
+      this->generate_small_inputs(gemm_op.get_input_A_tensor_dims(), fractional_bits);
+  // the public matrix is given in the 64 bit ring, sign-extend the negative values
+  std::vector<std::uint64_t> public_matrix(matrix.size());
+  std::transform(std::begin(matrix), std::end(matrix), std::begin(public_matrix), [](auto v) {
+    return static_cast<std::uint64_t>(static_cast<std::make_signed_t<TypeParam>>(v));
+  });
+  const auto input = this->generate_small_inputs(input_dims, fractional_bits);
+
+  auto tensor_input_0 = this->make_arithmetic_T_tensor_input_other(0, input_dims);
+  auto [input_promise, tensor_input_1] = this->make_arithmetic_T_tensor_input_my(1, input_dims);
+
+  auto tensor_output_0 = this->beavy_providers_[0]->make_tensor_constMatMul_op(
+      gemm_op, public_matrix, tensor_input_0, fractional_bits);
+  auto tensor_output_1 = this->beavy_providers_[1]->make_tensor_constMatMul_op(
+      gemm_op, public_matrix, tensor_input_1, fractional_bits);
+
+  ASSERT_EQ(tensor_output_0->get_dimensions(), output_dims);
+  ASSERT_EQ(tensor_output_1->get_dimensions(), output_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output_beavy_tensor_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_0);
+  const auto output_beavy_tensor_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_output_1);
+
+  const auto& public_output_share_0 = output_beavy_tensor_0->get_public_share();
+  const auto& public_output_share_1 = output_beavy_tensor_1->get_public_share();
+  const auto& secret_output_share_0 = output_beavy_tensor_0->get_secret_share();
+  const auto& secret_output_share_1 = output_beavy_tensor_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), output_dims.get_data_size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  // plaintext reference: arithmetic shift of the signed product
+  auto expected_output =
+      MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                              gemm_op.input_B_shape_[1], matrix, input);
+  for (auto& v : expected_output) {
+    v = TypeParam(static_cast<std::make_signed_t<TypeParam>>(v) >> fractional_bits);
+  }
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+
+  this->expect_truncation_error_at_most_one(plain_output, expected_output);
+}
+
 TYPED_TEST(ArithmeticBEAVYTensorTest, Sqr) {
   MOTION::tensor::TensorDimensions dims = {
       .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
@@ -466,3 +962,57 @@ TYPED_TEST(ArithmeticBEAVYTensorTest, Sqr) {
       MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
   ASSERT_EQ(plain_output, expected_output);
 }
+
+TYPED_TEST(ArithmeticBEAVYTensorTest, Relu) {
+  MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
+  auto input = this->generate_inputs(dims);
+  constexpr auto msb = TypeParam(1) << (ENCRYPTO::bit_size_v<TypeParam> - 1);
+  // include the boundaries of the signed range
+  input[0] = 0;
+  input[1] = msb;
+  input[2] = msb - 1;
+  input[3] = TypeParam(-1);
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_out_0 = this->beavy_providers_[0]->make_tensor_relu_op(tensor_in_0);
+  auto tensor_out_1 = this->beavy_providers_[1]->make_tensor_relu_op(tensor_in_1);
+
+  ASSERT_EQ(tensor_out_0->get_protocol(), MOTION::MPCProtocol::ArithmeticBEAVY);
+  ASSERT_EQ(tensor_out_0->get_dimensions(), dims);
+  ASSERT_EQ(tensor_out_1->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto tensor_output_0 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_out_0);
+  const auto tensor_output_1 =
+      std::dynamic_pointer_cast<const ArithmeticBEAVYTensor<TypeParam>>(tensor_out_1);
+
+  ASSERT_NE(tensor_output_0, nullptr);
+  ASSERT_NE(tensor_output_1, nullptr);
+
+  tensor_output_0->wait_online();
+  tensor_output_1->wait_online();
+
+  const auto& public_output_share_0 = tensor_output_0->get_public_share();
+  const auto& public_output_share_1 = tensor_output_1->get_public_share();
+  const auto& secret_output_share_0 = tensor_output_0->get_secret_share();
+  const auto& secret_output_share_1 = tensor_output_1->get_secret_share();
+
+  ASSERT_EQ(public_output_share_0.size(), input.size());
+  ASSERT_EQ(public_output_share_0, public_output_share_1);
+
+  std::vector<TypeParam> expected_output(input.size());
+  std::transform(std::begin(input), std::end(input), std::begin(expected_output),
+                 [](auto x) { return (x & msb) ? TypeParam(0) : x; });
+  const auto plain_output = MOTION::Helpers::SubVectors(
+      public_output_share_0,
+      MOTION::Helpers::AddVectors(secret_output_share_0, secret_output_share_1));
+  ASSERT_EQ(plain_output, expected_output);
+}
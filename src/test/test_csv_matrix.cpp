@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utility/csv_matrix.h"
+
+namespace {
+
+std::string write_csv(const std::string& name, const std::string& content) {
+  const auto path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream file(path);
+  file << content;
+  return path;
+}
+
+}  // namespace
+
+TEST(CsvMatrix, ReadFixedPoint) {
+  // commas and whitespace as separators, negative values and a Windows line ending
+  const auto path = write_csv("motion_test_matrix.csv", "1.5, -2,0.25\r\n-0.5 3\t-1.25\n");
+  const auto matrix = MOTION::read_fixed_point_csv(path, 2, 3, 8);
+  const std::vector<std::uint64_t> expected = {
+      384, std::uint64_t(-512), 64, std::uint64_t(-128), 768, std::uint64_t(-320)};
+  EXPECT_EQ(matrix, expected);
+  std::filesystem::remove(path);
+}
+
+TEST(CsvMatrix, RoundsToNearest) {
+  const auto path = write_csv("motion_test_matrix.csv", "0.1,-0.1\n");
+  // 0.1 * 2^4 = 1.6
+  const std::vector<std::uint64_t> expected = {2, std::uint64_t(-2)};
+  EXPECT_EQ(MOTION::read_fixed_point_csv(path, 1, 2, 4), expected);
+  std::filesystem::remove(path);
+}
+
+TEST(CsvMatrix, RejectsMalformedCells) {
+  for (const auto* content : {"1.0,abc\n", "1.0,2.5x\n", "1.0,--2\n", "1.0;2.0\n"}) {
+    const auto path = write_csv("motion_test_matrix.csv", content);
+    EXPECT_THROW(MOTION::read_fixed_point_csv(path, 1, 2, 8), std::invalid_argument) << content;
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(CsvMatrix, RejectsWrongNumberOfValues) {
+  const auto path = write_csv("motion_test_matrix.csv", "1,2,3\n4,5,6\n");
+  EXPECT_THROW(MOTION::read_fixed_point_csv(path, 2, 2, 8), std::invalid_argument);
+  EXPECT_THROW(MOTION::read_fixed_point_csv(path, 2, 4, 8), std::invalid_argument);
+  EXPECT_NO_THROW(MOTION::read_fixed_point_csv(path, 3, 2, 8));
+  std::filesystem::remove(path);
+}
+
+TEST(CsvMatrix, MissingFile) {
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_missing.csv").string();
+  std::filesystem::remove(path);
+  EXPECT_THROW(MOTION::read_fixed_point_csv(path, 1, 1, 8), std::runtime_error);
+}
@@ -25,6 +25,7 @@
 #include <memory>
 
 #include "communication/communication_layer.h"
+#include "communication/dummy_transport.h"
 #include "crypto/arithmetic_provider.h"
 #include "crypto/base_ots/base_ot_provider.h"
 #include "crypto/motion_base_provider.h"
@@ -230,3 +231,115 @@ TYPED_TEST(LinAlgTripleProviderTest, ReLU) {
   }
   ASSERT_EQ(plain_triple.c_, expected_c);
 }
+
+template <typename T>
+class DealerLinAlgTripleProviderTest : public ::testing::Test {
+  using is_enabled_t_ = ENCRYPTO::is_unsigned_int_t<T>;
+
+ protected:
+  void SetUp() override {
+    for (std::size_t i = 0; i < 2; ++i) {
+      auto [party_transport, dealer_transport] =
+          MOTION::Communication::DummyTransport::make_transport_pair();
+      party_transports_[i] = std::move(party_transport);
+      dealer_transports_[i] = std::move(dealer_transport);
+      linalg_triple_providers_[i] = std::make_unique<MOTION::DealerLinAlgTripleProvider>(
+          i, *party_transports_[i], stats_[i], nullptr);
+    }
+    dealer_ = std::make_unique<MOTION::LinAlgTripleDealer>(*dealer_transports_[0],
+                                                           *dealer_transports_[1]);
+  }
+
+  void run_setup() {
+    std::vector<std::future<void>> futs;
+    futs.emplace_back(std::async(std::launch::async, [this] { EXPECT_TRUE(dealer_->deal()); }));
+    for (std::size_t i = 0; i < 2; ++i) {
+      futs.emplace_back(
+          std::async(std::launch::async, [this, i] { linalg_triple_providers_[i]->setup(); }));
+    }
+    std::for_each(std::begin(futs), std::end(futs), [](auto& f) { f.get(); });
+  }
+
+  std::array<std::unique_ptr<MOTION::Communication::DummyTransport>, 2> party_transports_;
+  std::array<std::unique_ptr<MOTION::Communication::DummyTransport>, 2> dealer_transports_;
+  std::array<std::unique_ptr<MOTION::LinAlgTripleProvider>, 2> linalg_triple_providers_;
+  std::unique_ptr<MOTION::LinAlgTripleDealer> dealer_;
+  std::array<MOTION::Statistics::RunTimeStats, 2> stats_;
+};
+
+TYPED_TEST_SUITE(DealerLinAlgTripleProviderTest, integer_types);
+
+TYPED_TEST(DealerLinAlgTripleProviderTest, GemmConvolutionReLU) {
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {7, 11}, .input_B_shape_ = {11, 13}, .output_shape_ = {7, 13}};
+  const MOTION::tensor::Conv2DOp conv_op = {.kernel_shape_ = {5, 1, 5, 5},
+                                            .input_shape_ = {1, 28, 28},
+                                            .output_shape_ = {5, 13, 13},
+                                            .dilations_ = {1, 1},
+                                            .pads_ = {1, 1, 0, 0},
+                                            .strides_ = {2, 2}};
+  const std::size_t num_triples = 100;
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+  ASSERT_TRUE(gemm_op.verify());
+  ASSERT_TRUE(conv_op.verify());
+
+  // register in different orders, the providers agree on the order with the dealer
+  std::array<std::size_t, 2> gemm_index_0, gemm_index_1, conv_index, relu_index;
+  for (std::size_t i = 0; i < 2; ++i) {
+    auto& provider = *this->linalg_triple_providers_[i];
+    if (i == 0) {
+      relu_index[i] = provider.register_for_relu_triple(num_triples, bit_size);
+      conv_index[i] = provider.template register_for_conv2d_triple<TypeParam>(conv_op);
+    }
+    gemm_index_0[i] = provider.template register_for_gemm_triple<TypeParam>(gemm_op);
+    gemm_index_1[i] = provider.template register_for_gemm_triple<TypeParam>(gemm_op);
+    if (i == 1) {
+      conv_index[i] = provider.template register_for_conv2d_triple<TypeParam>(conv_op);
+      relu_index[i] = provider.register_for_relu_triple(num_triples, bit_size);
+    }
+  }
+
+  this->run_setup();
+
+  for (const auto& gemm_index : {gemm_index_0, gemm_index_1}) {
+    auto triple_0 = this->linalg_triple_providers_[0]->template get_gemm_triple<TypeParam>(
+        gemm_op, gemm_index[0]);
+    auto triple_1 = this->linalg_triple_providers_[1]->template get_gemm_triple<TypeParam>(
+        gemm_op, gemm_index[1]);
+    ASSERT_EQ(triple_0.a_.size(), gemm_op.compute_input_A_size());
+    ASSERT_EQ(triple_1.b_.size(), gemm_op.compute_input_B_size());
+    ASSERT_EQ(triple_1.c_.size(), gemm_op.compute_output_size());
+    auto a = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+    auto b = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+    auto c = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+    ASSERT_EQ(c, MOTION::matrix_multiply(gemm_op.input_A_shape_[0], gemm_op.input_A_shape_[1],
+                                         gemm_op.output_shape_[1], a, b));
+  }
+
+  {
+    auto triple_0 = this->linalg_triple_providers_[0]->template get_conv2d_triple<TypeParam>(
+        conv_op, conv_index[0]);
+    auto triple_1 = this->linalg_triple_providers_[1]->template get_conv2d_triple<TypeParam>(
+        conv_op, conv_index[1]);
+    ASSERT_EQ(triple_1.c_.size(), conv_op.compute_output_size());
+    auto a = MOTION::Helpers::AddVectors(triple_0.a_, triple_1.a_);
+    auto b = MOTION::Helpers::AddVectors(triple_0.b_, triple_1.b_);
+    auto c = MOTION::Helpers::AddVectors(triple_0.c_, triple_1.c_);
+    ASSERT_EQ(c, MOTION::convolution(conv_op, a, b));
+  }
+
+  {
+    auto triple_0 = this->linalg_triple_providers_[0]->get_relu_triple(num_triples, bit_size,
+                                                                       relu_index[0]);
+    auto triple_1 = this->linalg_triple_providers_[1]->get_relu_triple(num_triples, bit_size,
+                                                                       relu_index[1]);
+    ASSERT_EQ(triple_1.a_.GetSize(), num_triples);
+    ASSERT_EQ(triple_1.c_.size(), bit_size - 1);
+    auto a = triple_0.a_ ^ triple_1.a_;
+    for (std::size_t bit_j = 0; bit_j < bit_size - 1; ++bit_j) {
+      auto b = triple_0.b_.at(bit_j) ^ triple_1.b_.at(bit_j);
+      auto c = triple_0.c_.at(bit_j) ^ triple_1.c_.at(bit_j);
+      ASSERT_EQ(c, a & b);
+    }
+  }
+}
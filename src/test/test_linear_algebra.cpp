@@ -21,7 +21,11 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
+#include <random>
+#include <tuple>
+#include <type_traits>
 #include "tensor/tensor_op.h"
 #include "utility/linear_algebra.h"
 
@@ -256,3 +260,164 @@ TEST(LinearAlgebra, SumPool2) {
   MOTION::sum_pool(avgpool_op, input.data(), output.data());
   ASSERT_EQ(output, expected_output);
 }
+
+// a matrix times a single column takes the matrix-vector path, compare it with the columns of a
+// product computed by the blocked kernel
+TEST(LinearAlgebra, MatrixVectorMultiply) {
+  const std::size_t dim_l = 37, dim_m = 300, dim_n = 3;
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> A(dim_l * dim_m);
+  std::vector<std::uint64_t> B(dim_m * dim_n);
+  std::generate(std::begin(A), std::end(A), rng);
+  std::generate(std::begin(B), std::end(B), rng);
+  const auto expected_output = MOTION::matrix_multiply(dim_l, dim_m, dim_n, A, B);
+
+  for (std::size_t j = 0; j < dim_n; ++j) {
+    std::vector<std::uint64_t> column(dim_m);
+    for (std::size_t k = 0; k < dim_m; ++k) {
+      column[k] = B[k * dim_n + j];
+    }
+    const auto output = MOTION::matrix_multiply(dim_l, dim_m, 1, A, column);
+    ASSERT_EQ(output.size(), dim_l);
+    for (std::size_t i = 0; i < dim_l; ++i) {
+      EXPECT_EQ(output[i], expected_output[i * dim_n + j]);
+    }
+  }
+
+  const MOTION::tensor::GemmOp gemm_op = {
+      .input_A_shape_ = {dim_l, dim_m}, .input_B_shape_ = {dim_m, 1}, .output_shape_ = {dim_l, 1}};
+  ASSERT_TRUE(gemm_op.verify());
+  std::vector<std::uint64_t> A_2(dim_l * dim_m);
+  std::vector<std::uint64_t> x_1(dim_m), x_2(dim_m), output(dim_l);
+  std::generate(std::begin(A_2), std::end(A_2), rng);
+  std::generate(std::begin(x_1), std::end(x_1), rng);
+  std::generate(std::begin(x_2), std::end(x_2), rng);
+  std::generate(std::begin(output), std::end(output), rng);
+  auto expected_accumulation = output;
+  const auto product_1 = MOTION::matrix_multiply(dim_l, dim_m, 1, A, x_1);
+  const auto product_2 = MOTION::matrix_multiply(dim_l, dim_m, 1, A_2, x_2);
+  for (std::size_t i = 0; i < dim_l; ++i) {
+    expected_accumulation[i] += product_1[i] - product_2[i];
+  }
+  MOTION::matrix_multiply_accumulate(gemm_op, A.data(), x_1.data(), A_2.data(), x_2.data(),
+                                     output.data());
+  ASSERT_EQ(output, expected_accumulation);
+}
+
+template <typename T>
+class RingGemmTest : public ::testing::Test {
+ protected:
+  static std::vector<T> generate(std::size_t size, std::mt19937_64& rng) {
+    std::vector<T> values(size);
+    for (auto& v : values) {
+      if constexpr (sizeof(T) > sizeof(std::uint64_t)) {
+        v = (T(rng()) << 64) | T(rng());
+      } else {
+        v = static_cast<T>(rng());
+      }
+    }
+    return values;
+  }
+
+  // A(i, k) of the (dim_l x dim_m) operand stored with the shape of the GemmOp
+  static T get(const std::vector<T>& matrix, const std::array<std::size_t, 2>& shape, bool transposed,
+               std::size_t i, std::size_t k) {
+    return transposed ? matrix[k * shape[1] + i] : matrix[i * shape[1] + k];
+  }
+
+  // naive triple loop over the logical (possibly transposed) operands
+  static std::vector<T> naive_multiply(const MOTION::tensor::GemmOp& gemm_op,
+                                       const std::vector<T>& A, const std::vector<T>& B) {
+    const auto dim_l = gemm_op.output_shape_[0];
+    const auto dim_n = gemm_op.output_shape_[1];
+    const auto dim_m = gemm_op.input_A_shape_[gemm_op.transA_ ? 0 : 1];
+    std::vector<T> output(dim_l * dim_n);
+    for (std::size_t i = 0; i < dim_l; ++i) {
+      for (std::size_t j = 0; j < dim_n; ++j) {
+        T sum = 0;
+        for (std::size_t k = 0; k < dim_m; ++k) {
+          sum += static_cast<T>(get(A, gemm_op.input_A_shape_, gemm_op.transA_, i, k) *
+                                get(B, gemm_op.input_B_shape_, gemm_op.transB_, k, j));
+        }
+        output[i * dim_n + j] = sum;
+      }
+    }
+    return output;
+  }
+
+  static MOTION::tensor::GemmOp make_gemm_op(std::size_t dim_l, std::size_t dim_m,
+                                             std::size_t dim_n, bool transA, bool transB) {
+    MOTION::tensor::GemmOp gemm_op = {
+        .input_A_shape_ = {dim_l, dim_m}, .input_B_shape_ = {dim_m, dim_n},
+        .output_shape_ = {dim_l, dim_n}, .transA_ = transA, .transB_ = transB};
+    if (transA) {
+      gemm_op.input_A_shape_ = {dim_m, dim_l};
+    }
+    if (transB) {
+      gemm_op.input_B_shape_ = {dim_n, dim_m};
+    }
+    return gemm_op;
+  }
+
+  // (dim_l, dim_m, dim_n): single elements, sizes that are no multiples of the micro kernel and
+  // sizes crossing the row, inner and column blocks of the kernel
+  static constexpr std::array<std::array<std::size_t, 3>, 7> sizes_ = {
+      {{1, 1, 1}, {5, 3, 7}, {4, 17, 1}, {13, 300, 1}, {67, 259, 35}, {130, 513, 19}, {3, 5, 2051}}};
+};
+
+using ring_types =
+    ::testing::Types<std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, __uint128_t>;
+TYPED_TEST_SUITE(RingGemmTest, ring_types);
+
+TYPED_TEST(RingGemmTest, MatrixMultiply) {
+  std::mt19937_64 rng(42);
+  for (const auto& [dim_l, dim_m, dim_n] : this->sizes_) {
+    for (const bool transA : {false, true}) {
+      for (const bool transB : {false, true}) {
+        const auto gemm_op = this->make_gemm_op(dim_l, dim_m, dim_n, transA, transB);
+        ASSERT_TRUE(gemm_op.verify());
+        const auto A = this->generate(gemm_op.compute_input_A_size(), rng);
+        const auto B = this->generate(gemm_op.compute_input_B_size(), rng);
+        std::vector<TypeParam> output(gemm_op.compute_output_size());
+        MOTION::matrix_multiply(gemm_op, A.data(), B.data(), output.data());
+        EXPECT_TRUE(output == this->naive_multiply(gemm_op, A, B))
+            << dim_l << " x " << dim_m << " x " << dim_n << ", transA = " << transA
+            << ", transB = " << transB;
+        if (!transA && !transB) {
+          EXPECT_TRUE(MOTION::matrix_multiply(dim_l, dim_m, dim_n, A, B) == output);
+        }
+      }
+    }
+  }
+}
+
+TYPED_TEST(RingGemmTest, MatrixMultiplyAccumulate) {
+  // only instantiated for the rings of the arithmetic shares
+  if constexpr (std::is_same_v<TypeParam, std::uint32_t> ||
+                std::is_same_v<TypeParam, std::uint64_t>) {
+    std::mt19937_64 rng(43);
+    for (const auto& [dim_l, dim_m, dim_n] : this->sizes_) {
+      for (const bool transA : {false, true}) {
+        for (const bool transB : {false, true}) {
+          const auto gemm_op = this->make_gemm_op(dim_l, dim_m, dim_n, transA, transB);
+          const auto A_1 = this->generate(gemm_op.compute_input_A_size(), rng);
+          const auto B_1 = this->generate(gemm_op.compute_input_B_size(), rng);
+          const auto A_2 = this->generate(gemm_op.compute_input_A_size(), rng);
+          const auto B_2 = this->generate(gemm_op.compute_input_B_size(), rng);
+          auto output = this->generate(gemm_op.compute_output_size(), rng);
+          auto expected_output = output;
+          const auto product_1 = this->naive_multiply(gemm_op, A_1, B_1);
+          const auto product_2 = this->naive_multiply(gemm_op, A_2, B_2);
+          for (std::size_t i = 0; i < expected_output.size(); ++i) {
+            expected_output[i] += product_1[i] - product_2[i];
+          }
+          MOTION::matrix_multiply_accumulate(gemm_op, A_1.data(), B_1.data(), A_2.data(),
+                                             B_2.data(), output.data());
+          EXPECT_EQ(output, expected_output)
+              << dim_l << " x " << dim_m << " x " << dim_n << ", transA = " << transA
+              << ", transB = " << transB;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+
+#include "tensor/output_sink.h"
+#include "utility/helpers.h"
+#include "utility/share_file.h"
+
+namespace {
+
+// 4 x 3 matrix, e.g., the outputs of a batch of three images
+const MOTION::tensor::TensorDimensions dims = {
+    .batch_size_ = 1, .num_channels_ = 1, .height_ = 4, .width_ = 3};
+
+}  // namespace
+
+TEST(OutputSink, ShareFile) {
+  const auto Delta = MOTION::Helpers::RandomVector<std::uint64_t>(dims.get_data_size());
+  const auto delta = MOTION::Helpers::RandomVector<std::uint64_t>(dims.get_data_size());
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_sink.bin").string();
+
+  MOTION::tensor::ShareFileOutputSink sink(path, 13);
+  sink.write(dims, Delta, delta);
+  sink.flush();
+  {
+    const MOTION::MappedShareFile shares(path);
+    EXPECT_EQ(shares.get_rows(), 4);
+    EXPECT_EQ(shares.get_cols(), 3);
+    EXPECT_EQ(shares.get_fractional_bits(), 13);
+    EXPECT_EQ(shares.copy_Delta(0, 4), Delta);
+    EXPECT_EQ(shares.copy_delta(0, 4), delta);
+  }
+  std::filesystem::remove(path);
+
+  // the number of shares has to match the dimensions
+  EXPECT_THROW(sink.write(dims, Delta, std::vector<std::uint64_t>(3)), std::invalid_argument);
+}
+
+TEST(OutputSink, TextShareFile) {
+  const std::vector<std::uint64_t> Delta = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  const std::vector<std::uint64_t> delta = {12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+  const auto directory = std::filesystem::temp_directory_path();
+  const auto path = (directory / "motion_test_sink.txt").string();
+  const auto config_path = (directory / "motion_test_sink_config").string();
+
+  MOTION::tensor::TextShareFileOutputSink sink(path, config_path);
+  sink.write(dims, Delta, delta);
+  {
+    std::ifstream file(path);
+    std::size_t rows, cols;
+    ASSERT_TRUE(file >> rows >> cols);
+    EXPECT_EQ(rows, 4);
+    EXPECT_EQ(cols, 3);
+    std::vector<std::uint64_t> read_Delta(Delta.size()), read_delta(delta.size());
+    for (std::size_t i = 0; i < Delta.size(); ++i) {
+      ASSERT_TRUE(file >> read_Delta[i] >> read_delta[i]);
+    }
+    EXPECT_EQ(read_Delta, Delta);
+    EXPECT_EQ(read_delta, delta);
+    std::ifstream config(config_path);
+    std::string config_content;
+    std::getline(config, config_content);
+    EXPECT_EQ(config_content, path);
+  }
+  std::filesystem::remove(path);
+  std::filesystem::remove(config_path);
+}
+
+TEST(OutputSink, Socket) {
+  boost::asio::io_context io_context;
+  boost::asio::ip::tcp::acceptor acceptor(
+      io_context, {boost::asio::ip::make_address("127.0.0.1"), /* any port */ 0});
+  const auto port = acceptor.local_endpoint().port();
+
+  // the connection is established once and carries all writes
+  MOTION::tensor::SocketOutputSink sink("127.0.0.1", port, 13);
+  boost::asio::ip::tcp::socket socket(io_context);
+  acceptor.accept(socket);
+
+  std::array<std::vector<std::uint64_t>, 2> Deltas, deltas;
+  for (std::size_t i = 0; i < 2; ++i) {
+    Deltas[i] = MOTION::Helpers::RandomVector<std::uint64_t>(dims.get_data_size());
+    deltas[i] = MOTION::Helpers::RandomVector<std::uint64_t>(dims.get_data_size());
+    sink.write(dims, Deltas[i], deltas[i]);
+  }
+  sink.flush();
+
+  // every write is one message in the layout of a binary share file
+  for (std::size_t i = 0; i < 2; ++i) {
+    MOTION::ShareFileHeader header;
+    std::vector<std::uint64_t> Delta(dims.get_data_size()), delta(dims.get_data_size());
+    boost::asio::read(socket, boost::asio::buffer(&header, sizeof(header)));
+    boost::asio::read(socket, boost::asio::buffer(Delta));
+    boost::asio::read(socket, boost::asio::buffer(delta));
+    ASSERT_TRUE(MOTION::is_valid_share_file_header(header));
+    EXPECT_EQ(header.rows_, 4);
+    EXPECT_EQ(header.cols_, 3);
+    EXPECT_EQ(header.fractional_bits_, 13);
+    EXPECT_EQ(Delta, Deltas[i]);
+    EXPECT_EQ(delta, deltas[i]);
+  }
+}
+
+TEST(OutputSink, SocketConnectionRefused) {
+  std::uint16_t port;
+  {
+    boost::asio::io_context io_context;
+    boost::asio::ip::tcp::acceptor acceptor(
+        io_context, {boost::asio::ip::make_address("127.0.0.1"), /* any port */ 0});
+    port = acceptor.local_endpoint().port();
+  }
+  // the connection is established when the circuit is built, not in the online phase
+  EXPECT_THROW(MOTION::tensor::SocketOutputSink("127.0.0.1", port, 13), std::runtime_error);
+}
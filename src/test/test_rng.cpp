@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 
 #include "test_constants.h"
@@ -53,3 +55,34 @@ TEST(AES128_CTR_RNG, no_trivial_output) {
   rngt.random_blocks_aligned(output_1.data(), 10);
   EXPECT_NE(output_0, output_1);
 }
+
+TEST(AES128_CTR_RNG, set_key_is_deterministic) {
+  std::array<std::byte, AES128_CTR_RNG::block_size> key;
+  std::array<std::byte, 10 * AES128_CTR_RNG::block_size + 8> output_0;
+  std::array<std::byte, 10 * AES128_CTR_RNG::block_size + 8> output_1;
+  AES128_CTR_RNG rng;
+  AES128_CTR_RNG rng2;
+
+  rng.random_blocks(key.data(), 1);
+  rng.set_key(key.data());
+  rng2.set_key(key.data());
+  rng.random_bytes(output_0.data(), output_0.size());
+  rng2.random_bytes(output_1.data(), output_1.size());
+  // the same key results in the same bytes
+  EXPECT_EQ(output_0, output_1);
+
+  rng.set_key(key.data());
+  rng.random_bytes(output_1.data(), output_1.size());
+  // setting the key again restarts the stream
+  EXPECT_EQ(output_0, output_1);
+
+  // a stream starting at block 3 skips the first 3 blocks
+  rng2.set_key(key.data(), 3);
+  rng2.random_blocks(output_1.data(), 7);
+  EXPECT_TRUE(std::equal(std::begin(output_1), std::begin(output_1) + 7 * AES128_CTR_RNG::block_size,
+                         std::begin(output_0) + 3 * AES128_CTR_RNG::block_size));
+
+  rng.sample_key();
+  rng.random_bytes(output_1.data(), output_1.size());
+  EXPECT_NE(output_0, output_1);
+}
@@ -0,0 +1,82 @@
+// MIT License
+//
+// Copyright (c) 2021 Lennart Braun
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utility/helpers.h"
+#include "utility/share_file.h"
+
+TEST(ShareFile, RoundTrip) {
+  const std::size_t rows = 7;
+  const std::size_t cols = 5;
+  const auto Delta = MOTION::Helpers::RandomVector<std::uint64_t>(rows * cols);
+  const auto delta = MOTION::Helpers::RandomVector<std::uint64_t>(rows * cols);
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_shares.bin").string();
+
+  MOTION::write_share_file(path, rows, cols, 13, Delta, delta);
+  ASSERT_TRUE(MOTION::is_binary_share_file(path));
+  // header + Delta + delta
+  EXPECT_EQ(std::filesystem::file_size(path),
+            sizeof(MOTION::ShareFileHeader) + 2 * rows * cols * sizeof(std::uint64_t));
+  {
+    const MOTION::MappedShareFile shares(path);
+    EXPECT_EQ(shares.get_rows(), rows);
+    EXPECT_EQ(shares.get_cols(), cols);
+    EXPECT_EQ(shares.get_fractional_bits(), 13);
+    EXPECT_EQ(shares.copy_Delta(0, rows), Delta);
+    EXPECT_EQ(shares.copy_delta(0, rows), delta);
+
+    // row slices are taken in place
+    EXPECT_EQ(shares.get_Delta(2), shares.get_Delta() + 2 * cols);
+    const std::vector<std::uint64_t> expected_slice(Delta.begin() + 2 * cols,
+                                                    Delta.begin() + 5 * cols);
+    EXPECT_EQ(shares.copy_Delta(2, 5), expected_slice);
+    EXPECT_THROW(shares.copy_delta(3, rows + 1), std::out_of_range);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(ShareFile, RejectsTextFiles) {
+  const auto path = (std::filesystem::temp_directory_path() / "motion_test_shares.txt").string();
+  {
+    std::ofstream file(path);
+    file << "1 2\n3 4\n5 6\n";
+  }
+  EXPECT_FALSE(MOTION::is_binary_share_file(path));
+  EXPECT_THROW(MOTION::MappedShareFile shares(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(ShareFile, Header) {
+  auto header = MOTION::make_share_file_header(10, 1, 13);
+  EXPECT_TRUE(MOTION::is_valid_share_file_header(header));
+  EXPECT_EQ(header.rows_, 10);
+  EXPECT_EQ(header.cols_, 1);
+  EXPECT_EQ(header.fractional_bits_, 13);
+  header.version_ += 1;
+  EXPECT_FALSE(MOTION::is_valid_share_file_header(header));
+}
@@ -996,6 +996,52 @@ TYPED_TEST(YaoArithmeticBEAVYTensorTest, ConversionToBooleanBEAVYAndBack) {
   ASSERT_EQ(input, output);
 }
 
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, BooleanBEAVYOutputShares) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 3, .width_ = 5};
+  const auto input = this->generate_inputs(dims);
+  constexpr auto bit_size = ENCRYPTO::bit_size_v<TypeParam>;
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto tensor_bbeavy_0 =
+      this->yao_providers_[0]->make_convert_to_boolean_beavy_tensor(tensor_yao_0);
+  auto tensor_bbeavy_1 =
+      this->yao_providers_[1]->make_convert_to_boolean_beavy_tensor(tensor_yao_1);
+  auto output_futures_0 =
+      this->beavy_providers_[0]->make_boolean_tensor_output_shares(tensor_bbeavy_0);
+  auto output_futures_1 =
+      this->beavy_providers_[1]->make_boolean_tensor_output_shares(tensor_bbeavy_1);
+  ASSERT_EQ(output_futures_0.size(), 2);
+  ASSERT_EQ(output_futures_1.size(), 2);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto pshare_0 = output_futures_0[0].get();
+  const auto sshare_0 = output_futures_0[1].get();
+  const auto pshare_1 = output_futures_1[0].get();
+  const auto sshare_1 = output_futures_1[1].get();
+
+  ASSERT_EQ(pshare_0.size(), bit_size);
+  ASSERT_EQ(sshare_0.size(), bit_size);
+  ASSERT_EQ(sshare_1.size(), bit_size);
+  ASSERT_EQ(pshare_0, pshare_1);
+  for (std::size_t bit_j = 0; bit_j < bit_size; ++bit_j) {
+    const auto bits = pshare_0.at(bit_j) ^ sshare_0.at(bit_j) ^ sshare_1.at(bit_j);
+    ASSERT_EQ(bits.GetSize(), dims.get_data_size());
+    for (std::size_t int_i = 0; int_i < dims.get_data_size(); ++int_i) {
+      EXPECT_EQ(bits.Get(int_i), bool((input.at(int_i) >> bit_j) & 1));
+    }
+  }
+}
+
 TYPED_TEST(YaoArithmeticBEAVYTensorTest, ReLUInBooleanBEAVY) {
   MOTION::tensor::TensorDimensions dims = {
       .batch_size_ = 1, .num_channels_ = 1, .height_ = 28, .width_ = 28};
@@ -1194,3 +1240,168 @@ TYPED_TEST(YaoArithmeticBEAVYTensorTest, MaxPoolInBooleanBEAVY) {
   const auto output = output_future.get();
   EXPECT_EQ(output, expected_output);
 }
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, Argmax) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 5, .width_ = 1};
+  // signed comparison, the first maximum wins
+  const std::vector<TypeParam> input = {TypeParam(-7), 42, 13, 42, TypeParam(-100)};
+  const std::vector<TypeParam> expected_output = {0, 1, 0, 0, 0};
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_argmax_op(tensor_yao_0);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_argmax_op(tensor_yao_1);
+  auto beavy_output_tensor_0 =
+      this->yao_providers_[0]->make_convert_to_arithmetic_beavy_tensor(output_tensor_0);
+  auto beavy_output_tensor_1 =
+      this->yao_providers_[1]->make_convert_to_arithmetic_beavy_tensor(output_tensor_1);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(beavy_output_tensor_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, beavy_output_tensor_1);
+
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+  ASSERT_EQ(output_tensor_1->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output = output_future.get();
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, ArgmaxIndexInBooleanBEAVY) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 5, .width_ = 1};
+  const MOTION::tensor::TensorDimensions out_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 1};
+  const std::vector<TypeParam> input = {TypeParam(-7), 13, 42, TypeParam(-100), 42};
+  const std::vector<TypeParam> expected_output = {2};
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto tensor_bbeavy_0 =
+      this->yao_providers_[0]->make_convert_to_boolean_beavy_tensor(tensor_yao_0);
+  auto tensor_bbeavy_1 =
+      this->yao_providers_[1]->make_convert_to_boolean_beavy_tensor(tensor_yao_1);
+  auto output_tensor_0 = this->beavy_providers_[0]->make_tensor_argmax_op(tensor_bbeavy_0, false);
+  auto output_tensor_1 = this->beavy_providers_[1]->make_tensor_argmax_op(tensor_bbeavy_1, false);
+  auto beavy_output_tensor_0 =
+      this->beavy_providers_[0]->make_convert_boolean_to_arithmetic_beavy_tensor(output_tensor_0);
+  auto beavy_output_tensor_1 =
+      this->beavy_providers_[1]->make_convert_boolean_to_arithmetic_beavy_tensor(output_tensor_1);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(beavy_output_tensor_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, beavy_output_tensor_1);
+
+  ASSERT_EQ(output_tensor_0->get_dimensions(), out_dims);
+  ASSERT_EQ(output_tensor_1->get_dimensions(), out_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output = output_future.get();
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, ArgmaxPerColumn) {
+  // a batch of three inputs with four values each, stored as the columns of a matrix
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 4, .width_ = 3};
+  // clang-format off
+  const std::vector<TypeParam> input = {
+      5, TypeParam(-1), 0,
+      9, TypeParam(-3), 0,
+      2, TypeParam(-2), 0,
+      9, 7, 0};
+  const std::vector<TypeParam> expected_output = {
+      0, 0, 1,
+      1, 0, 0,
+      0, 0, 0,
+      0, 1, 0};
+  // clang-format on
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto output_tensor_0 = this->yao_providers_[0]->make_tensor_argmax_op(tensor_yao_0);
+  auto output_tensor_1 = this->yao_providers_[1]->make_tensor_argmax_op(tensor_yao_1);
+  auto beavy_output_tensor_0 =
+      this->yao_providers_[0]->make_convert_to_arithmetic_beavy_tensor(output_tensor_0);
+  auto beavy_output_tensor_1 =
+      this->yao_providers_[1]->make_convert_to_arithmetic_beavy_tensor(output_tensor_1);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(beavy_output_tensor_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, beavy_output_tensor_1);
+
+  ASSERT_EQ(output_tensor_0->get_dimensions(), dims);
+  ASSERT_EQ(output_tensor_1->get_dimensions(), dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output = output_future.get();
+  EXPECT_EQ(output, expected_output);
+}
+
+TYPED_TEST(YaoArithmeticBEAVYTensorTest, ArgmaxPerColumnIndexInBooleanBEAVY) {
+  const MOTION::tensor::TensorDimensions dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 3, .width_ = 2};
+  const MOTION::tensor::TensorDimensions out_dims = {
+      .batch_size_ = 1, .num_channels_ = 1, .height_ = 1, .width_ = 2};
+  // clang-format off
+  const std::vector<TypeParam> input = {
+      TypeParam(-7), 1,
+      13, TypeParam(-5),
+      TypeParam(-100), 30};
+  // clang-format on
+  const std::vector<TypeParam> expected_output = {1, 2};
+
+  auto [input_promise, tensor_in_0] = this->make_arithmetic_T_tensor_input_my(0, dims);
+  auto tensor_in_1 = this->make_arithmetic_T_tensor_input_other(1, dims);
+
+  auto tensor_yao_0 =
+      this->yao_providers_[0]->make_convert_from_arithmetic_beavy_tensor(tensor_in_0);
+  auto tensor_yao_1 =
+      this->yao_providers_[1]->make_convert_from_arithmetic_beavy_tensor(tensor_in_1);
+  auto tensor_bbeavy_0 =
+      this->yao_providers_[0]->make_convert_to_boolean_beavy_tensor(tensor_yao_0);
+  auto tensor_bbeavy_1 =
+      this->yao_providers_[1]->make_convert_to_boolean_beavy_tensor(tensor_yao_1);
+  auto output_tensor_0 = this->beavy_providers_[0]->make_tensor_argmax_op(tensor_bbeavy_0, false);
+  auto output_tensor_1 = this->beavy_providers_[1]->make_tensor_argmax_op(tensor_bbeavy_1, false);
+  auto beavy_output_tensor_0 =
+      this->beavy_providers_[0]->make_convert_boolean_to_arithmetic_beavy_tensor(output_tensor_0);
+  auto beavy_output_tensor_1 =
+      this->beavy_providers_[1]->make_convert_boolean_to_arithmetic_beavy_tensor(output_tensor_1);
+  this->beavy_providers_[0]->make_arithmetic_tensor_output_other(beavy_output_tensor_0);
+  auto output_future = this->make_arithmetic_T_tensor_output_my(1, beavy_output_tensor_1);
+
+  ASSERT_EQ(output_tensor_0->get_dimensions(), out_dims);
+  ASSERT_EQ(output_tensor_1->get_dimensions(), out_dims);
+
+  this->run_setup();
+  this->run_gates_setup();
+  input_promise.set_value(input);
+  this->run_gates_online();
+
+  const auto output = output_future.get();
+  EXPECT_EQ(output, expected_output);
+}